@@ -1,5 +1,8 @@
 #include "Commands/UnrealMCPBlueprintCommands.h"
+#include "UnrealMCPLog.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "UnrealMCPCompileScheduler.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Factories/BlueprintFactory.h"
@@ -25,46 +28,16 @@ FUnrealMCPBlueprintCommands::FUnrealMCPBlueprintCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPBlueprintCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("create_blueprint"))
-    {
-        return HandleCreateBlueprint(Params);
-    }
-    else if (CommandType == TEXT("add_component_to_blueprint"))
-    {
-        return HandleAddComponentToBlueprint(Params);
-    }
-    else if (CommandType == TEXT("set_component_property"))
-    {
-        return HandleSetComponentProperty(Params);
-    }
-    else if (CommandType == TEXT("set_physics_properties"))
-    {
-        return HandleSetPhysicsProperties(Params);
-    }
-    else if (CommandType == TEXT("compile_blueprint"))
-    {
-        return HandleCompileBlueprint(Params);
-    }
-    else if (CommandType == TEXT("spawn_blueprint_actor"))
-    {
-        return HandleSpawnBlueprintActor(Params);
-    }
-    else if (CommandType == TEXT("set_blueprint_property"))
-    {
-        return HandleSetBlueprintProperty(Params);
-    }
-    else if (CommandType == TEXT("set_static_mesh_properties"))
-    {
-        return HandleSetStaticMeshProperties(Params);
-    }
-    else if (CommandType == TEXT("set_pawn_properties"))
-    {
-        return HandleSetPawnProperties(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint command: %s"), *CommandType));
+    Registry.Register(TEXT("create_blueprint"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleCreateBlueprint));
+    Registry.Register(TEXT("add_component_to_blueprint"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleAddComponentToBlueprint));
+    Registry.Register(TEXT("set_component_property"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleSetComponentProperty));
+    Registry.Register(TEXT("set_physics_properties"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties));
+    Registry.Register(TEXT("compile_blueprint"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleCompileBlueprint));
+    Registry.Register(TEXT("set_blueprint_property"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty));
+    Registry.Register(TEXT("set_static_mesh_properties"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleSetStaticMeshProperties));
+    Registry.Register(TEXT("set_pawn_properties"), TEXT("blueprint"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintCommands::HandleSetPawnProperties));
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -97,45 +70,16 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const
     // Try to find the specified parent class
     if (!ParentClass.IsEmpty())
     {
-        FString ClassName = ParentClass;
-        if (!ClassName.StartsWith(TEXT("A")))
-        {
-            ClassName = TEXT("A") + ClassName;
-        }
-        
-        // First try direct StaticClass lookup for common classes
-        UClass* FoundClass = nullptr;
-        if (ClassName == TEXT("APawn"))
-        {
-            FoundClass = APawn::StaticClass();
-        }
-        else if (ClassName == TEXT("AActor"))
-        {
-            FoundClass = AActor::StaticClass();
-        }
-        else
-        {
-            // Try loading the class using LoadClass which is more reliable than FindObject
-            const FString ClassPath = FString::Printf(TEXT("/Script/Engine.%s"), *ClassName);
-            FoundClass = LoadClass<AActor>(nullptr, *ClassPath);
-            
-            if (!FoundClass)
-            {
-                // Try alternate paths if not found
-                const FString GameClassPath = FString::Printf(TEXT("/Script/Game.%s"), *ClassName);
-                FoundClass = LoadClass<AActor>(nullptr, *GameClassPath);
-            }
-        }
-
+        UClass* FoundClass = FUnrealMCPCommonUtils::FindClassByName(ParentClass, AActor::StaticClass());
         if (FoundClass)
         {
             SelectedParentClass = FoundClass;
-            UE_LOG(LogTemp, Log, TEXT("Successfully set parent class to '%s'"), *ClassName);
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Successfully set parent class to '%s'"), *FoundClass->GetName());
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("Could not find specified parent class '%s' at paths: /Script/Engine.%s or /Script/Game.%s, defaulting to AActor"), 
-                *ClassName, *ClassName, *ClassName);
+            UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find specified parent class '%s', defaulting to AActor.%s"), 
+                *ParentClass, *FUnrealMCPCommonUtils::GetClassSuggestionText(ParentClass, AActor::StaticClass()));
         }
     }
     
@@ -190,40 +134,16 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddComponentToBluepri
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Create the component - dynamically find the component class by name
-    UClass* ComponentClass = nullptr;
-
-    // Try to find the class with exact name first
-    ComponentClass = FindObject<UClass>(ANY_PACKAGE, *ComponentType);
-    
-    // If not found, try with "Component" suffix
-    if (!ComponentClass && !ComponentType.EndsWith(TEXT("Component")))
-    {
-        FString ComponentTypeWithSuffix = ComponentType + TEXT("Component");
-        ComponentClass = FindObject<UClass>(ANY_PACKAGE, *ComponentTypeWithSuffix);
-    }
-    
-    // If still not found, try with "U" prefix
-    if (!ComponentClass && !ComponentType.StartsWith(TEXT("U")))
-    {
-        FString ComponentTypeWithPrefix = TEXT("U") + ComponentType;
-        ComponentClass = FindObject<UClass>(ANY_PACKAGE, *ComponentTypeWithPrefix);
-        
-        // Try with both prefix and suffix
-        if (!ComponentClass && !ComponentType.EndsWith(TEXT("Component")))
-        {
-            FString ComponentTypeWithBoth = TEXT("U") + ComponentType + TEXT("Component");
-            ComponentClass = FindObject<UClass>(ANY_PACKAGE, *ComponentTypeWithBoth);
-        }
-    }
-    
-    // Verify that the class is a valid component type
-    if (!ComponentClass || !ComponentClass->IsChildOf(UActorComponent::StaticClass()))
+    // Resolve the component class: "StaticMesh", "StaticMeshComponent" and "UStaticMeshComponent" all work
+    UClass* ComponentClass = FUnrealMCPCommonUtils::FindClassByName(ComponentType, UActorComponent::StaticClass());
+    if (!ComponentClass)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown component type: %s"), *ComponentType));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown component type: %s.%s"),
+            *ComponentType, *FUnrealMCPCommonUtils::GetClassSuggestionText(ComponentType, UActorComponent::StaticClass())));
     }
 
     // Add the component to the blueprint
+    Blueprint->SimpleConstructionScript->Modify();
     USCS_Node* NewNode = Blueprint->SimpleConstructionScript->CreateNode(ComponentClass, *ComponentName);
     if (NewNode)
     {
@@ -248,8 +168,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddComponentToBluepri
         // Add to root if no parent specified
         Blueprint->SimpleConstructionScript->AddNode(NewNode);
 
-        // Compile the blueprint
-        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        // Compiled later, together with the blueprint's other pending edits
+        FUnrealMCPCommonUtils::MarkBlueprintForCompile(Blueprint);
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("component_name"), ComponentName);
@@ -282,53 +202,56 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     }
 
     // Log all input parameters for debugging
-    UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Blueprint: %s, Component: %s, Property: %s"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Blueprint: %s, Component: %s, Property: %s"), 
         *BlueprintName, *ComponentName, *PropertyName);
     
-    // Log property_value if available
-    if (Params->HasField(TEXT("property_value")))
+    // Log property_value if available; the description is only built when it is logged
+    if (UE_LOG_ACTIVE(LogUnrealMCP, Verbose))
     {
-        TSharedPtr<FJsonValue> JsonValue = Params->Values.FindRef(TEXT("property_value"));
-        FString ValueType;
+        if (Params->HasField(TEXT("property_value")))
+        {
+            TSharedPtr<FJsonValue> JsonValue = Params->Values.FindRef(TEXT("property_value"));
+            FString ValueType;
+        
+            switch(JsonValue->Type)
+            {
+                case EJson::Boolean: ValueType = FString::Printf(TEXT("Boolean: %s"), JsonValue->AsBool() ? TEXT("true") : TEXT("false")); break;
+                case EJson::Number: ValueType = FString::Printf(TEXT("Number: %f"), JsonValue->AsNumber()); break;
+                case EJson::String: ValueType = FString::Printf(TEXT("String: %s"), *JsonValue->AsString()); break;
+                case EJson::Array: ValueType = TEXT("Array"); break;
+                case EJson::Object: ValueType = TEXT("Object"); break;
+                default: ValueType = TEXT("Unknown"); break;
+            }
         
-        switch(JsonValue->Type)
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Value Type: %s"), *ValueType);
+        }
+        else
         {
-            case EJson::Boolean: ValueType = FString::Printf(TEXT("Boolean: %s"), JsonValue->AsBool() ? TEXT("true") : TEXT("false")); break;
-            case EJson::Number: ValueType = FString::Printf(TEXT("Number: %f"), JsonValue->AsNumber()); break;
-            case EJson::String: ValueType = FString::Printf(TEXT("String: %s"), *JsonValue->AsString()); break;
-            case EJson::Array: ValueType = TEXT("Array"); break;
-            case EJson::Object: ValueType = TEXT("Object"); break;
-            default: ValueType = TEXT("Unknown"); break;
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - No property_value provided"));
         }
-        
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Value Type: %s"), *ValueType);
-    }
-    else
-    {
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - No property_value provided"));
     }
 
     // Find the blueprint
     UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
     if (!Blueprint)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Blueprint not found: %s"), *BlueprintName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Blueprint not found: %s"), *BlueprintName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
     else
     {
-        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Blueprint found: %s (Class: %s)"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Blueprint found: %s (Class: %s)"), 
             *BlueprintName, 
             Blueprint->GeneratedClass ? *Blueprint->GeneratedClass->GetName() : TEXT("NULL"));
     }
 
     // Find the component
     USCS_Node* ComponentNode = nullptr;
-    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Searching for component %s in blueprint nodes"), *ComponentName);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Searching for component %s in blueprint nodes"), *ComponentName);
     
     if (!Blueprint->SimpleConstructionScript)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - SimpleConstructionScript is NULL for blueprint %s"), *BlueprintName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - SimpleConstructionScript is NULL for blueprint %s"), *BlueprintName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Invalid blueprint construction script"));
     }
     
@@ -336,7 +259,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     {
         if (Node)
         {
-            UE_LOG(LogTemp, Verbose, TEXT("SetComponentProperty - Found node: %s"), *Node->GetVariableName().ToString());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Found node: %s"), *Node->GetVariableName().ToString());
             if (Node->GetVariableName().ToString() == ComponentName)
             {
                 ComponentNode = Node;
@@ -345,18 +268,18 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Found NULL node in blueprint"));
+            UE_LOG(LogUnrealMCP, Warning, TEXT("SetComponentProperty - Found NULL node in blueprint"));
         }
     }
 
     if (!ComponentNode)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Component not found: %s"), *ComponentName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Component not found: %s"), *ComponentName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Component not found: %s"), *ComponentName));
     }
     else
     {
-        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Component found: %s (Class: %s)"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Component found: %s (Class: %s)"), 
             *ComponentName, 
             ComponentNode->ComponentTemplate ? *ComponentNode->ComponentTemplate->GetClass()->GetName() : TEXT("NULL"));
     }
@@ -365,22 +288,25 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     UObject* ComponentTemplate = ComponentNode->ComponentTemplate;
     if (!ComponentTemplate)
     {
-        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Component template is NULL for %s"), *ComponentName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Component template is NULL for %s"), *ComponentName);
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Invalid component template"));
     }
 
     // Check if this is a Spring Arm component and log special debug info
     if (ComponentTemplate->GetClass()->GetName().Contains(TEXT("SpringArm")))
     {
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - SpringArm component detected! Class: %s"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - SpringArm component detected! Class: %s"), 
             *ComponentTemplate->GetClass()->GetPathName());
             
         // Log all properties of the SpringArm component class
-        UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - SpringArm properties:"));
-        for (TFieldIterator<FProperty> PropIt(ComponentTemplate->GetClass()); PropIt; ++PropIt)
+        if (UE_LOG_ACTIVE(LogUnrealMCP, Verbose))
         {
-            FProperty* Prop = *PropIt;
-            UE_LOG(LogTemp, Warning, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - SpringArm properties:"));
+            for (TFieldIterator<FProperty> PropIt(ComponentTemplate->GetClass()); PropIt; ++PropIt)
+            {
+                FProperty* Prop = *PropIt;
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
+            }
         }
 
         // Special handling for Spring Arm properties
@@ -392,7 +318,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             FProperty* Property = FindFProperty<FProperty>(ComponentTemplate->GetClass(), *PropertyName);
             if (!Property)
             {
-                UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Property %s not found on SpringArm component"), *PropertyName);
+                UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Property %s not found on SpringArm component"), *PropertyName);
                 return FUnrealMCPCommonUtils::CreateErrorResponse(
                     FString::Printf(TEXT("Property %s not found on SpringArm component"), *PropertyName));
             }
@@ -426,7 +352,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                 if (JsonValue->Type == EJson::Number)
                 {
                     const float Value = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting float property %s to %f"), *PropertyName, Value);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting float property %s to %f"), *PropertyName, Value);
                     FloatProp->SetPropertyValue_InContainer(ComponentTemplate, Value);
                     bSuccess = true;
                 }
@@ -436,14 +362,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                 if (JsonValue->Type == EJson::Boolean)
                 {
                     const bool Value = JsonValue->AsBool();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting bool property %s to %d"), *PropertyName, Value);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting bool property %s to %d"), *PropertyName, Value);
                     BoolProp->SetPropertyValue_InContainer(ComponentTemplate, Value);
                     bSuccess = true;
                 }
             }
             else if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
             {
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Handling struct property %s of type %s"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Handling struct property %s of type %s"), 
                     *PropertyName, *StructProp->Struct->GetName());
                 
                 // Special handling for common Spring Arm struct properties
@@ -488,7 +414,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             if (bSuccess)
             {
                 // Mark the blueprint as modified
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Successfully set SpringArm property %s"), *PropertyName);
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Successfully set SpringArm property %s"), *PropertyName);
                 FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
                 TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -499,7 +425,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             }
             else
             {
-                UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set SpringArm property %s"), *PropertyName);
+                UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set SpringArm property %s"), *PropertyName);
                 return FUnrealMCPCommonUtils::CreateErrorResponse(
                     FString::Printf(TEXT("Failed to set SpringArm property %s"), *PropertyName));
             }
@@ -517,15 +443,18 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         FProperty* Property = FindFProperty<FProperty>(ComponentTemplate->GetClass(), *PropertyName);
         if (!Property)
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Property %s not found on component %s"), 
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Property %s not found on component %s"), 
                 *PropertyName, *ComponentName);
             
             // List all available properties for this component
-            UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Available properties for %s:"), *ComponentName);
-            for (TFieldIterator<FProperty> PropIt(ComponentTemplate->GetClass()); PropIt; ++PropIt)
+            if (UE_LOG_ACTIVE(LogUnrealMCP, Verbose))
             {
-                FProperty* Prop = *PropIt;
-                UE_LOG(LogTemp, Warning, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Available properties for %s:"), *ComponentName);
+                for (TFieldIterator<FProperty> PropIt(ComponentTemplate->GetClass()); PropIt; ++PropIt)
+                {
+                    FProperty* Prop = *PropIt;
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (%s)"), *Prop->GetName(), *Prop->GetCPPType());
+                }
             }
             
             return FUnrealMCPCommonUtils::CreateErrorResponse(
@@ -533,7 +462,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         }
         else
         {
-            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property found: %s (Type: %s)"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property found: %s (Type: %s)"), 
                 *PropertyName, *Property->GetCPPType());
         }
 
@@ -541,7 +470,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         FString ErrorMessage;
 
         // Handle different property types
-        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Attempting to set property %s"), *PropertyName);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Attempting to set property %s"), *PropertyName);
         
         // Add try-catch block to catch and log any crashes
         try
@@ -549,7 +478,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
             if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
             {
                 // Handle vector properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is a struct: %s"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property is a struct: %s"), 
                     StructProp->Struct ? *StructProp->Struct->GetName() : TEXT("NULL"));
                     
                 if (StructProp->Struct == TBaseStructure<FVector>::Get())
@@ -566,7 +495,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                                 Arr[2]->AsNumber()
                             );
                             void* PropertyAddr = StructProp->ContainerPtrToValuePtr<void>(ComponentTemplate);
-                            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f)"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f)"), 
                                 Vec.X, Vec.Y, Vec.Z);
                             StructProp->CopySingleValue(PropertyAddr, &Vec);
                             bSuccess = true;
@@ -574,7 +503,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         else
                         {
                             ErrorMessage = FString::Printf(TEXT("Vector property requires 3 values, got %d"), Arr.Num());
-                            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                         }
                     }
                     else if (JsonValue->Type == EJson::Number)
@@ -583,7 +512,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         float Value = JsonValue->AsNumber();
                         FVector Vec(Value, Value, Value);
                         void* PropertyAddr = StructProp->ContainerPtrToValuePtr<void>(ComponentTemplate);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f) from scalar"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting Vector(%f, %f, %f) from scalar"), 
                             Vec.X, Vec.Y, Vec.Z);
                         StructProp->CopySingleValue(PropertyAddr, &Vec);
                         bSuccess = true;
@@ -591,30 +520,30 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                     else
                     {
                         ErrorMessage = TEXT("Vector property requires either a single number or array of 3 numbers");
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                     }
                 }
                 else
                 {
                     // Handle other struct properties using default handler
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Using generic struct handler for %s"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Using generic struct handler for %s"), 
                         *PropertyName);
                     bSuccess = FUnrealMCPCommonUtils::SetObjectProperty(ComponentTemplate, PropertyName, JsonValue, ErrorMessage);
                     if (!bSuccess)
                     {
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set struct property: %s"), *ErrorMessage);
+                        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set struct property: %s"), *ErrorMessage);
                     }
                 }
             }
             else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
             {
                 // Handle enum properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is an enum"));
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property is an enum"));
                 if (JsonValue->Type == EJson::String)
                 {
                     FString EnumValueName = JsonValue->AsString();
                     UEnum* Enum = EnumProp->GetEnum();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting enum from string: %s"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting enum from string: %s"), *EnumValueName);
                     
                     if (Enum)
                     {
@@ -622,7 +551,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         
                         if (EnumValue != INDEX_NONE)
                         {
-                            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Found enum value: %lld"), EnumValue);
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Found enum value: %lld"), EnumValue);
                             EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(
                                 ComponentTemplate, 
                                 EnumValue
@@ -632,31 +561,31 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                         else
                         {
                             // List all possible enum values
-                            UE_LOG(LogTemp, Warning, TEXT("SetComponentProperty - Available enum values for %s:"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Available enum values for %s:"), 
                                 *Enum->GetName());
-                            for (int32 i = 0; i < Enum->NumEnums(); i++)
+                            for (int32 i = 0; i < Enum->NumEnums() && UE_LOG_ACTIVE(LogUnrealMCP, Verbose); i++)
                             {
-                                UE_LOG(LogTemp, Warning, TEXT("  - %s (%lld)"), 
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("  - %s (%lld)"), 
                                     *Enum->GetNameStringByIndex(i),
                                     Enum->GetValueByIndex(i));
                             }
                             
                             ErrorMessage = FString::Printf(TEXT("Invalid enum value '%s' for property %s"), 
                                 *EnumValueName, *PropertyName);
-                            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                         }
                     }
                     else
                     {
                         ErrorMessage = TEXT("Enum object is NULL");
-                        UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                        UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                     }
                 }
                 else if (JsonValue->Type == EJson::Number)
                 {
                     // Allow setting enum by integer value
                     int64 EnumValue = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting enum from number: %lld"), EnumValue);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting enum from number: %lld"), EnumValue);
                     EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(
                         ComponentTemplate, 
                         EnumValue
@@ -666,60 +595,60 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
                 else
                 {
                     ErrorMessage = TEXT("Enum property requires either a string name or integer value");
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                 }
             }
             else if (FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
             {
                 // Handle numeric properties
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Property is numeric: IsInteger=%d, IsFloat=%d"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Property is numeric: IsInteger=%d, IsFloat=%d"), 
                     NumericProp->IsInteger(), NumericProp->IsFloatingPoint());
                     
                 if (JsonValue->Type == EJson::Number)
                 {
                     double Value = JsonValue->AsNumber();
-                    UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Setting numeric value: %f"), Value);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Setting numeric value: %f"), Value);
                     
                     if (NumericProp->IsInteger())
                     {
                         NumericProp->SetIntPropertyValue(ComponentTemplate, (int64)Value);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Set integer value: %lld"), (int64)Value);
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Set integer value: %lld"), (int64)Value);
                         bSuccess = true;
                     }
                     else if (NumericProp->IsFloatingPoint())
                     {
                         NumericProp->SetFloatingPointPropertyValue(ComponentTemplate, Value);
-                        UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Set float value: %f"), Value);
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Set float value: %f"), Value);
                         bSuccess = true;
                     }
                 }
                 else
                 {
                     ErrorMessage = TEXT("Numeric property requires a number value");
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
+                    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - %s"), *ErrorMessage);
                 }
             }
             else
             {
                 // Handle all other property types using default handler
-                UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Using generic property handler for %s (Type: %s)"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Using generic property handler for %s (Type: %s)"), 
                     *PropertyName, *Property->GetCPPType());
                 bSuccess = FUnrealMCPCommonUtils::SetObjectProperty(ComponentTemplate, PropertyName, JsonValue, ErrorMessage);
                 if (!bSuccess)
                 {
-                    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set property: %s"), *ErrorMessage);
+                    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set property: %s"), *ErrorMessage);
                 }
             }
         }
         catch (const std::exception& Ex)
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - EXCEPTION: %s"), ANSI_TO_TCHAR(Ex.what()));
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - EXCEPTION: %s"), ANSI_TO_TCHAR(Ex.what()));
             return FUnrealMCPCommonUtils::CreateErrorResponse(
                 FString::Printf(TEXT("Exception while setting property %s: %s"), *PropertyName, ANSI_TO_TCHAR(Ex.what())));
         }
         catch (...)
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - UNKNOWN EXCEPTION occurred while setting property %s"), *PropertyName);
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - UNKNOWN EXCEPTION occurred while setting property %s"), *PropertyName);
             return FUnrealMCPCommonUtils::CreateErrorResponse(
                 FString::Printf(TEXT("Unknown exception while setting property %s"), *PropertyName));
         }
@@ -727,7 +656,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         if (bSuccess)
         {
             // Mark the blueprint as modified
-            UE_LOG(LogTemp, Log, TEXT("SetComponentProperty - Successfully set property %s on component %s"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("SetComponentProperty - Successfully set property %s on component %s"), 
                 *PropertyName, *ComponentName);
             FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
@@ -739,13 +668,13 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Failed to set property %s: %s"), 
+            UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Failed to set property %s: %s"), 
                 *PropertyName, *ErrorMessage);
             return FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage);
         }
     }
 
-    UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Missing 'property_value' parameter"));
+    UE_LOG(LogUnrealMCP, Error, TEXT("SetComponentProperty - Missing 'property_value' parameter"));
     return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'property_value' parameter"));
 }
 
@@ -794,6 +723,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties(
     }
 
     // Set physics properties
+    PrimComponent->Modify();
     if (Params->HasField(TEXT("simulate_physics")))
     {
         PrimComponent->SetSimulatePhysics(Params->GetBoolField(TEXT("simulate_physics")));
@@ -804,7 +734,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties(
         float Mass = Params->GetNumberField(TEXT("mass"));
         // In UE5.5, use proper overrideMass instead of just scaling
         PrimComponent->SetMassOverrideInKg(NAME_None, Mass);
-        UE_LOG(LogTemp, Display, TEXT("Set mass for component %s to %f kg"), *ComponentName, Mass);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Set mass for component %s to %f kg"), *ComponentName, Mass);
     }
 
     if (Params->HasField(TEXT("linear_damping")))
@@ -841,69 +771,22 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCompileBlueprint(cons
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Compile the blueprint
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
-
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetStringField(TEXT("name"), BlueprintName);
-    ResultObj->SetBoolField(TEXT("compiled"), true);
-    return ResultObj;
-}
-
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params)
-{
-    // Get required parameters
-    FString BlueprintName;
-    if (!Params->TryGetStringField(TEXT("blueprint_name"), BlueprintName))
+    // Compile the blueprint, folding in any edits that are waiting to be compiled
+    int32 CompilesAvoided = 0;
+    if (FUnrealMCPCompileScheduler* Scheduler = FUnrealMCPCommonUtils::GetCompileScheduler())
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
+        CompilesAvoided = Scheduler->Compile(Blueprint);
     }
-
-    FString ActorName;
-    if (!Params->TryGetStringField(TEXT("actor_name"), ActorName))
-    {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'actor_name' parameter"));
-    }
-
-    // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
-    if (!Blueprint)
-    {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
-    }
-
-    // Get transform parameters
-    FVector Location(0.0f, 0.0f, 0.0f);
-    FRotator Rotation(0.0f, 0.0f, 0.0f);
-
-    if (Params->HasField(TEXT("location")))
-    {
-        Location = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location"));
-    }
-    if (Params->HasField(TEXT("rotation")))
-    {
-        Rotation = FUnrealMCPCommonUtils::GetRotatorFromJson(Params, TEXT("rotation"));
-    }
-
-    // Spawn the actor
-    UWorld* World = GEditor->GetEditorWorldContext().World();
-    if (!World)
-    {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
-    }
-
-    FTransform SpawnTransform;
-    SpawnTransform.SetLocation(Location);
-    SpawnTransform.SetRotation(FQuat(Rotation));
-
-    AActor* NewActor = World->SpawnActor<AActor>(Blueprint->GeneratedClass, SpawnTransform);
-    if (NewActor)
+    else
     {
-        NewActor->SetActorLabel(*ActorName);
-        return FUnrealMCPCommonUtils::ActorToJsonObject(NewActor, true);
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
     }
 
-    return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to spawn blueprint actor"));
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("name"), BlueprintName);
+    ResultObj->SetBoolField(TEXT("compiled"), true);
+    ResultObj->SetNumberField(TEXT("compiles_avoided"), CompilesAvoided);
+    return ResultObj;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty(const TSharedPtr<FJsonObject>& Params)
@@ -928,7 +811,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty(
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Get the default object
+    // Get the default object of the up-to-date generated class
+    FUnrealMCPCommonUtils::FlushBlueprintCompile(Blueprint);
     UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
     if (!DefaultObject)
     {
@@ -1005,6 +889,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetStaticMeshProperti
     }
 
     // Set static mesh properties
+    MeshComponent->Modify();
     if (Params->HasField(TEXT("static_mesh")))
     {
         FString MeshPath = Params->GetStringField(TEXT("static_mesh"));
@@ -1049,7 +934,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPawnProperties(con
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
     }
 
-    // Get the default object
+    // Get the default object of the up-to-date generated class
+    FUnrealMCPCommonUtils::FlushBlueprintCompile(Blueprint);
     UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
     if (!DefaultObject)
     {
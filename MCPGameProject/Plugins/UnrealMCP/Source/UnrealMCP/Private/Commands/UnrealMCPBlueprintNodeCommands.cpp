@@ -1,4 +1,6 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
+#include "UnrealMCPLog.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -17,49 +19,20 @@
 #include "Kismet/GameplayStatics.h"
 #include "EdGraphSchema_K2.h"
 
-// Declare the log category
-DEFINE_LOG_CATEGORY_STATIC(LogUnrealMCP, Log, All);
-
 FUnrealMCPBlueprintNodeCommands::FUnrealMCPBlueprintNodeCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPBlueprintNodeCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("connect_blueprint_nodes"))
-    {
-        return HandleConnectBlueprintNodes(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_get_self_component_reference"))
-    {
-        return HandleAddBlueprintGetSelfComponentReference(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_event_node"))
-    {
-        return HandleAddBlueprintEvent(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_function_node"))
-    {
-        return HandleAddBlueprintFunctionCall(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_variable"))
-    {
-        return HandleAddBlueprintVariable(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_input_action_node"))
-    {
-        return HandleAddBlueprintInputActionNode(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_self_reference"))
-    {
-        return HandleAddBlueprintSelfReference(Params);
-    }
-    else if (CommandType == TEXT("find_blueprint_nodes"))
-    {
-        return HandleFindBlueprintNodes(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint node command: %s"), *CommandType));
+    Registry.Register(TEXT("connect_blueprint_nodes"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes));
+    Registry.Register(TEXT("add_blueprint_get_self_component_reference"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSelfComponentReference));
+    Registry.Register(TEXT("add_blueprint_event_node"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintEvent));
+    Registry.Register(TEXT("add_blueprint_function_node"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunctionCall));
+    Registry.Register(TEXT("add_blueprint_variable"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintVariable));
+    Registry.Register(TEXT("add_blueprint_input_action_node"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintInputActionNode));
+    Registry.Register(TEXT("add_blueprint_self_reference"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintSelfReference));
+    Registry.Register(TEXT("find_blueprint_nodes"), TEXT("blueprint_node"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNodes));
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes(const TSharedPtr<FJsonObject>& Params)
@@ -198,6 +171,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSe
     GetComponentNode->NodePosY = NodePosition.Y;
     
     // Add to graph
+    EventGraph->Modify();
     EventGraph->AddNode(GetComponentNode);
     GetComponentNode->CreateNewGuid();
     GetComponentNode->PostPlacedNewNode();
@@ -310,66 +284,23 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     UK2Node_CallFunction* FunctionNode = nullptr;
     
     // Add extensive logging for debugging
-    UE_LOG(LogTemp, Display, TEXT("Looking for function '%s' in target '%s'"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("Looking for function '%s' in target '%s'"), 
            *FunctionName, Target.IsEmpty() ? TEXT("Blueprint") : *Target);
     
     // Check if we have a target class specified
+    bool bTargetClassMissing = false;
     if (!Target.IsEmpty())
     {
-        // Try to find the target class
-        UClass* TargetClass = nullptr;
-        
-        // First try without a prefix
-        TargetClass = FindObject<UClass>(ANY_PACKAGE, *Target);
-        UE_LOG(LogTemp, Display, TEXT("Tried to find class '%s': %s"), 
+        // Try to find the target class; "GameplayStatics", "UGameplayStatics" and full paths all work
+        UClass* TargetClass = FUnrealMCPCommonUtils::FindClassByName(Target);
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Tried to find class '%s': %s"), 
                *Target, TargetClass ? TEXT("Found") : TEXT("Not found"));
-        
-        // If not found, try with U prefix (common convention for UE classes)
-        if (!TargetClass && !Target.StartsWith(TEXT("U")))
-        {
-            FString TargetWithPrefix = FString(TEXT("U")) + Target;
-            TargetClass = FindObject<UClass>(ANY_PACKAGE, *TargetWithPrefix);
-            UE_LOG(LogTemp, Display, TEXT("Tried to find class '%s': %s"), 
-                   *TargetWithPrefix, TargetClass ? TEXT("Found") : TEXT("Not found"));
-        }
-        
-        // If still not found, try with common component names
-        if (!TargetClass)
-        {
-            // Try some common component class names
-            TArray<FString> PossibleClassNames;
-            PossibleClassNames.Add(FString(TEXT("U")) + Target + TEXT("Component"));
-            PossibleClassNames.Add(Target + TEXT("Component"));
-            
-            for (const FString& ClassName : PossibleClassNames)
-            {
-                TargetClass = FindObject<UClass>(ANY_PACKAGE, *ClassName);
-                if (TargetClass)
-                {
-                    UE_LOG(LogTemp, Display, TEXT("Found class using alternative name '%s'"), *ClassName);
-                    break;
-                }
-            }
-        }
-        
-        // Special case handling for common classes like UGameplayStatics
-        if (!TargetClass && Target == TEXT("UGameplayStatics"))
-        {
-            // For UGameplayStatics, use a direct reference to known class
-            TargetClass = FindObject<UClass>(ANY_PACKAGE, TEXT("UGameplayStatics"));
-            if (!TargetClass)
-            {
-                // Try loading it from its known package
-                TargetClass = LoadObject<UClass>(nullptr, TEXT("/Script/Engine.GameplayStatics"));
-                UE_LOG(LogTemp, Display, TEXT("Explicitly loading GameplayStatics: %s"), 
-                       TargetClass ? TEXT("Success") : TEXT("Failed"));
-            }
-        }
+        bTargetClassMissing = TargetClass == nullptr;
         
         // If we found a target class, look for the function there
         if (TargetClass)
         {
-            UE_LOG(LogTemp, Display, TEXT("Looking for function '%s' in class '%s'"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Looking for function '%s' in class '%s'"), 
                    *FunctionName, *TargetClass->GetName());
                    
             // First try exact name
@@ -379,7 +310,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
             UClass* CurrentClass = TargetClass;
             while (!Function && CurrentClass)
             {
-                UE_LOG(LogTemp, Display, TEXT("Searching in class: %s"), *CurrentClass->GetName());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Searching in class: %s"), *CurrentClass->GetName());
                 
                 // Try exact match
                 Function = CurrentClass->FindFunctionByName(*FunctionName);
@@ -390,11 +321,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     for (TFieldIterator<UFunction> FuncIt(CurrentClass); FuncIt; ++FuncIt)
                     {
                         UFunction* AvailableFunc = *FuncIt;
-                        UE_LOG(LogTemp, Display, TEXT("  - Available function: %s"), *AvailableFunc->GetName());
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Available function: %s"), *AvailableFunc->GetName());
                         
                         if (AvailableFunc->GetName().Equals(FunctionName, ESearchCase::IgnoreCase))
                         {
-                            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive match: %s"), *AvailableFunc->GetName());
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found case-insensitive match: %s"), *AvailableFunc->GetName());
                             Function = AvailableFunc;
                             break;
                         }
@@ -411,7 +342,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 if (TargetClass->GetName() == TEXT("GameplayStatics") && 
                     (FunctionName == TEXT("GetActorOfClass") || FunctionName.Equals(TEXT("GetActorOfClass"), ESearchCase::IgnoreCase)))
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Using special case handling for GameplayStatics::GetActorOfClass"));
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Using special case handling for GameplayStatics::GetActorOfClass"));
                     
                     // Create the function node directly
                     FunctionNode = NewObject<UK2Node_CallFunction>(EventGraph);
@@ -425,17 +356,18 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                         
                         FunctionNode->NodePosX = NodePosition.X;
                         FunctionNode->NodePosY = NodePosition.Y;
+                        EventGraph->Modify();
                         EventGraph->AddNode(FunctionNode);
                         FunctionNode->CreateNewGuid();
                         FunctionNode->PostPlacedNewNode();
                         FunctionNode->AllocateDefaultPins();
                         
-                        UE_LOG(LogTemp, Display, TEXT("Created GetActorOfClass node directly"));
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("Created GetActorOfClass node directly"));
                         
                         // List all pins
                         for (UEdGraphPin* Pin : FunctionNode->Pins)
                         {
-                            UE_LOG(LogTemp, Display, TEXT("  - Pin: %s, Direction: %d, Category: %s"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Pin: %s, Direction: %d, Category: %s"), 
                                    *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
                         }
                     }
@@ -447,7 +379,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     // If we still haven't found the function, try in the blueprint's class
     if (!Function && !FunctionNode)
     {
-        UE_LOG(LogTemp, Display, TEXT("Trying to find function in blueprint class"));
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Trying to find function in blueprint class"));
         Function = Blueprint->GeneratedClass->FindFunctionByName(*FunctionName);
     }
     
@@ -459,7 +391,9 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
     
     if (!FunctionNode)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Function not found: %s in target %s"), *FunctionName, Target.IsEmpty() ? TEXT("Blueprint") : *Target));
+        // Suggestions are only computed here, once the lookup has already failed
+        const FString Suggestions = bTargetClassMissing ? FUnrealMCPCommonUtils::GetClassSuggestionText(Target) : FString();
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Function not found: %s in target %s.%s"), *FunctionName, Target.IsEmpty() ? TEXT("Blueprint") : *Target, *Suggestions));
     }
 
     // Set parameters if provided
@@ -478,12 +412,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 UEdGraphPin* ParamPin = FUnrealMCPCommonUtils::FindPin(FunctionNode, ParamName, EGPD_Input);
                 if (ParamPin)
                 {
-                    UE_LOG(LogTemp, Display, TEXT("Found parameter pin '%s' of category '%s'"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Found parameter pin '%s' of category '%s'"), 
                            *ParamName, *ParamPin->PinType.PinCategory.ToString());
-                    UE_LOG(LogTemp, Display, TEXT("  Current default value: '%s'"), *ParamPin->DefaultValue);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("  Current default value: '%s'"), *ParamPin->DefaultValue);
                     if (ParamPin->PinType.PinSubCategoryObject.IsValid())
                     {
-                        UE_LOG(LogTemp, Display, TEXT("  Pin subcategory: '%s'"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Pin subcategory: '%s'"), 
                                *ParamPin->PinType.PinSubCategoryObject->GetName());
                     }
                     
@@ -491,38 +425,21 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     if (ParamValue->Type == EJson::String)
                     {
                         FString StringVal = ParamValue->AsString();
-                        UE_LOG(LogTemp, Display, TEXT("  Setting string parameter '%s' to: '%s'"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Setting string parameter '%s' to: '%s'"), 
                                *ParamName, *StringVal);
                         
                         // Handle class reference parameters (e.g., ActorClass in GetActorOfClass)
                         if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Class)
                         {
-                            // For class references, we require the exact class name with proper prefix
-                            // - Actor classes must start with 'A' (e.g., ACameraActor)
-                            // - Non-actor classes must start with 'U' (e.g., UObject)
+                            // For class references, accept the class name with or without its prefix, or its path
                             const FString& ClassName = StringVal;
-                            
-                            // TODO: This likely won't work in UE5.5+, so don't rely on it.
-                            UClass* Class = FindObject<UClass>(ANY_PACKAGE, *ClassName);
-
-                            if (!Class)
-                            {
-                                Class = LoadObject<UClass>(nullptr, *ClassName);
-                                UE_LOG(LogUnrealMCP, Display, TEXT("FindObject<UClass> failed. Assuming soft path  path: %s"), *ClassName);
-                            }
-                            
-                            // If not found, try with Engine module path
-                            if (!Class)
-                            {
-                                FString EngineClassName = FString::Printf(TEXT("/Script/Engine.%s"), *ClassName);
-                                Class = LoadObject<UClass>(nullptr, *EngineClassName);
-                                UE_LOG(LogUnrealMCP, Display, TEXT("Trying Engine module path: %s"), *EngineClassName);
-                            }
+                            UClass* Class = FUnrealMCPCommonUtils::FindClassByName(ClassName);
                             
                             if (!Class)
                             {
-                                UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find class '%s'. Make sure to use the exact class name with proper prefix (A for actors, U for non-actors)"), *ClassName);
-                                return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to find class '%s'"), *ClassName));
+                                UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find class '%s'"), *ClassName);
+                                return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to find class '%s'.%s"),
+                                    *ClassName, *FUnrealMCPCommonUtils::GetClassSuggestionText(ClassName)));
                             }
 
                             const UEdGraphSchema_K2* K2Schema = Cast<const UEdGraphSchema_K2>(EventGraph->GetSchema());
@@ -539,7 +456,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                                 return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to set class reference for pin '%s'"), *ParamPin->PinName.ToString()));
                             }
 
-                            UE_LOG(LogUnrealMCP, Log, TEXT("Successfully set class reference for pin '%s' to '%s'"), *ParamPin->PinName.ToString(), *ClassName);
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("Successfully set class reference for pin '%s' to '%s'"), *ParamPin->PinName.ToString(), *ClassName);
                             continue;
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Int)
@@ -547,7 +464,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // Ensure we're using an integer value (no decimal)
                             int32 IntValue = FMath::RoundToInt(ParamValue->AsNumber());
                             ParamPin->DefaultValue = FString::FromInt(IntValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
                                    *ParamName, IntValue, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Float)
@@ -555,14 +472,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // For other numeric types
                             float FloatValue = ParamValue->AsNumber();
                             ParamPin->DefaultValue = FString::SanitizeFloat(FloatValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
                                    *ParamName, FloatValue, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean)
                         {
                             bool BoolValue = ParamValue->AsBool();
                             ParamPin->DefaultValue = BoolValue ? TEXT("true") : TEXT("false");
-                            UE_LOG(LogTemp, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set boolean parameter '%s' to: %s"), 
                                    *ParamName, *ParamPin->DefaultValue);
                         }
                         else if (ParamPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct && ParamPin->PinType.PinSubCategoryObject == TBaseStructure<FVector>::Get())
@@ -582,14 +499,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                                     FString VectorString = FString::Printf(TEXT("(X=%f,Y=%f,Z=%f)"), X, Y, Z);
                                     ParamPin->DefaultValue = VectorString;
                                     
-                                    UE_LOG(LogTemp, Display, TEXT("  Set vector parameter '%s' to: %s"), 
+                                    UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set vector parameter '%s' to: %s"), 
                                            *ParamName, *VectorString);
-                                    UE_LOG(LogTemp, Display, TEXT("  Final pin value: '%s'"), 
+                                    UE_LOG(LogUnrealMCP, Verbose, TEXT("  Final pin value: '%s'"), 
                                            *ParamPin->DefaultValue);
                                 }
                                 else
                                 {
-                                    UE_LOG(LogTemp, Warning, TEXT("Array parameter type not fully supported yet"));
+                                    UE_LOG(LogUnrealMCP, Warning, TEXT("Array parameter type not fully supported yet"));
                                 }
                             }
                         }
@@ -602,7 +519,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // Ensure we're using an integer value (no decimal)
                             int32 IntValue = FMath::RoundToInt(ParamValue->AsNumber());
                             ParamPin->DefaultValue = FString::FromInt(IntValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set integer parameter '%s' to: %d (string: '%s')"), 
                                    *ParamName, IntValue, *ParamPin->DefaultValue);
                         }
                         else
@@ -610,7 +527,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                             // For other numeric types
                             float FloatValue = ParamValue->AsNumber();
                             ParamPin->DefaultValue = FString::SanitizeFloat(FloatValue);
-                            UE_LOG(LogTemp, Display, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
+                            UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set float parameter '%s' to: %f (string: '%s')"), 
                                    *ParamName, FloatValue, *ParamPin->DefaultValue);
                         }
                     }
@@ -618,12 +535,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                     {
                         bool BoolValue = ParamValue->AsBool();
                         ParamPin->DefaultValue = BoolValue ? TEXT("true") : TEXT("false");
-                        UE_LOG(LogTemp, Display, TEXT("  Set boolean parameter '%s' to: %s"), 
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set boolean parameter '%s' to: %s"), 
                                *ParamName, *ParamPin->DefaultValue);
                     }
                     else if (ParamValue->Type == EJson::Array)
                     {
-                        UE_LOG(LogTemp, Display, TEXT("  Processing array parameter '%s'"), *ParamName);
+                        UE_LOG(LogUnrealMCP, Verbose, TEXT("  Processing array parameter '%s'"), *ParamName);
                         // Handle array parameters - like Vector parameters
                         const TArray<TSharedPtr<FJsonValue>>* ArrayValue;
                         if (ParamValue->TryGetArray(ArrayValue))
@@ -641,14 +558,14 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                                 FString VectorString = FString::Printf(TEXT("(X=%f,Y=%f,Z=%f)"), X, Y, Z);
                                 ParamPin->DefaultValue = VectorString;
                                 
-                                UE_LOG(LogTemp, Display, TEXT("  Set vector parameter '%s' to: %s"), 
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("  Set vector parameter '%s' to: %s"), 
                                        *ParamName, *VectorString);
-                                UE_LOG(LogTemp, Display, TEXT("  Final pin value: '%s'"), 
+                                UE_LOG(LogUnrealMCP, Verbose, TEXT("  Final pin value: '%s'"), 
                                        *ParamPin->DefaultValue);
                             }
                             else
                             {
-                                UE_LOG(LogTemp, Warning, TEXT("Array parameter type not fully supported yet"));
+                                UE_LOG(LogUnrealMCP, Warning, TEXT("Array parameter type not fully supported yet"));
                             }
                         }
                     }
@@ -656,7 +573,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintFunct
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("Parameter pin '%s' not found"), *ParamName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Parameter pin '%s' not found"), *ParamName);
                 }
             }
         }
@@ -735,7 +652,8 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintVaria
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unsupported variable type: %s"), *VariableType));
     }
 
-    // Create the variable
+    // Create the variable; the Blueprint is recorded for undo even when the variable already exists
+    Blueprint->Modify();
     FBlueprintEditorUtils::AddMemberVariable(Blueprint, FName(*VariableName), PinType);
 
     // Set variable properties
@@ -910,7 +828,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNode
             UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
             if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
             {
-                UE_LOG(LogTemp, Display, TEXT("Found event node with name %s: %s"), *EventName, *EventNode->NodeGuid.ToString());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Found event node with name %s: %s"), *EventName, *EventNode->NodeGuid.ToString());
                 NodeGuidArray.Add(MakeShared<FJsonValueString>(EventNode->NodeGuid.ToString()));
             }
         }
@@ -0,0 +1,90 @@
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "UnrealMCPLog.h"
+
+const TCHAR* LexToString(EUnrealMCPCommandThread Thread)
+{
+    switch (Thread)
+    {
+    case EUnrealMCPCommandThread::AnyThread:
+        return TEXT("any_thread");
+    case EUnrealMCPCommandThread::GameThread:
+    default:
+        return TEXT("game_thread");
+    }
+}
+
+bool FUnrealMCPCommandRegistry::Register(FName CommandName, const FString& Category, FUnrealMCPCommandHandler Handler, EUnrealMCPCommandThread Thread)
+{
+    FUnrealMCPCommand* Command = Add(CommandName, Category, Thread);
+    if (!Command)
+    {
+        return false;
+    }
+
+    Command->Handler = MoveTemp(Handler);
+    return true;
+}
+
+bool FUnrealMCPCommandRegistry::Register(FName CommandName, const FString& Category, FUnrealMCPStreamingCommandHandler Handler, EUnrealMCPCommandThread Thread)
+{
+    FUnrealMCPCommand* Command = Add(CommandName, Category, Thread);
+    if (!Command)
+    {
+        return false;
+    }
+
+    Command->StreamingHandler = MoveTemp(Handler);
+    return true;
+}
+
+FUnrealMCPCommand* FUnrealMCPCommandRegistry::Add(FName CommandName, const FString& Category, EUnrealMCPCommandThread Thread)
+{
+    if (const FUnrealMCPCommand* Existing = Commands.Find(CommandName))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPCommandRegistry: Command '%s' is already registered by '%s', ignoring duplicate from '%s'"),
+            *CommandName.ToString(), *Existing->Category, *Category);
+        return nullptr;
+    }
+
+    FUnrealMCPCommand& Command = Commands.Add(CommandName);
+    Command.Category = Category;
+    Command.Thread = Thread;
+    return &Command;
+}
+
+const FUnrealMCPCommand* FUnrealMCPCommandRegistry::Find(FName CommandName) const
+{
+    return Commands.Find(CommandName);
+}
+
+const FUnrealMCPCommand* FUnrealMCPCommandRegistry::Find(const FString& CommandName) const
+{
+    // FNAME_Find returns NAME_None for names that were never registered anywhere
+    const FName Name(*CommandName, FNAME_Find);
+    return Name.IsNone() ? nullptr : Find(Name);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPCommandRegistry::ListCommands() const
+{
+    TArray<FName> Names;
+    Commands.GetKeys(Names);
+    Names.Sort(FNameLexicalLess());
+
+    TArray<TSharedPtr<FJsonValue>> CommandArray;
+    CommandArray.Reserve(Names.Num());
+    for (const FName& Name : Names)
+    {
+        TSharedPtr<FJsonObject> CommandObj = MakeShared<FJsonObject>();
+        const FUnrealMCPCommand& Command = Commands[Name];
+        CommandObj->SetStringField(TEXT("name"), Name.ToString());
+        CommandObj->SetStringField(TEXT("category"), Command.Category);
+        CommandObj->SetStringField(TEXT("thread"), LexToString(Command.Thread));
+        CommandObj->SetBoolField(TEXT("streaming"), Command.StreamingHandler.IsBound());
+        CommandArray.Add(MakeShared<FJsonValueObject>(CommandObj));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("commands"), CommandArray);
+    ResultObj->SetNumberField(TEXT("count"), CommandArray.Num());
+    return ResultObj;
+}
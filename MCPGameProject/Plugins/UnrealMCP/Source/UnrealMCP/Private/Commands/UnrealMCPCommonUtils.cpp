@@ -1,6 +1,13 @@
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPBridge.h"
+#include "UnrealMCPActorIndex.h"
+#include "UnrealMCPCompileScheduler.h"
+#include "UnrealMCPClassIndex.h"
+#include "Editor.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Blueprint.h"
+#include "WidgetBlueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EdGraph/EdGraphPin.h"
@@ -12,6 +19,7 @@
 #include "K2Node_Self.h"
 #include "EdGraphSchema_K2.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/LightComponent.h"
 #include "Components/PrimitiveComponent.h"
@@ -145,6 +153,36 @@ FRotator FUnrealMCPCommonUtils::GetRotatorFromJson(const TSharedPtr<FJsonObject>
     return Result;
 }
 
+// Class utilities
+UClass* FUnrealMCPCommonUtils::FindClassByName(const FString& ClassName, const UClass* BaseClass)
+{
+    // Accepts "StaticMesh", "StaticMeshComponent", "UStaticMeshComponent" or "/Script/Engine.StaticMeshComponent"
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    if (Bridge)
+    {
+        return Bridge->GetClassIndex().FindClass(ClassName, BaseClass);
+    }
+
+    UClass* Class = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::None);
+    return Class && (!BaseClass || Class->IsChildOf(BaseClass)) ? Class : nullptr;
+}
+
+FString FUnrealMCPCommonUtils::GetClassSuggestionText(const FString& ClassName, const UClass* BaseClass)
+{
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    if (!Bridge)
+    {
+        return FString();
+    }
+
+    const TArray<FString> Suggestions = Bridge->GetClassIndex().GetSuggestions(ClassName, BaseClass);
+    if (Suggestions.Num() == 0)
+    {
+        return FString();
+    }
+    return FString::Printf(TEXT(" Did you mean: %s?"), *FString::Join(Suggestions, TEXT(", ")));
+}
+
 // Blueprint Utilities
 UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName)
 {
@@ -153,10 +191,29 @@ UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName)
 
 UBlueprint* FUnrealMCPCommonUtils::FindBlueprintByName(const FString& BlueprintName)
 {
+    // Resolves Blueprints anywhere in the project; /Game/Blueprints wins when names collide
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    if (Bridge)
+    {
+        return Bridge->GetAssetCache().FindBlueprint(BlueprintName, UBlueprint::StaticClass(), TEXT("/Game/Blueprints"));
+    }
+
     FString AssetPath = TEXT("/Game/Blueprints/") + BlueprintName;
     return LoadObject<UBlueprint>(nullptr, *AssetPath);
 }
 
+UBlueprint* FUnrealMCPCommonUtils::FindWidgetBlueprint(const FString& BlueprintName)
+{
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    if (Bridge)
+    {
+        return Bridge->GetAssetCache().FindBlueprint(BlueprintName, UWidgetBlueprint::StaticClass(), TEXT("/Game/Widgets"));
+    }
+
+    FString AssetPath = TEXT("/Game/Widgets/") + BlueprintName;
+    return LoadObject<UWidgetBlueprint>(nullptr, *AssetPath);
+}
+
 UEdGraph* FUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
 {
     if (!Blueprint)
@@ -179,6 +236,38 @@ UEdGraph* FUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
     return NewGraph;
 }
 
+FUnrealMCPCompileScheduler* FUnrealMCPCommonUtils::GetCompileScheduler()
+{
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    return Bridge ? &Bridge->GetCompileScheduler() : nullptr;
+}
+
+void FUnrealMCPCommonUtils::MarkBlueprintForCompile(UBlueprint* Blueprint, bool bSave)
+{
+    if (FUnrealMCPCompileScheduler* Scheduler = GetCompileScheduler())
+    {
+        Scheduler->MarkDirty(Blueprint, bSave);
+    }
+    else if (Blueprint)
+    {
+        // No bridge to defer to, compile (and save) right away
+        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        if (bSave)
+        {
+            UEditorAssetLibrary::SaveLoadedAsset(Blueprint, false);
+        }
+    }
+}
+
+void FUnrealMCPCommonUtils::FlushBlueprintCompile(UBlueprint* Blueprint)
+{
+    // Commands that use the generated class need the Blueprint's pending edits compiled in
+    if (FUnrealMCPCompileScheduler* Scheduler = GetCompileScheduler())
+    {
+        Scheduler->Flush(Blueprint);
+    }
+}
+
 // Blueprint node utilities
 UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FString& EventName, const FVector2D& Position)
 {
@@ -199,7 +288,7 @@ UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FSt
         UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
         if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
         {
-            UE_LOG(LogTemp, Display, TEXT("Using existing event node with name %s (ID: %s)"), 
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Using existing event node with name %s (ID: %s)"), 
                 *EventName, *EventNode->NodeGuid.ToString());
             return EventNode;
         }
@@ -218,15 +307,17 @@ UK2Node_Event* FUnrealMCPCommonUtils::CreateEventNode(UEdGraph* Graph, const FSt
         EventNode->EventReference.SetExternalMember(FName(*EventName), BlueprintClass);
         EventNode->NodePosX = Position.X;
         EventNode->NodePosY = Position.Y;
+        // AddNode doesn't record the graph for undo, so the node would outlive an undo of the edit
+        Graph->Modify();
         Graph->AddNode(EventNode, true);
         EventNode->PostPlacedNewNode();
         EventNode->AllocateDefaultPins();
-        UE_LOG(LogTemp, Display, TEXT("Created new event node with name %s (ID: %s)"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("Created new event node with name %s (ID: %s)"), 
             *EventName, *EventNode->NodeGuid.ToString());
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to find function for event name: %s"), *EventName);
+        UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find function for event name: %s"), *EventName);
     }
     
     return EventNode;
@@ -243,6 +334,7 @@ UK2Node_CallFunction* FUnrealMCPCommonUtils::CreateFunctionCallNode(UEdGraph* Gr
     FunctionNode->SetFromFunction(Function);
     FunctionNode->NodePosX = Position.X;
     FunctionNode->NodePosY = Position.Y;
+    Graph->Modify();
     Graph->AddNode(FunctionNode, true);
     FunctionNode->CreateNewGuid();
     FunctionNode->PostPlacedNewNode();
@@ -268,6 +360,7 @@ UK2Node_VariableGet* FUnrealMCPCommonUtils::CreateVariableGetNode(UEdGraph* Grap
         VariableGetNode->VariableReference.SetFromField<FProperty>(Property, false);
         VariableGetNode->NodePosX = Position.X;
         VariableGetNode->NodePosY = Position.Y;
+        Graph->Modify();
         Graph->AddNode(VariableGetNode, true);
         VariableGetNode->PostPlacedNewNode();
         VariableGetNode->AllocateDefaultPins();
@@ -295,6 +388,7 @@ UK2Node_VariableSet* FUnrealMCPCommonUtils::CreateVariableSetNode(UEdGraph* Grap
         VariableSetNode->VariableReference.SetFromField<FProperty>(Property, false);
         VariableSetNode->NodePosX = Position.X;
         VariableSetNode->NodePosY = Position.Y;
+        Graph->Modify();
         Graph->AddNode(VariableSetNode, true);
         VariableSetNode->PostPlacedNewNode();
         VariableSetNode->AllocateDefaultPins();
@@ -316,6 +410,7 @@ UK2Node_InputAction* FUnrealMCPCommonUtils::CreateInputActionNode(UEdGraph* Grap
     InputActionNode->InputActionName = FName(*ActionName);
     InputActionNode->NodePosX = Position.X;
     InputActionNode->NodePosY = Position.Y;
+    Graph->Modify();
     Graph->AddNode(InputActionNode, true);
     InputActionNode->CreateNewGuid();
     InputActionNode->PostPlacedNewNode();
@@ -334,6 +429,7 @@ UK2Node_Self* FUnrealMCPCommonUtils::CreateSelfReferenceNode(UEdGraph* Graph, co
     UK2Node_Self* SelfNode = NewObject<UK2Node_Self>(Graph);
     SelfNode->NodePosX = Position.X;
     SelfNode->NodePosY = Position.Y;
+    Graph->Modify();
     Graph->AddNode(SelfNode, true);
     SelfNode->CreateNewGuid();
     SelfNode->PostPlacedNewNode();
@@ -355,6 +451,8 @@ bool FUnrealMCPCommonUtils::ConnectGraphNodes(UEdGraph* Graph, UEdGraphNode* Sou
     
     if (SourcePin && TargetPin)
     {
+        SourceNode->Modify();
+        TargetNode->Modify();
         SourcePin->MakeLinkTo(TargetPin);
         return true;
     }
@@ -370,12 +468,12 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     }
     
     // Log all pins for debugging
-    UE_LOG(LogTemp, Display, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
            *PinName, (int32)Direction, *Node->GetName());
     
     for (UEdGraphPin* Pin : Node->Pins)
     {
-        UE_LOG(LogTemp, Display, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
                *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
     }
     
@@ -384,7 +482,7 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     {
         if (Pin->PinName.ToString() == PinName && (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
             return Pin;
         }
     }
@@ -395,7 +493,7 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         if (Pin->PinName.ToString().Equals(PinName, ESearchCase::IgnoreCase) && 
             (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
             return Pin;
         }
     }
@@ -407,17 +505,36 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         {
             if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
             {
-                UE_LOG(LogTemp, Display, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
                 return Pin;
             }
         }
     }
     
-    UE_LOG(LogTemp, Warning, TEXT("  - No matching pin found for '%s'"), *PinName);
+    UE_LOG(LogUnrealMCP, Warning, TEXT("  - No matching pin found for '%s'"), *PinName);
     return nullptr;
 }
 
 // Actor utilities
+FUnrealMCPActorIndex* FUnrealMCPCommonUtils::GetActorIndex()
+{
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    return Bridge ? &Bridge->GetActorIndex() : nullptr;
+}
+
+AActor* FUnrealMCPCommonUtils::FindActorByName(const FString& ActorName)
+{
+    // Matches the actor label first, then the object name
+    FUnrealMCPActorIndex* ActorIndex = GetActorIndex();
+    return ActorIndex ? ActorIndex->FindActorByName(ActorName) : nullptr;
+}
+
+AActor* FUnrealMCPCommonUtils::FindActorByLabel(const FString& ActorLabel)
+{
+    FUnrealMCPActorIndex* ActorIndex = GetActorIndex();
+    return ActorIndex ? ActorIndex->FindActorByLabel(ActorLabel) : nullptr;
+}
+
 TSharedPtr<FJsonValue> FUnrealMCPCommonUtils::ActorToJson(AActor* Actor)
 {
     if (!Actor)
@@ -501,7 +618,7 @@ UK2Node_Event* FUnrealMCPCommonUtils::FindExistingEventNode(UEdGraph* Graph, con
         UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
         if (EventNode && EventNode->EventReference.GetMemberName() == FName(*EventName))
         {
-            UE_LOG(LogTemp, Display, TEXT("Found existing event node with name: %s"), *EventName);
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("Found existing event node with name: %s"), *EventName);
             return EventNode;
         }
     }
@@ -525,6 +642,9 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
         return false;
     }
 
+    // Snapshot the object for undo when a transaction is open; a no-op otherwise
+    Object->Modify();
+
     void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Object);
     
     // Handle different property types
@@ -567,7 +687,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 uint8 ByteValue = static_cast<uint8>(Value->AsNumber());
                 ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
                 
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %d"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric value: %d"), 
                       *PropertyName, ByteValue);
                 return true;
             }
@@ -582,7 +702,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                     uint8 ByteValue = FCString::Atoi(*EnumValueName);
                     ByteProp->SetPropertyValue(PropertyAddr, ByteValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %d"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric string value: %s -> %d"), 
                           *PropertyName, *EnumValueName, ByteValue);
                     return true;
                 }
@@ -604,17 +724,17 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 {
                     ByteProp->SetPropertyValue(PropertyAddr, static_cast<uint8>(EnumValue));
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to name value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
                 else
                 {
                     // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
                     for (int32 i = 0; i < EnumDef->NumEnums(); i++)
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("  - %s (value: %d)"), 
                                *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
                     }
                     
@@ -645,7 +765,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 int64 EnumValue = static_cast<int64>(Value->AsNumber());
                 UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                 
-                UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric value: %lld"), 
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric value: %lld"), 
                       *PropertyName, EnumValue);
                 return true;
             }
@@ -660,7 +780,7 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                     int64 EnumValue = FCString::Atoi64(*EnumValueName);
                     UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to numeric string value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to numeric string value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
@@ -682,17 +802,17 @@ bool FUnrealMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Pr
                 {
                     UnderlyingNumericProp->SetIntPropertyValue(PropertyAddr, EnumValue);
                     
-                    UE_LOG(LogTemp, Display, TEXT("Setting enum property %s to name value: %s -> %lld"), 
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Setting enum property %s to name value: %s -> %lld"), 
                           *PropertyName, *EnumValueName, EnumValue);
                     return true;
                 }
                 else
                 {
                     // Log all possible enum values for debugging
-                    UE_LOG(LogTemp, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
+                    UE_LOG(LogUnrealMCP, Warning, TEXT("Could not find enum value for '%s'. Available options:"), *EnumValueName);
                     for (int32 i = 0; i < EnumDef->NumEnums(); i++)
                     {
-                        UE_LOG(LogTemp, Warning, TEXT("  - %s (value: %d)"), 
+                        UE_LOG(LogUnrealMCP, Warning, TEXT("  - %s (value: %d)"), 
                                *EnumDef->GetNameStringByIndex(i), EnumDef->GetValueByIndex(i));
                     }
                     
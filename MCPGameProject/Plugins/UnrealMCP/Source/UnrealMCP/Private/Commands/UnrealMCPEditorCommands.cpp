@@ -1,5 +1,10 @@
 #include "Commands/UnrealMCPEditorCommands.h"
+#include "UnrealMCPLog.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "UnrealMCPActorIndex.h"
+#include "UnrealMCPResponseWriter.h"
+#include "Algo/BinarySearch.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
@@ -9,7 +14,6 @@
 #include "Misc/FileHelper.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Selection.h"
-#include "Kismet/GameplayStatics.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/DirectionalLight.h"
 #include "Engine/PointLight.h"
@@ -26,107 +30,333 @@ FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPEditorCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    // Actor manipulation commands
-    if (CommandType == TEXT("get_actors_in_level"))
+    Registry.Register(TEXT("get_actors_in_level"), TEXT("editor"), FUnrealMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleGetActorsInLevel));
+    Registry.Register(TEXT("find_actors_by_name"), TEXT("editor"), FUnrealMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleFindActorsByName));
+    Registry.Register(TEXT("spawn_actor"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSpawnActor));
+    Registry.Register(TEXT("create_actor"), TEXT("editor"), FUnrealMCPCommandHandler::CreateLambda([this](const TSharedPtr<FJsonObject>& Params)
     {
-        return HandleGetActorsInLevel(Params);
-    }
-    else if (CommandType == TEXT("find_actors_by_name"))
-    {
-        return HandleFindActorsByName(Params);
+        UE_LOG(LogUnrealMCP, Warning, TEXT("'create_actor' command is deprecated and will be removed in a future version. Please use 'spawn_actor' instead."));
+        return HandleSpawnActor(Params);
+    }));
+    Registry.Register(TEXT("delete_actor"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleDeleteActor));
+    Registry.Register(TEXT("set_actor_transform"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSetActorTransform));
+    Registry.Register(TEXT("get_actor_properties"), TEXT("editor"), FUnrealMCPStreamingCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleGetActorProperties));
+    Registry.Register(TEXT("set_actor_property"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSetActorProperty));
+    Registry.Register(TEXT("spawn_blueprint_actor"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSpawnBlueprintActor));
+    Registry.Register(TEXT("focus_viewport"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleFocusViewport));
+    Registry.Register(TEXT("take_screenshot"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleTakeScreenshot));
+    Registry.Register(TEXT("set_actor_material"), TEXT("editor"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPEditorCommands::HandleSetActorMaterial));
+}
+
+namespace UnrealMCPActorQuery
+{
+    /** Actor fields that get_actors_in_level can return */
+    enum EActorField : uint32
+    {
+        Field_Name     = 1 << 0,
+        Field_Label    = 1 << 1,
+        Field_Class    = 1 << 2,
+        Field_Location = 1 << 3,
+        Field_Rotation = 1 << 4,
+        Field_Scale    = 1 << 5,
+        Field_Tags     = 1 << 6,
+        Field_Path     = 1 << 7,
+
+        // Same shape as FUnrealMCPCommonUtils::ActorToJson, returned when no projection is requested
+        Field_Default  = Field_Name | Field_Class | Field_Location | Field_Rotation | Field_Scale,
+    };
+
+    static bool ParseFields(const TSharedPtr<FJsonObject>& Params, uint32& OutFields, FString& OutError)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* FieldArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("fields"), FieldArray))
+        {
+            OutFields = Field_Default;
+            return true;
+        }
+
+        static const TMap<FString, uint32> FieldsByName = {
+            { TEXT("name"), Field_Name },
+            { TEXT("label"), Field_Label },
+            { TEXT("class"), Field_Class },
+            { TEXT("location"), Field_Location },
+            { TEXT("rotation"), Field_Rotation },
+            { TEXT("scale"), Field_Scale },
+            { TEXT("tags"), Field_Tags },
+            { TEXT("path"), Field_Path },
+        };
+
+        OutFields = 0;
+        for (const TSharedPtr<FJsonValue>& FieldValue : *FieldArray)
+        {
+            const uint32* Field = FieldsByName.Find(FieldValue->AsString());
+            if (!Field)
+            {
+                OutError = FString::Printf(TEXT("Unknown field '%s'. Valid fields: name, label, class, location, rotation, scale, tags, path"), *FieldValue->AsString());
+                return false;
+            }
+            OutFields |= *Field;
+        }
+        return true;
     }
-    else if (CommandType == TEXT("spawn_actor") || CommandType == TEXT("create_actor"))
+
+    /** Writes the requested fields of Actor into the object being written */
+    static void WriteActorFields(FUnrealMCPResponseWriter& Writer, AActor* Actor, uint32 Fields)
     {
-        if (CommandType == TEXT("create_actor"))
+        if (Fields & Field_Name)
         {
-            UE_LOG(LogTemp, Warning, TEXT("'create_actor' command is deprecated and will be removed in a future version. Please use 'spawn_actor' instead."));
+            Writer.WriteValue(TEXT("name"), Actor->GetName());
+        }
+        if (Fields & Field_Label)
+        {
+            Writer.WriteValue(TEXT("label"), Actor->GetActorLabel());
+        }
+        if (Fields & Field_Class)
+        {
+            Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetName());
+        }
+        if (Fields & Field_Location)
+        {
+            Writer.WriteVector(TEXT("location"), Actor->GetActorLocation());
+        }
+        if (Fields & Field_Rotation)
+        {
+            Writer.WriteRotator(TEXT("rotation"), Actor->GetActorRotation());
+        }
+        if (Fields & Field_Scale)
+        {
+            Writer.WriteVector(TEXT("scale"), Actor->GetActorScale3D());
+        }
+        if (Fields & Field_Tags)
+        {
+            Writer.WriteArrayStart(TEXT("tags"));
+            for (const FName& Tag : Actor->Tags)
+            {
+                Writer.WriteValue(Tag.ToString());
+            }
+            Writer.WriteArrayEnd();
+        }
+        if (Fields & Field_Path)
+        {
+            Writer.WriteValue(TEXT("path"), Actor->GetPathName());
         }
-        return HandleSpawnActor(Params);
     }
-    else if (CommandType == TEXT("delete_actor"))
+
+    /** Writes Actor as an array element */
+    static void WriteActor(FUnrealMCPResponseWriter& Writer, AActor* Actor, uint32 Fields)
     {
-        return HandleDeleteActor(Params);
+        Writer.WriteObjectStart();
+        WriteActorFields(Writer, Actor, Fields);
+        Writer.WriteObjectEnd();
     }
-    else if (CommandType == TEXT("set_actor_transform"))
+}
+
+bool FUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params, FUnrealMCPResponseWriter& Writer, FString& OutError)
+{
+    using namespace UnrealMCPActorQuery;
+    
+    FUnrealMCPActorIndex* ActorIndex = FUnrealMCPCommonUtils::GetActorIndex();
+    if (!ActorIndex)
     {
-        return HandleSetActorTransform(Params);
+        OutError = TEXT("Actor index is not available");
+        return false;
     }
-    else if (CommandType == TEXT("get_actor_properties"))
+    
+    uint32 Fields = Field_Default;
+    if (!ParseFields(Params, Fields, OutError))
     {
-        return HandleGetActorProperties(Params);
+        return false;
     }
-    else if (CommandType == TEXT("set_actor_property"))
+    
+    // Paging: an optional cursor (the name of the last actor of the previous page), then offset and limit
+    int32 Offset = 0;
+    Params->TryGetNumberField(TEXT("offset"), Offset);
+    Offset = FMath::Max(Offset, 0);
+    
+    int32 Limit = 0;
+    Params->TryGetNumberField(TEXT("limit"), Limit);
+    
+    FString Cursor;
+    Params->TryGetStringField(TEXT("cursor"), Cursor);
+    
+    // The class filter comes straight from the index's per-class tables
+    TSet<const AActor*> ClassMatches;
+    FString ClassFilter;
+    const bool bHasClassFilter = Params->TryGetStringField(TEXT("class"), ClassFilter) && !ClassFilter.IsEmpty();
+    if (bHasClassFilter)
     {
-        return HandleSetActorProperty(Params);
+        TArray<AActor*> ClassActors;
+        ActorIndex->GetActorsOfClass(ClassFilter, ClassActors);
+        ClassMatches.Append(ClassActors);
     }
-    // Blueprint actor spawning
-    else if (CommandType == TEXT("spawn_blueprint_actor"))
+    
+    // Remaining filters only read cached actor state, so evaluating them for every actor stays cheap
+    TArray<FName> TagFilter;
+    const TArray<TSharedPtr<FJsonValue>>* TagArray = nullptr;
+    FString SingleTag;
+    if (Params->TryGetArrayField(TEXT("tags"), TagArray))
     {
-        return HandleSpawnBlueprintActor(Params);
+        for (const TSharedPtr<FJsonValue>& TagValue : *TagArray)
+        {
+            TagFilter.Add(FName(*TagValue->AsString()));
+        }
     }
-    // Editor viewport commands
-    else if (CommandType == TEXT("focus_viewport"))
+    else if (Params->TryGetStringField(TEXT("tag"), SingleTag))
     {
-        return HandleFocusViewport(Params);
+        TagFilter.Add(FName(*SingleTag));
     }
-    else if (CommandType == TEXT("take_screenshot"))
+    
+    const TSharedPtr<FJsonObject>* BoundsObject = nullptr;
+    const bool bHasBounds = Params->TryGetObjectField(TEXT("bounds"), BoundsObject);
+    const FBox Bounds = bHasBounds
+        ? FBox(FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObject, TEXT("min")), FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObject, TEXT("max")))
+        : FBox(ForceInit);
+    
+    const bool bFiltered = bHasClassFilter || TagFilter.Num() > 0 || bHasBounds;
+    auto Matches = [&](const AActor* Actor)
     {
-        return HandleTakeScreenshot(Params);
-    }
-    else if (CommandType == TEXT("set_actor_material"))
+        if (bHasClassFilter && !ClassMatches.Contains(Actor))
+        {
+            return false;
+        }
+        if (bHasBounds && !Bounds.IsInsideOrOn(Actor->GetActorLocation()))
+        {
+            return false;
+        }
+        if (TagFilter.Num() == 0)
+        {
+            return true;
+        }
+        for (const FName& Tag : TagFilter)
+        {
+            if (Actor->ActorHasTag(Tag))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    
+    // Pages follow object name order so they are stable while actors are added and removed. The index keeps
+    // the actors sorted between changes, so a page only costs a binary search for the cursor, plus a pass of
+    // the filters over the level when there are filters, to count the matches
+    using FNamedActor = FUnrealMCPActorIndex::FNamedActor;
+    const TArray<FNamedActor>& SortedActors = ActorIndex->GetActorsSortedByName();
+    
+    int32 First = 0;
+    if (!Cursor.IsEmpty())
     {
-        return HandleSetActorMaterial(Params);
+        const FName CursorName(*Cursor);
+        First = Algo::UpperBound(SortedActors, CursorName, [](const FName& Name, const FNamedActor& Entry)
+        {
+            return Name.LexicalLess(Entry.Name);
+        });
     }
     
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
-}
-
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
-{
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    TArray<TSharedPtr<FJsonValue>> ActorArray;
-    for (AActor* Actor : AllActors)
+    TArray<AActor*> Page;
+    int32 Total = 0;
+    int32 Start = 0;
+    bool bMore = false;
+    if (!bFiltered)
+    {
+        Total = SortedActors.Num();
+        Start = FMath::Min(First + Offset, Total);
+        int32 Index = Start;
+        for (; Index < Total && (Limit <= 0 || Page.Num() < Limit); ++Index)
+        {
+            AActor* Actor = SortedActors[Index].Actor.Get();
+            if (IsValid(Actor))
+            {
+                Page.Add(Actor);
+            }
+        }
+        bMore = Index < Total;
+    }
+    else
     {
-        if (Actor)
+        int32 MatchesBeforeCursor = 0;
+        for (int32 Index = 0; Index < SortedActors.Num(); ++Index)
         {
-            ActorArray.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+            AActor* Actor = SortedActors[Index].Actor.Get();
+            if (!IsValid(Actor) || !Matches(Actor))
+            {
+                continue;
+            }
+            
+            const int32 Position = Total++;
+            if (Index < First)
+            {
+                ++MatchesBeforeCursor;
+            }
+            else if (Position >= MatchesBeforeCursor + Offset)
+            {
+                if (Limit <= 0 || Page.Num() < Limit)
+                {
+                    Page.Add(Actor);
+                }
+                else
+                {
+                    bMore = true;
+                }
+            }
         }
+        Start = FMath::Min(MatchesBeforeCursor + Offset, Total);
     }
     
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
+    // Only the requested page is serialized, straight into the response
+    Writer.WriteArrayStart(TEXT("actors"));
+    for (AActor* Actor : Page)
+    {
+        WriteActor(Writer, Actor, Fields);
+    }
+    Writer.WriteArrayEnd();
     
-    return ResultObj;
+    Writer.WriteValue(TEXT("total"), Total);
+    Writer.WriteValue(TEXT("start"), Start);
+    if (bMore && Page.Num() > 0)
+    {
+        Writer.WriteValue(TEXT("next_cursor"), Page.Last()->GetName());
+    }
+    
+    return true;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
+bool FUnrealMCPEditorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params, FUnrealMCPResponseWriter& Writer, FString& OutError)
 {
+    using namespace UnrealMCPActorQuery;
+    
     FString Pattern;
     if (!Params->TryGetStringField(TEXT("pattern"), Pattern))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
+        OutError = TEXT("Missing 'pattern' parameter");
+        return false;
     }
     
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
+    FUnrealMCPActorIndex* ActorIndex = FUnrealMCPCommonUtils::GetActorIndex();
+    if (!ActorIndex)
+    {
+        OutError = TEXT("Actor index is not available");
+        return false;
+    }
     
-    TArray<TSharedPtr<FJsonValue>> MatchingActors;
-    for (AActor* Actor : AllActors)
+    // The index's name-sorted view of the editor world; names are matched before the actor is resolved
+    Writer.WriteArrayStart(TEXT("actors"));
+    for (const FUnrealMCPActorIndex::FNamedActor& Entry : ActorIndex->GetActorsSortedByName())
     {
-        if (Actor && Actor->GetName().Contains(Pattern))
+        if (!Entry.Name.ToString().Contains(Pattern))
         {
-            MatchingActors.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+            continue;
+        }
+        if (AActor* Actor = Entry.Actor.Get())
+        {
+            WriteActor(Writer, Actor, Field_Default);
         }
     }
+    Writer.WriteArrayEnd();
     
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("actors"), MatchingActors);
-    
-    return ResultObj;
+    return true;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TSharedPtr<FJsonObject>& Params)
@@ -173,14 +403,9 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
     }
 
     // Check if an actor with this name already exists
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
-    for (AActor* Actor : AllActors)
+    if (FUnrealMCPCommonUtils::FindActorByLabel(ActorName))
     {
-        if (Actor && Actor->GetActorLabel() == ActorName)
-        {
-            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
     }
 
     // Use spawn parameters without forcing a specific FName to avoid crashes
@@ -200,22 +425,22 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
             if (Params->HasField(TEXT("static_mesh")))
             {
                 StaticMeshPath = Params->GetStringField(TEXT("static_mesh"));
-                UE_LOG(LogTemp, Warning, TEXT("Loading static mesh: %s"), *StaticMeshPath);
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("Loading static mesh: %s"), *StaticMeshPath);
                 
                 UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, *StaticMeshPath);
                 if (Mesh)
                 {
                     MeshActor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
-                    UE_LOG(LogTemp, Warning, TEXT("Successfully set static mesh: %s"), *StaticMeshPath);
+                    UE_LOG(LogUnrealMCP, Verbose, TEXT("Successfully set static mesh: %s"), *StaticMeshPath);
                 }
                 else
                 {
-                    UE_LOG(LogTemp, Error, TEXT("Failed to load static mesh: %s"), *StaticMeshPath);
+                    UE_LOG(LogUnrealMCP, Error, TEXT("Failed to load static mesh: %s"), *StaticMeshPath);
                 }
             }
             else
             {
-                UE_LOG(LogTemp, Warning, TEXT("No static_mesh parameter provided for StaticMeshActor"));
+                UE_LOG(LogUnrealMCP, Verbose, TEXT("No static_mesh parameter provided for StaticMeshActor"));
             }
         }
     }
@@ -265,26 +490,23 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TShare
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
     }
 
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+    AActor* Actor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
+    if (!Actor)
     {
-        if (Actor && (Actor->GetActorLabel() == ActorName || Actor->GetName() == ActorName))
-        {
-            // Store actor info before deletion for the response
-            TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
-            
-            // Delete the actor
-            Actor->Destroy();
-            
-            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-            ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
-            return ResultObj;
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
     }
     
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+    // Store actor info before deletion for the response
+    TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
+    
+    // Delete the actor; recorded in the open MCP transaction, if any, so the deletion can be undone
+    Actor->Modify();
+    Actor->GetLevel()->Modify();
+    Actor->Destroy();
+    
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
+    return ResultObj;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params)
@@ -297,18 +519,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && (Actor->GetActorLabel() == ActorName || Actor->GetName() == ActorName))
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
 
     if (!TargetActor)
     {
@@ -332,42 +543,37 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const
     }
 
     // Set the new transform
+    TargetActor->Modify();
     TargetActor->SetActorTransform(NewTransform);
 
     // Return updated actor info
     return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params)
+bool FUnrealMCPEditorCommands::HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params, FUnrealMCPResponseWriter& Writer, FString& OutError)
 {
+    using namespace UnrealMCPActorQuery;
+    
     // Get actor name
     FString ActorName;
     if (!Params->TryGetStringField(TEXT("name"), ActorName))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
+        OutError = TEXT("Missing 'name' parameter");
+        return false;
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && (Actor->GetActorLabel() == ActorName || Actor->GetName() == ActorName))
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
 
     if (!TargetActor)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+        OutError = FString::Printf(TEXT("Actor not found: %s"), *ActorName);
+        return false;
     }
 
-    // Always return detailed properties for this command
-    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+    // Same fields as FUnrealMCPCommonUtils::ActorToJsonObject
+    WriteActorFields(Writer, TargetActor, Field_Default);
+    return true;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params)
@@ -380,18 +586,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const T
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && (Actor->GetActorLabel() == ActorName || Actor->GetName() == ActorName))
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
 
     if (!TargetActor)
     {
@@ -454,15 +649,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Blueprint name is empty"));
     }
 
-    FString Root      = TEXT("/Game/Blueprints/");
-    FString AssetPath = Root + BlueprintName;
-
-    if (!FPackageName::DoesPackageExist(AssetPath))
-    {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint '%s' not found – it must reside under /Game/Blueprints"), *BlueprintName));
-    }
-
-    UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
     if (!Blueprint)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
@@ -501,6 +688,8 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
     FActorSpawnParameters SpawnParams;
     SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
+    // Spawn from the generated class with every pending edit compiled in
+    FUnrealMCPCommonUtils::FlushBlueprintCompile(Blueprint);
     AActor* NewActor = World->SpawnActor<AActor>(Blueprint->GeneratedClass, SpawnTransform, SpawnParams);
     if (NewActor)
     {
@@ -554,18 +743,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     if (HasTargetActor)
     {
         // Find the actor
-        AActor* TargetActor = nullptr;
-        TArray<AActor*> AllActors;
-        UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-        
-        for (AActor* Actor : AllActors)
-        {
-            if (Actor && (Actor->GetActorLabel() == TargetActorName || Actor->GetName() == TargetActorName))
-            {
-                TargetActor = Actor;
-                break;
-            }
-        }
+        AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(TargetActorName);
 
         if (!TargetActor)
         {
@@ -648,18 +826,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorMaterial(const T
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && (Actor->GetActorLabel() == ActorName || Actor->GetName() == ActorName))
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = FUnrealMCPCommonUtils::FindActorByName(ActorName);
 
     if (!TargetActor)
     {
@@ -696,6 +863,9 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorMaterial(const T
     float B = (*ColorArray)[2]->AsNumber();
     FLinearColor Color(R, G, B, 1.0f);
 
+    // SetMaterial doesn't record the component for undo itself
+    MeshComponent->Modify();
+
     // Create a dynamic material instance from the basic material
     UMaterial* BaseMaterial = LoadObject<UMaterial>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial"));
     if (!BaseMaterial)
@@ -1,19 +1,22 @@
 #include "Commands/UnrealMCPProjectCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "GameFramework/InputSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+#include "Algo/BinarySearch.h"
 
 FUnrealMCPProjectCommands::FUnrealMCPProjectCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPProjectCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("create_input_mapping"))
-    {
-        return HandleCreateInputMapping(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown project command: %s"), *CommandType));
+    Registry.Register(TEXT("create_input_mapping"), TEXT("project"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPProjectCommands::HandleCreateInputMapping));
+    Registry.Register(TEXT("find_assets"), TEXT("project"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPProjectCommands::HandleFindAssets));
+    Registry.Register(TEXT("list_blueprints"), TEXT("project"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPProjectCommands::HandleListBlueprints));
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params)
@@ -69,4 +72,316 @@ TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCreateInputMapping(cons
     ResultObj->SetStringField(TEXT("action_name"), ActionName);
     ResultObj->SetStringField(TEXT("key"), Key);
     return ResultObj;
-} 
\ No newline at end of file
+}
+
+namespace UnrealMCPAssetQuery
+{
+    /** Asset fields that find_assets can return; all of them come from FAssetData */
+    enum EAssetField : uint32
+    {
+        Field_Name         = 1 << 0,
+        Field_Path         = 1 << 1,
+        Field_Package      = 1 << 2,
+        Field_PackagePath  = 1 << 3,
+        Field_Class        = 1 << 4,
+        Field_ParentClass  = 1 << 5,
+        Field_Tags         = 1 << 6,
+
+        Field_Default      = Field_Name | Field_Path | Field_Class,
+    };
+
+    static bool ParseFields(const TSharedPtr<FJsonObject>& Params, uint32 DefaultFields, uint32& OutFields, FString& OutError)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* FieldArray = nullptr;
+        if (!Params->TryGetArrayField(TEXT("fields"), FieldArray))
+        {
+            OutFields = DefaultFields;
+            return true;
+        }
+
+        static const TMap<FString, uint32> FieldsByName = {
+            { TEXT("name"), Field_Name },
+            { TEXT("path"), Field_Path },
+            { TEXT("package"), Field_Package },
+            { TEXT("package_path"), Field_PackagePath },
+            { TEXT("class"), Field_Class },
+            { TEXT("parent_class"), Field_ParentClass },
+            { TEXT("tags"), Field_Tags },
+        };
+
+        OutFields = 0;
+        for (const TSharedPtr<FJsonValue>& FieldValue : *FieldArray)
+        {
+            const uint32* Field = FieldsByName.Find(FieldValue->AsString());
+            if (!Field)
+            {
+                OutError = FString::Printf(TEXT("Unknown field '%s'. Valid fields: name, path, package, package_path, class, parent_class, tags"), *FieldValue->AsString());
+                return false;
+            }
+            OutFields |= *Field;
+        }
+        return true;
+    }
+
+    /** Accepts a class path (/Script/Engine.StaticMesh) or a short class name (StaticMesh) */
+    static bool ResolveClassPath(const FString& ClassName, FTopLevelAssetPath& OutClassPath)
+    {
+        if (ClassName.StartsWith(TEXT("/")))
+        {
+            OutClassPath = FTopLevelAssetPath(ClassName);
+            return OutClassPath.IsValid();
+        }
+
+        const UClass* Class = FUnrealMCPCommonUtils::FindClassByName(ClassName);
+        if (!Class)
+        {
+            return false;
+        }
+        OutClassPath = Class->GetClassPathName();
+        return true;
+    }
+
+    /** Object path of the class a Blueprint asset derives from, read from its registry tags */
+    static FString GetParentClassPath(const FAssetData& AssetData)
+    {
+        FString ParentClassPath;
+        if (!AssetData.GetTagValue(FBlueprintTags::ParentClassPath, ParentClassPath))
+        {
+            return FString();
+        }
+        return FPackageName::ExportTextPathToObjectPath(ParentClassPath);
+    }
+
+    /** Matches "Actor", "/Script/Engine.Actor", "BP_Base" or "BP_Base_C" against a parent class path */
+    static bool MatchesParentClass(const FString& ParentClassPath, const FString& ParentClass)
+    {
+        if (ParentClassPath.IsEmpty())
+        {
+            return false;
+        }
+        if (ParentClassPath.Equals(ParentClass, ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+
+        const FString ParentClassName = FPackageName::ObjectPathToObjectName(ParentClassPath);
+        return ParentClassName.Equals(ParentClass, ESearchCase::IgnoreCase)
+            || ParentClassName.Equals(ParentClass + TEXT("_C"), ESearchCase::IgnoreCase);
+    }
+
+    static bool MatchesTags(const FAssetData& AssetData, const TSharedPtr<FJsonObject>& Tags)
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Tag : Tags->Values)
+        {
+            FString Value;
+            if (!AssetData.GetTagValue(FName(*Tag.Key), Value))
+            {
+                return false;
+            }
+
+            // An empty or "*" value only asks for the tag to be present
+            const FString Expected = Tag.Value->AsString();
+            if (!Expected.IsEmpty() && Expected != TEXT("*") && !Value.Equals(Expected, ESearchCase::IgnoreCase))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool PathLess(const FAssetData& A, const FAssetData& B)
+    {
+        if (A.PackageName != B.PackageName)
+        {
+            return A.PackageName.LexicalLess(B.PackageName);
+        }
+        return A.AssetName.LexicalLess(B.AssetName);
+    }
+
+    static TSharedPtr<FJsonValue> AssetToJson(const FAssetData& AssetData, uint32 Fields)
+    {
+        TSharedPtr<FJsonObject> AssetObject = MakeShared<FJsonObject>();
+        if (Fields & Field_Name)
+        {
+            AssetObject->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
+        }
+        if (Fields & Field_Path)
+        {
+            AssetObject->SetStringField(TEXT("path"), AssetData.GetObjectPathString());
+        }
+        if (Fields & Field_Package)
+        {
+            AssetObject->SetStringField(TEXT("package"), AssetData.PackageName.ToString());
+        }
+        if (Fields & Field_PackagePath)
+        {
+            AssetObject->SetStringField(TEXT("package_path"), AssetData.PackagePath.ToString());
+        }
+        if (Fields & Field_Class)
+        {
+            AssetObject->SetStringField(TEXT("class"), AssetData.AssetClassPath.GetAssetName().ToString());
+        }
+        if (Fields & Field_ParentClass)
+        {
+            const FString ParentClassPath = GetParentClassPath(AssetData);
+            if (!ParentClassPath.IsEmpty())
+            {
+                AssetObject->SetStringField(TEXT("parent_class"), FPackageName::ObjectPathToObjectName(ParentClassPath));
+                AssetObject->SetStringField(TEXT("parent_class_path"), ParentClassPath);
+            }
+        }
+        if (Fields & Field_Tags)
+        {
+            TSharedPtr<FJsonObject> TagsObject = MakeShared<FJsonObject>();
+            AssetData.EnumerateTags([&TagsObject](TPair<FName, FAssetTagValueRef> Tag)
+            {
+                TagsObject->SetStringField(Tag.Key.ToString(), Tag.Value.AsString());
+            });
+            AssetObject->SetObjectField(TEXT("tags"), TagsObject);
+        }
+        return MakeShared<FJsonValueObject>(AssetObject);
+    }
+
+    /** Runs an asset query described by Params; only registry metadata is read, no package is loaded */
+    static TSharedPtr<FJsonObject> FindAssets(const TSharedPtr<FJsonObject>& Params, const FString& DefaultClass, uint32 DefaultFields)
+    {
+        uint32 Fields = DefaultFields;
+        FString FieldError;
+        if (!ParseFields(Params, DefaultFields, Fields, FieldError))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FieldError);
+        }
+
+        FARFilter Filter;
+        Filter.bRecursivePaths = true;
+        Filter.bRecursiveClasses = true;
+        Params->TryGetBoolField(TEXT("recursive_paths"), Filter.bRecursivePaths);
+        Params->TryGetBoolField(TEXT("recursive_classes"), Filter.bRecursiveClasses);
+
+        FString ClassName = DefaultClass;
+        Params->TryGetStringField(TEXT("class"), ClassName);
+        if (!ClassName.IsEmpty())
+        {
+            FTopLevelAssetPath ClassPath;
+            if (!ResolveClassPath(ClassName, ClassPath))
+            {
+                return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown asset class: %s.%s"),
+                    *ClassName, *FUnrealMCPCommonUtils::GetClassSuggestionText(ClassName)));
+            }
+            Filter.ClassPaths.Add(ClassPath);
+        }
+
+        // Path prefixes: a single string or an array of them
+        const TArray<TSharedPtr<FJsonValue>>* PathArray = nullptr;
+        FString PackagePath;
+        if (Params->TryGetArrayField(TEXT("path"), PathArray))
+        {
+            for (const TSharedPtr<FJsonValue>& PathValue : *PathArray)
+            {
+                Filter.PackagePaths.Add(FName(*PathValue->AsString()));
+            }
+        }
+        else if (Params->TryGetStringField(TEXT("path"), PackagePath))
+        {
+            Filter.PackagePaths.Add(FName(*PackagePath));
+        }
+
+        // The registry returns nothing for an empty filter, so a query by name, parent class or tags alone
+        // starts from every asset it knows
+        TArray<FAssetData> Assets;
+        if (Filter.IsEmpty())
+        {
+            IAssetRegistry::GetChecked().GetAllAssets(Assets);
+        }
+        else
+        {
+            IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+        }
+
+        // Filters the registry can't express are applied to the metadata it returned
+        FString NameFilter;
+        Params->TryGetStringField(TEXT("name"), NameFilter);
+
+        FString ParentClass;
+        Params->TryGetStringField(TEXT("parent_class"), ParentClass);
+
+        const TSharedPtr<FJsonObject>* TagFilter = nullptr;
+        Params->TryGetObjectField(TEXT("tags"), TagFilter);
+
+        if (!NameFilter.IsEmpty() || !ParentClass.IsEmpty() || TagFilter)
+        {
+            Assets.RemoveAllSwap([&NameFilter, &ParentClass, TagFilter](const FAssetData& AssetData)
+            {
+                if (!NameFilter.IsEmpty() && !AssetData.AssetName.ToString().Contains(NameFilter))
+                {
+                    return true;
+                }
+                if (!ParentClass.IsEmpty() && !MatchesParentClass(GetParentClassPath(AssetData), ParentClass))
+                {
+                    return true;
+                }
+                return TagFilter && !MatchesTags(AssetData, *TagFilter);
+            }, EAllowShrinking::No);
+        }
+
+        // Order by object path so a cursor stays valid while assets are added and removed
+        Assets.Sort(&PathLess);
+
+        int32 Offset = 0;
+        Params->TryGetNumberField(TEXT("offset"), Offset);
+        Offset = FMath::Max(Offset, 0);
+
+        // New commands, so unlike get_actors_in_level they page by default; limit 0 returns everything
+        int32 Limit = 1000;
+        Params->TryGetNumberField(TEXT("limit"), Limit);
+
+        int32 Start = 0;
+        FString Cursor;
+        if (Params->TryGetStringField(TEXT("cursor"), Cursor) && !Cursor.IsEmpty())
+        {
+            const FSoftObjectPath CursorPath(Cursor);
+            FAssetData CursorAsset;
+            CursorAsset.PackageName = CursorPath.GetLongPackageFName();
+            CursorAsset.AssetName = CursorPath.GetAssetFName();
+            Start = Algo::UpperBound(Assets, CursorAsset, &PathLess);
+        }
+        Start = FMath::Min(Start + Offset, Assets.Num());
+
+        const int32 End = Limit > 0 ? FMath::Min(Start + Limit, Assets.Num()) : Assets.Num();
+
+        TArray<TSharedPtr<FJsonValue>> AssetArray;
+        AssetArray.Reserve(End - Start);
+        for (int32 Index = Start; Index < End; ++Index)
+        {
+            AssetArray.Add(AssetToJson(Assets[Index], Fields));
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetArrayField(TEXT("assets"), AssetArray);
+        ResultObj->SetNumberField(TEXT("total"), Assets.Num());
+        ResultObj->SetNumberField(TEXT("start"), Start);
+        if (End < Assets.Num())
+        {
+            ResultObj->SetStringField(TEXT("next_cursor"), Assets[End - 1].GetObjectPathString());
+        }
+        if (IAssetRegistry::GetChecked().IsLoadingAssets())
+        {
+            // The registry is still scanning the project, so results may be incomplete
+            ResultObj->SetBoolField(TEXT("partial"), true);
+        }
+        return ResultObj;
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleFindAssets(const TSharedPtr<FJsonObject>& Params)
+{
+    return UnrealMCPAssetQuery::FindAssets(Params, FString(), UnrealMCPAssetQuery::Field_Default);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleListBlueprints(const TSharedPtr<FJsonObject>& Params)
+{
+    using namespace UnrealMCPAssetQuery;
+
+    // Every Blueprint type (actor, widget, animation, ...) unless a narrower class is asked for
+    return FindAssets(Params, UBlueprint::StaticClass()->GetPathName(), Field_Default | Field_ParentClass);
+}
@@ -1,4 +1,5 @@
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Editor.h"
 #include "EditorAssetLibrary.h"
@@ -30,34 +31,14 @@ FUnrealMCPUMGCommands::FUnrealMCPUMGCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCommand(const FString& CommandName, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPUMGCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-	if (CommandName == TEXT("create_umg_widget_blueprint"))
-	{
-		return HandleCreateUMGWidgetBlueprint(Params);
-	}
-	else if (CommandName == TEXT("add_text_block_to_widget"))
-	{
-		return HandleAddTextBlockToWidget(Params);
-	}
-	else if (CommandName == TEXT("add_widget_to_viewport"))
-	{
-		return HandleAddWidgetToViewport(Params);
-	}
-	else if (CommandName == TEXT("add_button_to_widget"))
-	{
-		return HandleAddButtonToWidget(Params);
-	}
-	else if (CommandName == TEXT("bind_widget_event"))
-	{
-		return HandleBindWidgetEvent(Params);
-	}
-	else if (CommandName == TEXT("set_text_block_binding"))
-	{
-		return HandleSetTextBlockBinding(Params);
-	}
-
-	return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown UMG command: %s"), *CommandName));
+	Registry.Register(TEXT("create_umg_widget_blueprint"), TEXT("umg"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint));
+	Registry.Register(TEXT("add_text_block_to_widget"), TEXT("umg"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleAddTextBlockToWidget));
+	Registry.Register(TEXT("add_widget_to_viewport"), TEXT("umg"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleAddWidgetToViewport));
+	Registry.Register(TEXT("add_button_to_widget"), TEXT("umg"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleAddButtonToWidget));
+	Registry.Register(TEXT("bind_widget_event"), TEXT("umg"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleBindWidgetEvent));
+	Registry.Register(TEXT("set_text_block_binding"), TEXT("umg"), FUnrealMCPCommandHandler::CreateRaw(this, &FUnrealMCPUMGCommands::HandleSetTextBlockBinding));
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -116,8 +97,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(co
 	Package->MarkPackageDirty();
 	FAssetRegistryModule::AssetCreated(WidgetBlueprint);
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	// Queue the blueprint for compilation
+	FUnrealMCPCommonUtils::MarkBlueprintForCompile(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -142,8 +123,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 	}
 
 	// Find the Widget Blueprint
-	FString FullPath = TEXT("/Game/Widgets/") + BlueprintName;
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(FullPath));
+	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(FUnrealMCPCommonUtils::FindWidgetBlueprint(BlueprintName));
 	if (!WidgetBlueprint)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Widget Blueprint '%s' not found"), *BlueprintName));
@@ -181,12 +161,14 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 		return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Root Canvas Panel not found"));
 	}
 
+	WidgetBlueprint->WidgetTree->Modify();
+	RootCanvas->Modify();
 	UCanvasPanelSlot* PanelSlot = RootCanvas->AddChildToCanvas(TextBlock);
 	PanelSlot->SetPosition(Position);
 
-	// Mark the package dirty and compile
+	// Mark the package dirty and queue the blueprint for compilation
 	WidgetBlueprint->MarkPackageDirty();
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCommonUtils::MarkBlueprintForCompile(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -205,8 +187,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddWidgetToViewport(const T
 	}
 
 	// Find the Widget Blueprint
-	FString FullPath = TEXT("/Game/Widgets/") + BlueprintName;
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(FullPath));
+	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(FUnrealMCPCommonUtils::FindWidgetBlueprint(BlueprintName));
 	if (!WidgetBlueprint)
 	{
 		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Widget Blueprint '%s' not found"), *BlueprintName));
@@ -216,7 +197,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddWidgetToViewport(const T
 	int32 ZOrder = 0;
 	Params->TryGetNumberField(TEXT("z_order"), ZOrder);
 
-	// Create widget instance
+	// Create widget instance from the up-to-date generated class
+	FUnrealMCPCommonUtils::FlushBlueprintCompile(WidgetBlueprint);
 	UClass* WidgetClass = WidgetBlueprint->GeneratedClass;
 	if (!WidgetClass)
 	{
@@ -263,11 +245,10 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 	}
 
 	// Load the Widget Blueprint
-	const FString BlueprintPath = FString::Printf(TEXT("/Game/Widgets/%s.%s"), *BlueprintName, *BlueprintName);
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(BlueprintPath));
+	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(FUnrealMCPCommonUtils::FindWidgetBlueprint(BlueprintName));
 	if (!WidgetBlueprint)
 	{
-		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintPath));
+		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintName));
 		return Response;
 	}
 
@@ -296,6 +277,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 	}
 
 	// Add to canvas and set position
+	WidgetBlueprint->WidgetTree->Modify();
+	RootCanvas->Modify();
 	UCanvasPanelSlot* ButtonSlot = RootCanvas->AddChildToCanvas(Button);
 	if (ButtonSlot)
 	{
@@ -310,9 +293,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 		}
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Queue the Widget Blueprint for compilation; it is saved once that compile has run
+	FUnrealMCPCommonUtils::MarkBlueprintForCompile(WidgetBlueprint, true);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("widget_name"), WidgetName);
@@ -346,11 +328,10 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 	}
 
 	// Load the Widget Blueprint
-	const FString BlueprintPath = FString::Printf(TEXT("/Game/Widgets/%s.%s"), *BlueprintName, *BlueprintName);
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(BlueprintPath));
+	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(FUnrealMCPCommonUtils::FindWidgetBlueprint(BlueprintName));
 	if (!WidgetBlueprint)
 	{
-		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintPath));
+		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintName));
 		return Response;
 	}
 
@@ -398,6 +379,10 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 		
 		const FVector2D NodePos(200, MaxHeight + 200);
 
+		// Record the Blueprint and its event graph for undo before the bound event is added
+		WidgetBlueprint->Modify();
+		EventGraph->Modify();
+
 		// Call CreateNewBoundEventForClass, which returns void, so we can't capture the return value directly
 		// We'll need to find the node after creating it
 		FKismetEditorUtilities::CreateNewBoundEventForClass(
@@ -432,9 +417,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 		return Response;
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Queue the Widget Blueprint for compilation; it is saved once that compile has run
+	FUnrealMCPCommonUtils::MarkBlueprintForCompile(WidgetBlueprint, true);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("event_name"), EventName);
@@ -468,14 +452,16 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 	}
 
 	// Load the Widget Blueprint
-	const FString BlueprintPath = FString::Printf(TEXT("/Game/Widgets/%s.%s"), *BlueprintName, *BlueprintName);
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(BlueprintPath));
+	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(FUnrealMCPCommonUtils::FindWidgetBlueprint(BlueprintName));
 	if (!WidgetBlueprint)
 	{
-		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintPath));
+		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintName));
 		return Response;
 	}
 
+	// Record the Blueprint for undo before its variables and function graphs change
+	WidgetBlueprint->Modify();
+
 	// Create a variable for binding if it doesn't exist
 	FBlueprintEditorUtils::AddMemberVariable(
 		WidgetBlueprint,
@@ -505,6 +491,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		// Add the function to the blueprint with proper template parameter
 		// Template requires null for last parameter when not using a signature-source
 		FBlueprintEditorUtils::AddFunctionGraph<UClass>(WidgetBlueprint, FuncGraph, false, nullptr);
+		FuncGraph->Modify();
 
 		// Create entry node
 		UK2Node_FunctionEntry* EntryNode = nullptr;
@@ -534,9 +521,8 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		}
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Queue the Widget Blueprint for compilation; it is saved once that compile has run
+	FUnrealMCPCommonUtils::MarkBlueprintForCompile(WidgetBlueprint, true);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("binding_name"), BindingName);
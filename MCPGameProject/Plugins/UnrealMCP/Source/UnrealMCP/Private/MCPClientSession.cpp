@@ -0,0 +1,585 @@
+#include "MCPClientSession.h"
+#include "UnrealMCPLog.h"
+#include "MCPProtocol.h"
+#include "MCPReceiveBuffer.h"
+#include "UnrealMCPBridge.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/RunnableThread.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+
+// Free space guaranteed to each read
+static const int32 BufferSize = 8192;
+
+// Largest single write; matches the socket send buffer configured by FMCPServerRunnable
+static const int32 MaxSendChunkSize = 65536;
+
+// How long a response write may wait for a client that is not reading
+static const FTimespan SendStallTimeout = FTimespan::FromSeconds(30.0);
+
+// Send buffers grown beyond this by a large response are released afterwards
+static const int32 MaxRetainedSendBufferSize = 4 * 1024 * 1024;
+
+FMCPClientSession::FMCPClientSession(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InSocket, int32 InSessionId)
+    : Bridge(InBridge)
+    , Socket(InSocket)
+    , Writer(MakeShared<FResponseWriter, ESPMode::ThreadSafe>(InSocket, InBridge->GetServerStats(), InBridge->GetTraceRecorder()))
+    , Thread(nullptr)
+    , SessionId(InSessionId)
+    , bRunning(true)
+    , bFinished(false)
+    , MessageStartCycles(0)
+    , LastReceiveCycles(0)
+{
+}
+
+FMCPClientSession::~FMCPClientSession()
+{
+    if (Thread)
+    {
+        // Kill calls Stop() and waits for the read loop to exit
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+}
+
+bool FMCPClientSession::Start()
+{
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UnrealMCPSession%d"), SessionId), 0, TPri_Normal);
+    if (!Thread)
+    {
+        bFinished = true;
+        return false;
+    }
+    return true;
+}
+
+void FMCPClientSession::Stop()
+{
+    bRunning = false;
+    
+    // Wakes a Recv blocked in the read loop
+    Socket->Shutdown(ESocketShutdownMode::ReadWrite);
+}
+
+uint32 FMCPClientSession::Run()
+{
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession: Session %d started"), SessionId);
+    
+    FMCPReceiveBuffer ReceiveBuffer;
+    EMessageFraming Framing = EMessageFraming::Unknown;
+    
+    while (bRunning)
+    {
+        // Receive straight into the connection's buffer, after the bytes still pending
+        int32 FreeSize = 0;
+        uint8* Buffer = ReceiveBuffer.PrepareWrite(BufferSize, FreeSize);
+        
+        int32 BytesRead = 0;
+        // Blocking read: the thread sleeps in the kernel until data arrives or Stop() shuts the socket down
+        if (!Socket->Recv(Buffer, FreeSize, BytesRead))
+        {
+            int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
+            
+            // Interrupted system call
+            if (LastError == SE_EINTR)
+            {
+                continue;
+            }
+            
+            UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession: Client disconnected or error. Last error code: %d"), LastError);
+            break;
+        }
+        
+        if (BytesRead == 0)
+        {
+            UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession: Client disconnected (zero bytes)"));
+            break;
+        }
+        
+        // A message starts with this read unless earlier reads left part of one pending
+        LastReceiveCycles = FPlatformTime::Cycles64();
+        if (ReceiveBuffer.Num() == 0)
+        {
+            MessageStartCycles = LastReceiveCycles;
+        }
+        
+        // A framed client announces itself with the frame magic; JSON always starts with '{' or whitespace
+        if (Framing == EMessageFraming::Unknown && ReceiveBuffer.Num() == 0 && Buffer[0] == MCPProtocol::FrameMagic0)
+        {
+            Framing = EMessageFraming::Framed;
+        }
+        
+        ReceiveBuffer.CommitWrite(BytesRead);
+        
+        if (!ProcessReceivedData(ReceiveBuffer, Framing))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession: Protocol error, closing client connection"));
+            break;
+        }
+    }
+    
+    UE_LOG(LogUnrealMCP, Display, TEXT("MCPClientSession: Session %d finished"), SessionId);
+    bFinished = true;
+    return 0;
+}
+
+bool FMCPClientSession::ProcessReceivedData(FMCPReceiveBuffer& ReceiveBuffer, EMessageFraming& Framing)
+{
+    if (Framing == EMessageFraming::Framed)
+    {
+        // Each frame is a fixed-size header followed by exactly PayloadSize bytes,
+        // so a payload is parsed once, as soon as its last byte has arrived.
+        while (ReceiveBuffer.Num() >= MCPProtocol::FrameHeaderSize)
+        {
+            MCPProtocol::FFrameHeader Header;
+            if (!MCPProtocol::ReadFrameHeader(ReceiveBuffer.GetData(), Header))
+            {
+                SendResponse(TEXT("{\"status\":\"error\",\"error\":\"Invalid frame header\"}"), Framing);
+                return false;
+            }
+            if (Header.Version != MCPProtocol::FrameVersion)
+            {
+                SendResponse(FString::Printf(TEXT("{\"status\":\"error\",\"error\":\"Unsupported protocol version %d\"}"), Header.Version), Framing);
+                return false;
+            }
+            if (Header.PayloadSize > MCPProtocol::MaxPayloadSize || Header.Encoding != MCPProtocol::EMCPPayloadEncoding::Json)
+            {
+                SendResponse(TEXT("{\"status\":\"error\",\"error\":\"Unsupported frame size or encoding\"}"), Framing);
+                return false;
+            }
+            
+            const int32 FrameSize = MCPProtocol::FrameHeaderSize + (int32)Header.PayloadSize;
+            if (ReceiveBuffer.Num() < FrameSize)
+            {
+                // Grow once to the full frame instead of once per received chunk
+                ReceiveBuffer.Reserve(FrameSize);
+                break;
+            }
+            
+            TSharedPtr<FJsonObject> JsonMessage;
+            if (ParseMessage(ReceiveBuffer.GetData() + MCPProtocol::FrameHeaderSize, Header.PayloadSize, JsonMessage))
+            {
+                ProcessMessage(JsonMessage, Framing);
+            }
+            else
+            {
+                SendResponse(TEXT("{\"status\":\"error\",\"error\":\"Invalid JSON message\"}"), Framing);
+            }
+            ReceiveBuffer.Consume(FrameSize);
+        }
+    }
+    else if (ReceiveBuffer.Num() > 0)
+    {
+        // Legacy clients send a single JSON object without a terminator and wait for
+        // the reply, so answer as soon as the buffered text parses. Pretty-printed
+        // legacy messages may contain newlines, which is why this is tried first.
+        // Parsing is only attempted once the brackets of the object balance. Until the
+        // framing is known, this may also catch a newline client's first message split
+        // right after its closing bracket; the reply ends with '\n' either way, and the
+        // newline that follows later is skipped as a blank line.
+        if (Framing != EMessageFraming::Newline && ReceiveBuffer.GetData()[ReceiveBuffer.Num() - 1] != '\n' &&
+            ReceiveBuffer.FindObjectEnd() != INDEX_NONE)
+        {
+            TSharedPtr<FJsonObject> JsonMessage;
+            if (ParseMessage(ReceiveBuffer.GetData(), ReceiveBuffer.Num(), JsonMessage))
+            {
+                Framing = EMessageFraming::Legacy;
+                ReceiveBuffer.Consume(ReceiveBuffer.Num());
+                ProcessMessage(JsonMessage, Framing);
+                return true;
+            }
+        }
+        
+        // Process every complete newline-terminated message
+        int32 LineLength = INDEX_NONE;
+        while ((LineLength = ReceiveBuffer.FindNewline()) != INDEX_NONE)
+        {
+            // Once a client has sent a newline-terminated message it is treated as a
+            // keep-alive client for the rest of the connection, so a message whose
+            // terminator arrives in a later packet is never mistaken for a legacy one.
+            Framing = EMessageFraming::Newline;
+            
+            // The line stays valid until the next write; nothing is received while it is processed
+            const uint8* LineStart = ReceiveBuffer.GetData();
+            ReceiveBuffer.Consume(LineLength + 1);
+            
+            bool bBlank = true;
+            for (int32 CharIndex = 0; CharIndex < LineLength && bBlank; ++CharIndex)
+            {
+                bBlank = FChar::IsWhitespace((TCHAR)LineStart[CharIndex]);
+            }
+            if (bBlank)
+            {
+                continue;
+            }
+            
+            TSharedPtr<FJsonObject> JsonMessage;
+            if (ParseMessage(LineStart, LineLength, JsonMessage))
+            {
+                ProcessMessage(JsonMessage, Framing);
+            }
+            else
+            {
+                SendResponse(TEXT("{\"status\":\"error\",\"error\":\"Invalid JSON message\"}"), Framing);
+            }
+        }
+        
+        // Framed payloads are capped by their header; an unterminated message must not grow the buffer without bound
+        if (ReceiveBuffer.Num() > (int32)MCPProtocol::MaxPayloadSize)
+        {
+            SendResponse(FString::Printf(TEXT("{\"status\":\"error\",\"error\":\"Message exceeds %u bytes\"}"), MCPProtocol::MaxPayloadSize), Framing);
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool FMCPClientSession::ParseMessage(const uint8* Data, int32 Size, TSharedPtr<FJsonObject>& OutJsonMessage)
+{
+    // The message was complete after the latest read; any message after it has started by then
+    MessageTiming = FUnrealMCPCommandTiming();
+    MessageTiming.FirstByte = MessageStartCycles;
+    MessageTiming.Received = LastReceiveCycles;
+    MessageStartCycles = LastReceiveCycles;
+    
+    // The reader works on the received UTF-8 bytes in place; only strings in the message are converted
+    const FUtf8StringView Message(reinterpret_cast<const UTF8CHAR*>(Data), Size);
+    TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(Message);
+    if (!FJsonSerializer::Deserialize(Reader, OutJsonMessage) || !OutJsonMessage.IsValid())
+    {
+        return false;
+    }
+    
+    UnrealMCPLog::LogPayload(UnrealMCPLog::EPayloadDirection::Received, Data, Size);
+    return true;
+}
+
+void FMCPClientSession::ProcessMessage(const TSharedPtr<FJsonObject>& JsonMessage, EMessageFraming Framing)
+{
+    // An optional request id marks a pipelined request; null is treated as no id
+    TSharedPtr<FJsonValue> RequestId = JsonMessage->TryGetField(TEXT("id"));
+    if (RequestId.IsValid() && RequestId->IsNull())
+    {
+        RequestId.Reset();
+    }
+    
+    // Extract command type; "type" is used by the Python client, "command" by the MCP protocol docs
+    FString CommandType;
+    if (!JsonMessage->TryGetStringField(TEXT("type"), CommandType) &&
+        !JsonMessage->TryGetStringField(TEXT("command"), CommandType))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession: Missing 'type' field in command"));
+        
+        TSharedPtr<FJsonObject> ErrorJson = MakeShareable(new FJsonObject);
+        ErrorJson->SetStringField(TEXT("status"), TEXT("error"));
+        ErrorJson->SetStringField(TEXT("error"), TEXT("Missing 'type' field in command"));
+        if (RequestId.IsValid())
+        {
+            ErrorJson->SetField(TEXT("id"), RequestId);
+        }
+        
+        Writer->SendResponse(ErrorJson, Framing, GetResponseEncoding(JsonMessage, Framing));
+        return;
+    }
+    
+    // Parameters are optional
+    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (JsonMessage->TryGetObjectField(TEXT("params"), ParamsObject))
+    {
+        Params = *ParamsObject;
+    }
+    
+    const MCPProtocol::EMCPPayloadEncoding Encoding = GetResponseEncoding(JsonMessage, Framing);
+    
+    // The parameters are only re-serialized while a trace is being recorded
+    TSharedPtr<FUnrealMCPTraceRecord> TraceRecord;
+    TSharedPtr<FUnrealMCPTraceRecorder, ESPMode::ThreadSafe> TraceRecorder = Bridge->GetTraceRecorder();
+    if (TraceRecorder.IsValid() && TraceRecorder->IsRecording())
+    {
+        TraceRecord = MakeShared<FUnrealMCPTraceRecord>();
+        TraceRecord->ConnectionId = SessionId;
+        TraceRecord->Command = CommandType;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> ParamsWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&TraceRecord->Params);
+        FJsonSerializer::Serialize(Params.ToSharedRef(), ParamsWriter);
+    }
+    
+    if (RequestId.IsValid())
+    {
+        // Keep reading while the command runs; the writer outlives the session if the client goes away first.
+        // The response completes on the game thread, which only queues it: encoding and sending happen off it.
+        TSharedRef<FResponseWriter, ESPMode::ThreadSafe> ResponseWriter = Writer;
+        Bridge->ExecuteCommandAsync(CommandType, Params, RequestId, Encoding, MessageTiming, [ResponseWriter, Framing, Encoding, TraceRecord](FUnrealMCPResponse&& Response)
+        {
+            ResponseWriter->QueueResponse(MoveTemp(Response), Framing, Encoding, TraceRecord);
+        });
+        return;
+    }
+    
+    // Execute command; unless it was streamed, the response is encoded here, on the session thread
+    FUnrealMCPResponse Response = Bridge->ExecuteCommand(CommandType, Params, Encoding, MessageTiming);
+    Writer->SendResponse(Response, Framing, Encoding, TraceRecord.Get());
+}
+
+MCPProtocol::EMCPPayloadEncoding FMCPClientSession::GetResponseEncoding(const TSharedPtr<FJsonObject>& JsonMessage, EMessageFraming Framing) const
+{
+    FString EncodingName;
+    if (Framing != EMessageFraming::Framed || !JsonMessage->TryGetStringField(TEXT("encoding"), EncodingName))
+    {
+        return MCPProtocol::EMCPPayloadEncoding::Json;
+    }
+    
+    // Unknown encodings fall back to JSON; the frame header tells the client what it got
+    MCPProtocol::EMCPPayloadEncoding Encoding = MCPProtocol::EMCPPayloadEncoding::Json;
+    if (!MCPProtocol::LexTryParseEncoding(EncodingName, Encoding))
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession: Unknown response encoding '%s', using JSON"), *EncodingName);
+    }
+    return Encoding;
+}
+
+void FMCPClientSession::SendResponse(const FString& Response, EMessageFraming Framing)
+{
+    Writer->SendResponse(Response, Framing);
+}
+
+/** A response waiting in the send queue */
+struct FMCPClientSession::FResponseWriter::FQueuedResponse
+{
+    FUnrealMCPResponse Response;
+    EMessageFraming Framing;
+    MCPProtocol::EMCPPayloadEncoding Encoding;
+    TSharedPtr<FUnrealMCPTraceRecord> TraceRecord;
+};
+
+FMCPClientSession::FResponseWriter::FResponseWriter(TSharedPtr<FSocket> InSocket, TSharedPtr<FUnrealMCPServerStats, ESPMode::ThreadSafe> InStats, TSharedPtr<FUnrealMCPTraceRecorder, ESPMode::ThreadSafe> InTraceRecorder)
+    : Socket(InSocket)
+    , Stats(InStats)
+    , TraceRecorder(InTraceRecorder)
+    , bBroken(false)
+    , QueuedResponses(0)
+{
+}
+
+FMCPClientSession::FResponseWriter::~FResponseWriter()
+{
+}
+
+void FMCPClientSession::FResponseWriter::QueueResponse(FUnrealMCPResponse&& Response, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, TSharedPtr<FUnrealMCPTraceRecord> TraceRecord)
+{
+    SendQueue.Enqueue(MakeUnique<FQueuedResponse>(FQueuedResponse{ MoveTemp(Response), Framing, Encoding, MoveTemp(TraceRecord) }));
+    
+    // A drain task already running picks the response up; the task holds the writer until the queue is empty
+    if (QueuedResponses.fetch_add(1) == 0)
+    {
+        Async(EAsyncExecution::ThreadPool, [Self = AsShared()]()
+        {
+            Self->DrainQueue();
+        });
+    }
+}
+
+void FMCPClientSession::FResponseWriter::DrainQueue()
+{
+    // Every response counted in QueuedResponses was enqueued before it was counted
+    do
+    {
+        TUniquePtr<FQueuedResponse> Queued;
+        if (SendQueue.Dequeue(Queued))
+        {
+            SendResponse(Queued->Response, Queued->Framing, Queued->Encoding, Queued->TraceRecord.Get());
+        }
+    }
+    while (QueuedResponses.fetch_sub(1) > 1);
+}
+
+void FMCPClientSession::FResponseWriter::SendResponse(const FString& Response, EMessageFraming Framing)
+{
+    UnrealMCPLog::LogPayload(UnrealMCPLog::EPayloadDirection::Sent, Response);
+    
+    FScopeLock Lock(&SendLock);
+    BeginMessage(Framing);
+    
+    // Convert straight into the send buffer; the UTF-8 byte count, not Response.Len(), sizes the payload
+    const int32 Utf8Length = FPlatformString::ConvertedLength<UTF8CHAR>(*Response, Response.Len());
+    const int32 Offset = SendBuffer.AddUninitialized(Utf8Length);
+    FPlatformString::Convert(reinterpret_cast<UTF8CHAR*>(SendBuffer.GetData() + Offset), Utf8Length, *Response, Response.Len());
+    
+    FinishMessage(Framing, MCPProtocol::EMCPPayloadEncoding::Json);
+}
+
+int32 FMCPClientSession::FResponseWriter::SendResponse(const TSharedPtr<FJsonObject>& Response, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPCommandTiming* Timing)
+{
+    if (Framing != EMessageFraming::Framed)
+    {
+        Encoding = MCPProtocol::EMCPPayloadEncoding::Json;
+    }
+    
+    FScopeLock Lock(&SendLock);
+    BeginMessage(Framing);
+    
+    // Encoded once, in place after the header
+    const int32 PayloadOffset = SendBuffer.Num();
+    MCPProtocol::EncodePayload(Response.ToSharedRef(), Encoding, SendBuffer);
+    const int32 PayloadSize = SendBuffer.Num() - PayloadOffset;
+    
+    if (Encoding == MCPProtocol::EMCPPayloadEncoding::Json)
+    {
+        UnrealMCPLog::LogPayload(UnrealMCPLog::EPayloadDirection::Sent, SendBuffer.GetData() + PayloadOffset, PayloadSize);
+    }
+    else
+    {
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientSession: Sending CBOR response, bytes: %d"), PayloadSize);
+    }
+    
+    FinishMessage(Framing, Encoding, Timing);
+    return PayloadSize;
+}
+
+void FMCPClientSession::FResponseWriter::SendResponse(const FUnrealMCPResponse& Response, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPTraceRecord* TraceRecord)
+{
+    FUnrealMCPCommandTiming Timing = Response.Timing;
+    
+    // Streaming handlers only produce a payload when they succeed
+    bool bSucceeded = true;
+    int32 PayloadSize = Response.Payload.Num();
+    if (Response.Object.IsValid())
+    {
+        FString Status;
+        bSucceeded = Response.Object->TryGetStringField(TEXT("status"), Status) && Status == TEXT("success");
+        PayloadSize = SendResponse(Response.Object, Framing, Encoding, &Timing);
+    }
+    else
+    {
+        if (Response.Encoding == MCPProtocol::EMCPPayloadEncoding::Json)
+        {
+            UnrealMCPLog::LogPayload(UnrealMCPLog::EPayloadDirection::Sent, Response.Payload.GetData(), Response.Payload.Num());
+        }
+        else
+        {
+            UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientSession: Sending streamed CBOR response, bytes: %d"), Response.Payload.Num());
+        }
+        SendPayload(Response.Payload.GetData(), Response.Payload.Num(), Framing, Response.Encoding, &Timing);
+    }
+    
+    if (Stats.IsValid())
+    {
+        Stats->Record(Response.Command, Timing, bSucceeded);
+    }
+    
+    if (TraceRecord && TraceRecorder.IsValid())
+    {
+        TraceRecord->ResponseSize = (uint32)PayloadSize;
+        TraceRecord->bSucceeded = bSucceeded;
+        TraceRecorder->Record(*TraceRecord, Timing);
+    }
+}
+
+void FMCPClientSession::FResponseWriter::SendPayload(const uint8* Payload, int32 PayloadSize, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPCommandTiming* Timing)
+{
+    FScopeLock Lock(&SendLock);
+    BeginMessage(Framing);
+    SendBuffer.Append(Payload, PayloadSize);
+    FinishMessage(Framing, Encoding, Timing);
+}
+
+void FMCPClientSession::FResponseWriter::BeginMessage(EMessageFraming Framing)
+{
+    SendBuffer.Reset();
+    if (Framing == EMessageFraming::Framed)
+    {
+        SendBuffer.AddUninitialized(MCPProtocol::FrameHeaderSize);
+    }
+}
+
+void FMCPClientSession::FResponseWriter::FinishMessage(EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPCommandTiming* Timing)
+{
+    if (Timing)
+    {
+        Timing->Serialized = FPlatformTime::Cycles64();
+    }
+    
+    if (Framing == EMessageFraming::Framed)
+    {
+        uint8 Header[MCPProtocol::FrameHeaderSize];
+        MCPProtocol::WriteFrameHeader(Header, (uint32)(SendBuffer.Num() - MCPProtocol::FrameHeaderSize), Encoding);
+        FMemory::Memcpy(SendBuffer.GetData(), Header, MCPProtocol::FrameHeaderSize);
+    }
+    
+    // Keep-alive clients read up to the newline terminator; legacy clients parse whatever they read
+    // before the connection closes, which tolerates the trailing whitespace
+    if (Framing == EMessageFraming::Newline || Framing == EMessageFraming::Legacy)
+    {
+        SendBuffer.Add('\n');
+    }
+    
+    // The session thread and the drain task may both send, so sends are serialized by SendLock
+    if (bBroken)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession: Dropping response of %d bytes, the connection is broken"), SendBuffer.Num());
+    }
+    else if (SendAll(SendBuffer.GetData(), SendBuffer.Num()))
+    {
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("MCPClientSession: Response sent successfully, bytes: %d"), SendBuffer.Num());
+        if (Timing)
+        {
+            Timing->Sent = FPlatformTime::Cycles64();
+        }
+    }
+    else
+    {
+        // A partly written message would desynchronize the client, so close the connection instead;
+        // the client sees a disconnect and can reconnect rather than waiting for a reply that never comes
+        bBroken = true;
+        Socket->Shutdown(ESocketShutdownMode::ReadWrite);
+    }
+    
+    // Keep the buffer for the next message unless a large response grew it
+    if (SendBuffer.Max() > MaxRetainedSendBufferSize)
+    {
+        SendBuffer.Empty();
+    }
+}
+
+bool FMCPClientSession::FResponseWriter::SendAll(const uint8* Data, int32 Size)
+{
+    int32 TotalSent = 0;
+    while (TotalSent < Size)
+    {
+        // Wait until the client has drained enough of the socket buffer, but not forever: a client
+        // that stopped reading must not hold the session thread or a thread-pool worker indefinitely
+        if (!Socket->Wait(ESocketWaitConditions::WaitForWrite, SendStallTimeout))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession: Client stopped reading, sent %d of %d bytes"), TotalSent, Size);
+            return false;
+        }
+        
+        // Chunks no larger than the socket buffer, so a write that has waited for space doesn't block again for long
+        int32 BytesSent = 0;
+        const int32 ChunkSize = FMath::Min(Size - TotalSent, MaxSendChunkSize);
+        if (!Socket->Send(Data + TotalSent, ChunkSize, BytesSent))
+        {
+            const ESocketErrors LastError = ISocketSubsystem::Get()->GetLastErrorCode();
+            if (LastError == SE_EINTR || LastError == SE_EWOULDBLOCK)
+            {
+                continue;
+            }
+            
+            UE_LOG(LogUnrealMCP, Warning, TEXT("MCPClientSession: Failed to send response, sent %d of %d bytes. Last error code: %d"), TotalSent, Size, (int32)LastError);
+            return false;
+        }
+        
+        // A partial write is normal for large responses; send the rest
+        TotalSent += BytesSent;
+    }
+    return true;
+}
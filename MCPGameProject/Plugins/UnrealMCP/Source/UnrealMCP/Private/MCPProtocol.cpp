@@ -0,0 +1,30 @@
+#include "MCPProtocol.h"
+#include "UnrealMCPResponseWriter.h"
+#include "Dom/JsonObject.h"
+
+namespace MCPProtocol
+{
+    bool LexTryParseEncoding(const FString& Name, EMCPPayloadEncoding& OutEncoding)
+    {
+        if (Name.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+        {
+            OutEncoding = EMCPPayloadEncoding::Json;
+            return true;
+        }
+        if (Name.Equals(TEXT("cbor"), ESearchCase::IgnoreCase))
+        {
+            OutEncoding = EMCPPayloadEncoding::Cbor;
+            return true;
+        }
+        return false;
+    }
+
+    void EncodePayload(const TSharedRef<FJsonObject>& Message, EMCPPayloadEncoding Encoding, TArray<uint8>& OutBytes)
+    {
+        FUnrealMCPResponseWriter Writer(OutBytes, Encoding);
+        Writer.WriteObjectStart();
+        Writer.WriteJsonFields(*Message);
+        Writer.WriteObjectEnd();
+        Writer.Close();
+    }
+}
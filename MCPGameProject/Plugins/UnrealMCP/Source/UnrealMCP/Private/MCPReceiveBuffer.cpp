@@ -0,0 +1,154 @@
+#include "MCPReceiveBuffer.h"
+
+// Capacity allocated on first use, and kept when a large message has been consumed
+static const int32 InitialCapacity = 8192;
+
+// Buffers grown beyond this by a large message are released once it has been consumed
+static const int32 MaxRetainedCapacity = 4 * 1024 * 1024;
+
+FMCPReceiveBuffer::FMCPReceiveBuffer()
+    : ReadOffset(0)
+    , WriteOffset(0)
+    , NewlineScanOffset(0)
+    , ObjectScanOffset(0)
+    , ObjectEndOffset(INDEX_NONE)
+    , ObjectDepth(0)
+    , bInString(false)
+    , bEscaped(false)
+{
+}
+
+uint8* FMCPReceiveBuffer::PrepareWrite(int32 MinSize, int32& OutSize)
+{
+    // Consumed messages may still be in use until the next write, so memory is only released here
+    if (Num() == 0 && Data.Num() > MaxRetainedCapacity)
+    {
+        Data.Empty();
+    }
+    
+    if (Data.Num() - WriteOffset < MinSize)
+    {
+        Compact();
+        
+        if (Data.Num() - WriteOffset < MinSize)
+        {
+            // Double so that a large message costs a logarithmic number of copies
+            Data.SetNumUninitialized(FMath::Max3(InitialCapacity, Data.Num() * 2, WriteOffset + MinSize), EAllowShrinking::No);
+        }
+    }
+    
+    OutSize = Data.Num() - WriteOffset;
+    return Data.GetData() + WriteOffset;
+}
+
+void FMCPReceiveBuffer::CommitWrite(int32 Size)
+{
+    check(Size >= 0 && WriteOffset + Size <= Data.Num());
+    WriteOffset += Size;
+}
+
+void FMCPReceiveBuffer::Consume(int32 Size)
+{
+    check(Size >= 0 && Size <= Num());
+    ReadOffset += Size;
+    NewlineScanOffset = FMath::Max(NewlineScanOffset, ReadOffset);
+    
+    // The next object starts at the new read position
+    ObjectScanOffset = ReadOffset;
+    ObjectEndOffset = INDEX_NONE;
+    ObjectDepth = 0;
+    bInString = false;
+    bEscaped = false;
+    
+    if (ReadOffset == WriteOffset)
+    {
+        ReadOffset = 0;
+        WriteOffset = 0;
+        NewlineScanOffset = 0;
+        ObjectScanOffset = 0;
+    }
+}
+
+void FMCPReceiveBuffer::Reserve(int32 Size)
+{
+    if (Data.Num() - ReadOffset < Size + InitialCapacity)
+    {
+        // Plus one read's worth, so PrepareWrite doesn't double the buffer for the last bytes of the message
+        Compact();
+        Data.SetNumUninitialized(FMath::Max(Data.Num(), Size + InitialCapacity), EAllowShrinking::No);
+    }
+}
+
+int32 FMCPReceiveBuffer::FindNewline()
+{
+    const uint8* Bytes = Data.GetData();
+    for (; NewlineScanOffset < WriteOffset; ++NewlineScanOffset)
+    {
+        if (Bytes[NewlineScanOffset] == '\n')
+        {
+            return NewlineScanOffset - ReadOffset;
+        }
+    }
+    return INDEX_NONE;
+}
+
+int32 FMCPReceiveBuffer::FindObjectEnd()
+{
+    const uint8* Bytes = Data.GetData();
+    while (ObjectEndOffset == INDEX_NONE && ObjectScanOffset < WriteOffset)
+    {
+        const uint8 Byte = Bytes[ObjectScanOffset++];
+        if (bInString)
+        {
+            if (bEscaped)
+            {
+                bEscaped = false;
+            }
+            else if (Byte == '\\')
+            {
+                bEscaped = true;
+            }
+            else if (Byte == '"')
+            {
+                bInString = false;
+            }
+        }
+        else if (Byte == '"')
+        {
+            bInString = true;
+        }
+        else if (Byte == '{' || Byte == '[')
+        {
+            ++ObjectDepth;
+        }
+        else if ((Byte == '}' || Byte == ']') && ObjectDepth > 0 && --ObjectDepth == 0)
+        {
+            ObjectEndOffset = ObjectScanOffset;
+            break;
+        }
+    }
+    return ObjectEndOffset != INDEX_NONE ? ObjectEndOffset - ReadOffset : INDEX_NONE;
+}
+
+void FMCPReceiveBuffer::Compact()
+{
+    if (ReadOffset == 0)
+    {
+        return;
+    }
+    
+    const int32 PendingSize = Num();
+    if (PendingSize > 0)
+    {
+        FMemory::Memmove(Data.GetData(), Data.GetData() + ReadOffset, PendingSize);
+    }
+    
+    NewlineScanOffset -= ReadOffset;
+    ObjectScanOffset -= ReadOffset;
+    if (ObjectEndOffset != INDEX_NONE)
+    {
+        ObjectEndOffset -= ReadOffset;
+    }
+    ReadOffset = 0;
+    WriteOffset = PendingSize;
+}
@@ -0,0 +1,561 @@
+#include "UnrealMCPBridge.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPMallocCounter.h"
+#include "UnrealMCPTraceRecorder.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "HAL/FileManager.h"
+#include "Editor.h"
+#include "EditorAssetLibrary.h"
+#include "ScopedTransaction.h"
+#include "GameFramework/InputSettings.h"
+#include "GameFramework/WorldSettings.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Automation tests for the command handlers
+ * Every command runs through UUnrealMCPBridge::ExecuteCommand on the game thread, which calls
+ * the registered handler directly, with canned parameters. Each call is checked for the
+ * expected status and result and against a time and allocation budget, so a handler that
+ * becomes slower or allocates far more than before fails the run.
+ *
+ * Run headless with:
+ *   UnrealEditor MCPGameProject.uproject -nullrhi -unattended -ExecCmds="Automation RunTests UnrealMCP.Commands; Quit"
+ *
+ * Budgets are generous ceilings for a development machine; pass -UnrealMCPTestBudgetScale=N to
+ * scale them on slower machines. The tests create actors in the editor world and assets named
+ * UnrealMCPTest_* under /Game, and delete them again. Commands not covered:
+ *  - focus_viewport and take_screenshot need a viewport, which -nullrhi has none of
+ *  - create_actor is a deprecated alias of spawn_actor that only adds a warning to the log
+ */
+namespace UnrealMCPTests
+{
+    struct FBudget
+    {
+        double Milliseconds;
+        int64 Allocations;
+    };
+
+    // Reading and light editing commands
+    constexpr FBudget QuickBudget = { 20.0, 20000 };
+
+    // Commands that create objects or edit Blueprints
+    constexpr FBudget EditBudget = { 200.0, 200000 };
+
+    // Commands that create assets or compile Blueprints
+    constexpr FBudget AssetBudget = { 2000.0, 2000000 };
+
+    const TCHAR* const BlueprintPath = TEXT("/Game/Blueprints/");
+    const TCHAR* const WidgetPath = TEXT("/Game/Widgets/");
+
+    /** Runs commands through the bridge and checks their responses and budgets */
+    class FCommandRunner
+    {
+    public:
+        explicit FCommandRunner(FAutomationTestBase& InTest)
+            : Test(InTest)
+            , Bridge(GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr)
+            , BudgetScale(1.0)
+        {
+            FParse::Value(FCommandLine::Get(), TEXT("UnrealMCPTestBudgetScale="), BudgetScale);
+            if (!Bridge)
+            {
+                Test.AddError(TEXT("The UnrealMCP bridge subsystem is not available"));
+            }
+        }
+
+        bool IsValid() const { return Bridge != nullptr; }
+
+        /** Runs Command, expecting it to succeed within Budget; returns its result, or null if it failed */
+        TSharedPtr<FJsonObject> ExpectSuccess(const TCHAR* Command, const FString& Params, const FBudget& Budget)
+        {
+            double Milliseconds = 0.0;
+            int64 Allocations = 0;
+            TSharedPtr<FJsonObject> Response = Run(Command, Params, Milliseconds, Allocations);
+            if (!Response.IsValid())
+            {
+                return nullptr;
+            }
+
+            // Successful responses carry no error field, and reading a missing field logs a LogJson error
+            FString Status;
+            Response->TryGetStringField(TEXT("status"), Status);
+            if (Status != TEXT("success"))
+            {
+                FString Error;
+                Response->TryGetStringField(TEXT("error"), Error);
+                Test.AddError(FString::Printf(TEXT("%s status is '%s', expected 'success' (error: %s)"), Command, *Status, *Error));
+                return nullptr;
+            }
+
+            Test.AddInfo(FString::Printf(TEXT("%s: %.2f ms, %lld allocations"), Command, Milliseconds, Allocations));
+            Test.TestTrue(FString::Printf(TEXT("%s took %.2f ms, budget %.2f ms"), Command, Milliseconds, Budget.Milliseconds * BudgetScale),
+                Milliseconds <= Budget.Milliseconds * BudgetScale);
+            Test.TestTrue(FString::Printf(TEXT("%s made %lld allocations, budget %lld"), Command, Allocations, (int64)(Budget.Allocations * BudgetScale)),
+                Allocations <= (int64)(Budget.Allocations * BudgetScale));
+
+            const TSharedPtr<FJsonObject>* Result = nullptr;
+            if (!Test.TestTrue(FString::Printf(TEXT("%s returns a result object"), Command), Response->TryGetObjectField(TEXT("result"), Result)))
+            {
+                return nullptr;
+            }
+            return *Result;
+        }
+
+        /** Runs Command, expecting an error response */
+        void ExpectError(const TCHAR* Command, const FString& Params)
+        {
+            double Milliseconds = 0.0;
+            int64 Allocations = 0;
+            TSharedPtr<FJsonObject> Response = Run(Command, Params, Milliseconds, Allocations);
+            if (Response.IsValid())
+            {
+                FString Status;
+                Response->TryGetStringField(TEXT("status"), Status);
+                Test.TestEqual(FString::Printf(TEXT("%s fails"), Command), Status, FString(TEXT("error")));
+                FString Error;
+                Response->TryGetStringField(TEXT("error"), Error);
+                Test.TestFalse(FString::Printf(TEXT("%s reports why it failed"), Command), Error.IsEmpty());
+            }
+        }
+
+        /** Deletes an asset left over by an earlier, interrupted run or created by this one */
+        static void DeleteAssetIfExists(const FString& AssetPath)
+        {
+            if (UEditorAssetLibrary::DoesAssetExist(AssetPath))
+            {
+                UEditorAssetLibrary::DeleteAsset(AssetPath);
+            }
+        }
+
+    private:
+        TSharedPtr<FJsonObject> Run(const TCHAR* Command, const FString& Params, double& OutMilliseconds, int64& OutAllocations)
+        {
+            TSharedPtr<FJsonObject> ParamsObject;
+            if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Params), ParamsObject) || !ParamsObject.IsValid())
+            {
+                Test.AddError(FString::Printf(TEXT("%s: invalid test parameters %s"), Command, *Params));
+                return nullptr;
+            }
+
+            // On the game thread the bridge runs the handler right away, so this times the handler and its response
+            FUnrealMCPMallocCounter& MallocCounter = FUnrealMCPMallocCounter::Get();
+            MallocCounter.Begin();
+            const double StartTime = FPlatformTime::Seconds();
+            FUnrealMCPResponse Response = Bridge->ExecuteCommand(Command, ParamsObject);
+            OutMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+            OutAllocations = MallocCounter.End();
+
+            if (Response.Object.IsValid())
+            {
+                return Response.Object;
+            }
+
+            // Streamed responses are already encoded; read them back to check them
+            TSharedPtr<FJsonObject> ResponseObject;
+            const FUtf8StringView Payload(reinterpret_cast<const UTF8CHAR*>(Response.Payload.GetData()), Response.Payload.Num());
+            if (!FJsonSerializer::Deserialize(TJsonReaderFactory<UTF8CHAR>::CreateFromView(Payload), ResponseObject) || !ResponseObject.IsValid())
+            {
+                Test.AddError(FString::Printf(TEXT("%s: streamed response is not valid JSON"), Command));
+                return nullptr;
+            }
+            return ResponseObject;
+        }
+
+        FAutomationTestBase& Test;
+        UUnrealMCPBridge* Bridge;
+        double BudgetScale;
+    };
+}
+
+using namespace UnrealMCPTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPServerCommandsTest, "UnrealMCP.Commands.Server",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnrealMCPServerCommandsTest::RunTest(const FString& Parameters)
+{
+    FCommandRunner Runner(*this);
+    if (!Runner.IsValid())
+    {
+        return false;
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("ping"), TEXT("{}"), { 1.0, 100 }))
+    {
+        TestEqual(TEXT("ping message"), Result->GetStringField(TEXT("message")), FString(TEXT("pong")));
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("list_commands"), TEXT("{}"), QuickBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+        TestTrue(TEXT("list_commands lists commands"), Result->TryGetArrayField(TEXT("commands"), Commands) && Commands->Num() > 0);
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("batch"), TEXT("{\"commands\": [{\"type\": \"ping\"}, {\"type\": \"ping\"}]}"), QuickBudget))
+    {
+        TestEqual(TEXT("batch runs every entry"), (int32)Result->GetNumberField(TEXT("executed")), 2);
+        TestEqual(TEXT("batch entries succeed"), (int32)Result->GetNumberField(TEXT("failed")), 0);
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("get_server_stats"), TEXT("{}"), QuickBudget))
+    {
+        TestTrue(TEXT("get_server_stats reports commands"), Result->HasField(TEXT("commands")));
+    }
+
+    Runner.ExpectSuccess(TEXT("get_cache_stats"), TEXT("{}"), QuickBudget);
+
+    // Without parameters set_log_options only reports the options in effect; it has no error case
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("set_log_options"), TEXT("{}"), QuickBudget))
+    {
+        TestTrue(TEXT("set_log_options reports the options"), Result->HasField(TEXT("log_payloads")) && Result->HasField(TEXT("sample_interval")));
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("benchmark_serialization"),
+        TEXT("{\"command\": \"get_actors_in_level\", \"params\": {\"limit\": 10}, \"iterations\": 2}"), EditBudget))
+    {
+        TestTrue(TEXT("benchmark_serialization measures both modes"), Result->HasField(TEXT("tree")) && Result->HasField(TEXT("streaming")));
+    }
+    Runner.ExpectError(TEXT("benchmark_serialization"), TEXT("{\"command\": \"ping\"}"));
+    Runner.ExpectError(TEXT("benchmark_serialization"), TEXT("{\"command\": \"get_actors_in_level\", \"encoding\": \"unreal_mcp_test_encoding\"}"));
+
+    // An editor started with Record Trace enabled is already recording, and that trace is left alone
+    UUnrealMCPBridge* Bridge = GEditor->GetEditorSubsystem<UUnrealMCPBridge>();
+    if (Bridge->GetTraceRecorder()->IsRecording())
+    {
+        Runner.ExpectError(TEXT("start_trace_recording"), TEXT("{\"path\": \"UnrealMCPTest_Trace.mcptrace\"}"));
+    }
+    else
+    {
+        Runner.ExpectError(TEXT("stop_trace_recording"), TEXT("{}"));
+        if (Runner.ExpectSuccess(TEXT("start_trace_recording"), TEXT("{\"path\": \"UnrealMCPTest_Trace.mcptrace\"}"), QuickBudget))
+        {
+            Runner.ExpectError(TEXT("start_trace_recording"), TEXT("{\"path\": \"UnrealMCPTest_Trace.mcptrace\"}"));
+            if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("stop_trace_recording"), TEXT("{}"), QuickBudget))
+            {
+                TestFalse(TEXT("stop_trace_recording stops recording"), Result->GetBoolField(TEXT("recording")));
+                IFileManager::Get().Delete(*Result->GetStringField(TEXT("path")));
+            }
+        }
+    }
+
+    Runner.ExpectError(TEXT("unreal_mcp_test_unknown_command"), TEXT("{}"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPEditorCommandsTest, "UnrealMCP.Commands.Editor",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnrealMCPEditorCommandsTest::RunTest(const FString& Parameters)
+{
+    FCommandRunner Runner(*this);
+    if (!Runner.IsValid())
+    {
+        return false;
+    }
+
+    const FString ActorParams = TEXT("{\"name\": \"UnrealMCPTest_Actor\"}");
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("spawn_actor"),
+        TEXT("{\"name\": \"UnrealMCPTest_Actor\", \"type\": \"StaticMeshActor\", \"location\": [0, 0, 0], \"rotation\": [0, 0, 0]}"), EditBudget))
+    {
+        TestEqual(TEXT("spawned actor name"), Result->GetStringField(TEXT("name")), FString(TEXT("UnrealMCPTest_Actor")));
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("get_actors_in_level"), TEXT("{\"limit\": 10}"), QuickBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Actors = nullptr;
+        TestTrue(TEXT("get_actors_in_level returns actors"), Result->TryGetArrayField(TEXT("actors"), Actors) && Actors->Num() > 0);
+        TestTrue(TEXT("get_actors_in_level honors the limit"), Actors && Actors->Num() <= 10);
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("find_actors_by_name"), TEXT("{\"pattern\": \"UnrealMCPTest_\"}"), QuickBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Actors = nullptr;
+        TestTrue(TEXT("find_actors_by_name finds the spawned actor"), Result->TryGetArrayField(TEXT("actors"), Actors) && Actors->Num() == 1);
+    }
+
+    Runner.ExpectSuccess(TEXT("set_actor_transform"), TEXT("{\"name\": \"UnrealMCPTest_Actor\", \"location\": [100, 200, 300], \"scale\": [2, 2, 2]}"), QuickBudget);
+    Runner.ExpectSuccess(TEXT("set_actor_property"), TEXT("{\"name\": \"UnrealMCPTest_Actor\", \"property_name\": \"bCanBeDamaged\", \"property_value\": false}"), QuickBudget);
+    Runner.ExpectSuccess(TEXT("set_actor_material"), TEXT("{\"name\": \"UnrealMCPTest_Actor\", \"color\": [1, 0, 0]}"), EditBudget);
+    Runner.ExpectError(TEXT("set_actor_material"), TEXT("{\"name\": \"UnrealMCPTest_Actor\", \"color\": [1]}"));
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("get_actor_properties"), ActorParams, QuickBudget))
+    {
+        TestEqual(TEXT("get_actor_properties name"), Result->GetStringField(TEXT("name")), FString(TEXT("UnrealMCPTest_Actor")));
+        const TArray<TSharedPtr<FJsonValue>>* Location = nullptr;
+        if (TestTrue(TEXT("get_actor_properties location"), Result->TryGetArrayField(TEXT("location"), Location) && Location->Num() == 3))
+        {
+            TestEqual(TEXT("set_actor_transform moved the actor"), (*Location)[2]->AsNumber(), 300.0);
+        }
+    }
+
+    // Edits in a group are undone together
+    Runner.ExpectSuccess(TEXT("begin_transaction"), TEXT("{\"name\": \"UnrealMCPTest_Group\"}"), QuickBudget);
+    Runner.ExpectError(TEXT("begin_transaction"), TEXT("{}"));
+    Runner.ExpectSuccess(TEXT("set_actor_transform"), TEXT("{\"name\": \"UnrealMCPTest_Actor\", \"location\": [0, 0, 500]}"), QuickBudget);
+    Runner.ExpectSuccess(TEXT("set_actor_transform"), TEXT("{\"name\": \"UnrealMCPTest_Actor\", \"location\": [0, 0, 600]}"), QuickBudget);
+
+    // An edit made by hand after the group's keeps the group from being undone past it
+    if (AWorldSettings* WorldSettings = GEditor->GetEditorWorldContext().World()->GetWorldSettings())
+    {
+        {
+            FScopedTransaction ByHand(FText::FromString(TEXT("UnrealMCPTest_ByHand")));
+            WorldSettings->Modify();
+            WorldSettings->KillZ -= 1.0f;
+        }
+        Runner.ExpectError(TEXT("end_transaction"), TEXT("{\"undo\": true}"));
+        GEditor->UndoTransaction();
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("end_transaction"), TEXT("{\"undo\": true}"), EditBudget))
+    {
+        TestEqual(TEXT("end_transaction counts the group's commands"), (int32)Result->GetNumberField(TEXT("commands")), 2);
+        TestFalse(TEXT("end_transaction closes the group"), Result->GetBoolField(TEXT("open")));
+    }
+    Runner.ExpectError(TEXT("end_transaction"), TEXT("{}"));
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("get_actor_properties"), ActorParams, QuickBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Location = nullptr;
+        if (Result->TryGetArrayField(TEXT("location"), Location) && Location->Num() == 3)
+        {
+            TestEqual(TEXT("end_transaction undid the group"), (*Location)[2]->AsNumber(), 300.0);
+        }
+    }
+
+    Runner.ExpectSuccess(TEXT("delete_actor"), ActorParams, EditBudget);
+    Runner.ExpectError(TEXT("delete_actor"), ActorParams);
+    Runner.ExpectError(TEXT("spawn_actor"), TEXT("{\"name\": \"UnrealMCPTest_Bad\", \"type\": \"NoSuchActorType\"}"));
+    Runner.ExpectError(TEXT("set_actor_transform"), TEXT("{\"name\": \"UnrealMCPTest_Missing\", \"location\": [0, 0, 0]}"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPBlueprintCommandsTest, "UnrealMCP.Commands.Blueprint",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnrealMCPBlueprintCommandsTest::RunTest(const FString& Parameters)
+{
+    FCommandRunner Runner(*this);
+    if (!Runner.IsValid())
+    {
+        return false;
+    }
+
+    const FString AssetPath = FString(BlueprintPath) + TEXT("UnrealMCPTest_Blueprint");
+    FCommandRunner::DeleteAssetIfExists(AssetPath);
+
+    if (!Runner.ExpectSuccess(TEXT("create_blueprint"), TEXT("{\"name\": \"UnrealMCPTest_Blueprint\", \"parent_class\": \"Actor\"}"), AssetBudget))
+    {
+        return false;
+    }
+    Runner.ExpectError(TEXT("create_blueprint"), TEXT("{\"name\": \"UnrealMCPTest_Blueprint\", \"parent_class\": \"Actor\"}"));
+
+    Runner.ExpectSuccess(TEXT("add_component_to_blueprint"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"component_type\": \"StaticMeshComponent\", \"component_name\": \"Mesh\", \"location\": [0, 0, 0], \"rotation\": [0, 0, 0], \"scale\": [1, 1, 1]}"), EditBudget);
+    Runner.ExpectError(TEXT("add_component_to_blueprint"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"component_type\": \"NoSuchComponent\", \"component_name\": \"Bad\"}"));
+    Runner.ExpectSuccess(TEXT("set_static_mesh_properties"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"component_name\": \"Mesh\", \"static_mesh\": \"/Engine/BasicShapes/Cube.Cube\"}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("set_component_property"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"component_name\": \"Mesh\", \"property_name\": \"CastShadow\", \"property_value\": false}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("set_physics_properties"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"component_name\": \"Mesh\", \"simulate_physics\": true, \"mass\": 10.0, \"linear_damping\": 0.1, \"angular_damping\": 0.1}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("set_blueprint_property"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"property_name\": \"bCanBeDamaged\", \"property_value\": false}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("set_pawn_properties"), TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"can_be_damaged\": true}"), AssetBudget);
+    Runner.ExpectError(TEXT("set_pawn_properties"), TEXT("{\"blueprint_name\": \"UnrealMCPTest_NoSuchBlueprint\", \"can_be_damaged\": true}"));
+    Runner.ExpectSuccess(TEXT("compile_blueprint"), TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\"}"), AssetBudget);
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("spawn_blueprint_actor"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Blueprint\", \"actor_name\": \"UnrealMCPTest_BlueprintActor\", \"location\": [0, 0, 100], \"rotation\": [0, 0, 0]}"), EditBudget))
+    {
+        TestEqual(TEXT("spawned Blueprint actor name"), Result->GetStringField(TEXT("name")), FString(TEXT("UnrealMCPTest_BlueprintActor")));
+        Runner.ExpectSuccess(TEXT("delete_actor"), TEXT("{\"name\": \"UnrealMCPTest_BlueprintActor\"}"), EditBudget);
+    }
+
+    Runner.ExpectError(TEXT("compile_blueprint"), TEXT("{\"blueprint_name\": \"UnrealMCPTest_NoSuchBlueprint\"}"));
+
+    FCommandRunner::DeleteAssetIfExists(AssetPath);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPBlueprintNodeCommandsTest, "UnrealMCP.Commands.BlueprintNode",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnrealMCPBlueprintNodeCommandsTest::RunTest(const FString& Parameters)
+{
+    FCommandRunner Runner(*this);
+    if (!Runner.IsValid())
+    {
+        return false;
+    }
+
+    const FString AssetPath = FString(BlueprintPath) + TEXT("UnrealMCPTest_NodeBlueprint");
+    FCommandRunner::DeleteAssetIfExists(AssetPath);
+
+    if (!Runner.ExpectSuccess(TEXT("create_blueprint"), TEXT("{\"name\": \"UnrealMCPTest_NodeBlueprint\", \"parent_class\": \"Actor\"}"), AssetBudget))
+    {
+        return false;
+    }
+
+    FString EventNodeId;
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("add_blueprint_event_node"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"event_name\": \"ReceiveBeginPlay\", \"node_position\": [0, 0]}"), EditBudget))
+    {
+        EventNodeId = Result->GetStringField(TEXT("node_id"));
+        TestFalse(TEXT("event node id"), EventNodeId.IsEmpty());
+    }
+
+    FString FunctionNodeId;
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("add_blueprint_function_node"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"function_name\": \"PrintString\", \"target\": \"KismetSystemLibrary\", \"node_position\": [300, 0]}"), EditBudget))
+    {
+        FunctionNodeId = Result->GetStringField(TEXT("node_id"));
+        TestFalse(TEXT("function node id"), FunctionNodeId.IsEmpty());
+    }
+
+    if (!EventNodeId.IsEmpty() && !FunctionNodeId.IsEmpty())
+    {
+        Runner.ExpectSuccess(TEXT("connect_blueprint_nodes"), FString::Printf(
+            TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"source_node_id\": \"%s\", \"source_pin\": \"then\", \"target_node_id\": \"%s\", \"target_pin\": \"execute\"}"),
+            *EventNodeId, *FunctionNodeId), EditBudget);
+        Runner.ExpectError(TEXT("connect_blueprint_nodes"), FString::Printf(
+            TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"source_node_id\": \"%s\", \"source_pin\": \"NoSuchPin\", \"target_node_id\": \"%s\", \"target_pin\": \"execute\"}"),
+            *EventNodeId, *FunctionNodeId));
+    }
+
+    Runner.ExpectSuccess(TEXT("add_blueprint_variable"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"variable_name\": \"Health\", \"variable_type\": \"Float\", \"is_exposed\": true}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("add_blueprint_get_self_component_reference"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"component_name\": \"DefaultSceneRoot\", \"node_position\": [300, 200]}"), EditBudget);
+    Runner.ExpectError(TEXT("add_blueprint_get_self_component_reference"), TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\"}"));
+    Runner.ExpectSuccess(TEXT("add_blueprint_self_reference"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"node_position\": [0, 200]}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("add_blueprint_input_action_node"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"action_name\": \"UnrealMCPTest_Action\", \"node_position\": [0, 400]}"), EditBudget);
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("find_blueprint_nodes"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"node_type\": \"Event\", \"event_name\": \"ReceiveBeginPlay\"}"), QuickBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* NodeGuids = nullptr;
+        TestTrue(TEXT("find_blueprint_nodes finds the event node"), Result->TryGetArrayField(TEXT("node_guids"), NodeGuids) &&
+            NodeGuids->ContainsByPredicate([&EventNodeId](const TSharedPtr<FJsonValue>& Value) { return Value->AsString() == EventNodeId; }));
+    }
+
+    // Nodes added in a group are removed from the graph again when the group is undone
+    Runner.ExpectSuccess(TEXT("begin_transaction"), TEXT("{\"name\": \"UnrealMCPTest_NodeGroup\"}"), QuickBudget);
+    Runner.ExpectSuccess(TEXT("add_blueprint_event_node"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"event_name\": \"ReceiveDestroyed\", \"node_position\": [0, 600]}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("end_transaction"), TEXT("{\"undo\": true}"), EditBudget);
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("find_blueprint_nodes"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"node_type\": \"Event\", \"event_name\": \"ReceiveDestroyed\"}"), QuickBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* NodeGuids = nullptr;
+        TestTrue(TEXT("end_transaction undid the added node"), Result->TryGetArrayField(TEXT("node_guids"), NodeGuids) && NodeGuids->Num() == 0);
+    }
+
+    Runner.ExpectError(TEXT("add_blueprint_function_node"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_NodeBlueprint\", \"function_name\": \"NoSuchFunction\", \"target\": \"KismetSystemLibrary\"}"));
+
+    FCommandRunner::DeleteAssetIfExists(AssetPath);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPProjectCommandsTest, "UnrealMCP.Commands.Project",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnrealMCPProjectCommandsTest::RunTest(const FString& Parameters)
+{
+    FCommandRunner Runner(*this);
+    if (!Runner.IsValid())
+    {
+        return false;
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("find_assets"), TEXT("{\"class\": \"StaticMesh\", \"path\": \"/Engine/BasicShapes\", \"limit\": 5}"), QuickBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Assets = nullptr;
+        TestTrue(TEXT("find_assets finds the engine's basic shapes"), Result->TryGetArrayField(TEXT("assets"), Assets) && Assets->Num() > 0);
+        TestTrue(TEXT("find_assets honors the limit"), Assets && Assets->Num() <= 5);
+    }
+
+    // Without class or path the whole registry is searched
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("find_assets"), TEXT("{\"name\": \"Cube\", \"limit\": 20}"), EditBudget))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Assets = nullptr;
+        TestTrue(TEXT("find_assets by name alone finds assets"), Result->TryGetArrayField(TEXT("assets"), Assets) && Assets->Num() > 0);
+        TestTrue(TEXT("find_assets by name alone applies the name filter"), Assets && !Assets->ContainsByPredicate([](const TSharedPtr<FJsonValue>& Value)
+        {
+            return !Value->AsObject()->GetStringField(TEXT("name")).Contains(TEXT("Cube"));
+        }));
+    }
+
+    Runner.ExpectSuccess(TEXT("list_blueprints"), TEXT("{\"limit\": 20}"), QuickBudget);
+    Runner.ExpectError(TEXT("find_assets"), TEXT("{\"fields\": [\"no_such_field\"]}"));
+
+    // The mapping is saved to the project's input settings, so take it out again
+    if (Runner.ExpectSuccess(TEXT("create_input_mapping"), TEXT("{\"action_name\": \"UnrealMCPTest_Action\", \"key\": \"F13\", \"shift\": true}"), EditBudget))
+    {
+        UInputSettings* InputSettings = GetMutableDefault<UInputSettings>();
+        TArray<FInputActionKeyMapping> Mappings;
+        InputSettings->GetActionMappingByName(TEXT("UnrealMCPTest_Action"), Mappings);
+        TestEqual(TEXT("create_input_mapping adds one mapping"), Mappings.Num(), 1);
+        for (const FInputActionKeyMapping& Mapping : Mappings)
+        {
+            InputSettings->RemoveActionMapping(Mapping);
+        }
+        InputSettings->SaveConfig();
+    }
+    Runner.ExpectError(TEXT("create_input_mapping"), TEXT("{\"action_name\": \"UnrealMCPTest_Action\"}"));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnrealMCPUMGCommandsTest, "UnrealMCP.Commands.UMG",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnrealMCPUMGCommandsTest::RunTest(const FString& Parameters)
+{
+    FCommandRunner Runner(*this);
+    if (!Runner.IsValid())
+    {
+        return false;
+    }
+
+    const FString AssetPath = FString(WidgetPath) + TEXT("UnrealMCPTest_Widget");
+    FCommandRunner::DeleteAssetIfExists(AssetPath);
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("create_umg_widget_blueprint"), TEXT("{\"name\": \"UnrealMCPTest_Widget\"}"), AssetBudget))
+    {
+        TestEqual(TEXT("widget Blueprint name"), Result->GetStringField(TEXT("name")), FString(TEXT("UnrealMCPTest_Widget")));
+    }
+    else
+    {
+        return false;
+    }
+
+    if (TSharedPtr<FJsonObject> Result = Runner.ExpectSuccess(TEXT("add_text_block_to_widget"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Widget\", \"widget_name\": \"Score\", \"text\": \"0\", \"position\": [10, 10]}"), EditBudget))
+    {
+        TestEqual(TEXT("text block name"), Result->GetStringField(TEXT("widget_name")), FString(TEXT("Score")));
+        TestEqual(TEXT("text block text"), Result->GetStringField(TEXT("text")), FString(TEXT("0")));
+    }
+
+    Runner.ExpectSuccess(TEXT("add_button_to_widget"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Widget\", \"widget_name\": \"StartButton\", \"text\": \"Start\", \"position\": [10, 60]}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("bind_widget_event"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Widget\", \"widget_name\": \"StartButton\", \"event_name\": \"OnClicked\"}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("set_text_block_binding"),
+        TEXT("{\"blueprint_name\": \"UnrealMCPTest_Widget\", \"widget_name\": \"Score\", \"binding_name\": \"ScoreText\"}"), EditBudget);
+    Runner.ExpectSuccess(TEXT("add_widget_to_viewport"), TEXT("{\"blueprint_name\": \"UnrealMCPTest_Widget\"}"), QuickBudget);
+    Runner.ExpectError(TEXT("add_text_block_to_widget"), TEXT("{\"blueprint_name\": \"UnrealMCPTest_NoSuchWidget\", \"widget_name\": \"Score\"}"));
+
+    FCommandRunner::DeleteAssetIfExists(AssetPath);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
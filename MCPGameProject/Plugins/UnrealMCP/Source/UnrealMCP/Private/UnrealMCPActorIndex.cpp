@@ -0,0 +1,376 @@
+#include "UnrealMCPActorIndex.h"
+#include "UnrealMCPLog.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+FUnrealMCPActorIndex::FUnrealMCPActorIndex()
+    : bSortedDirty(true)
+    , bHasDeadEntries(false)
+    , bDirty(true)
+{
+}
+
+FUnrealMCPActorIndex::~FUnrealMCPActorIndex()
+{
+    Shutdown();
+}
+
+void FUnrealMCPActorIndex::Initialize()
+{
+    if (GEngine)
+    {
+        LevelActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FUnrealMCPActorIndex::OnLevelActorAdded);
+        LevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FUnrealMCPActorIndex::OnLevelActorDeleted);
+    }
+    ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FUnrealMCPActorIndex::OnActorLabelChanged);
+    ObjectRenamedHandle = FCoreUObjectDelegates::OnObjectRenamed.AddRaw(this, &FUnrealMCPActorIndex::OnObjectRenamed);
+
+    // Neither undo/redo nor loading a map report the actors they bring back, so rebuild on the next lookup
+    PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FUnrealMCPActorIndex::OnInvalidated);
+    MapChangeHandle = FEditorDelegates::MapChange.AddLambda([this](uint32 MapChangeFlags)
+    {
+        OnInvalidated();
+    });
+
+    bDirty = true;
+}
+
+void FUnrealMCPActorIndex::Shutdown()
+{
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(LevelActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedHandle);
+    }
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+    FCoreUObjectDelegates::OnObjectRenamed.Remove(ObjectRenamedHandle);
+    FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+    FEditorDelegates::MapChange.Remove(MapChangeHandle);
+
+    LevelActorAddedHandle.Reset();
+    LevelActorDeletedHandle.Reset();
+    ActorLabelChangedHandle.Reset();
+    ObjectRenamedHandle.Reset();
+    PostUndoRedoHandle.Reset();
+    MapChangeHandle.Reset();
+
+    Reset();
+}
+
+AActor* FUnrealMCPActorIndex::FindActorByName(const FString& Name)
+{
+    if (AActor* Actor = FindActorByLabel(Name))
+    {
+        return Actor;
+    }
+
+    // Object names are FNames; don't add a name that no object uses to the name table
+    const FName ObjectName(*Name, FNAME_Find);
+    if (ObjectName.IsNone())
+    {
+        return nullptr;
+    }
+
+    for (auto It = ActorsByName.CreateConstKeyIterator(ObjectName); It; ++It)
+    {
+        AActor* Actor = It.Value().Get();
+        if (IsValid(Actor) && Actor->GetFName() == ObjectName)
+        {
+            return Actor;
+        }
+        bHasDeadEntries |= !IsValid(Actor);
+    }
+    return nullptr;
+}
+
+AActor* FUnrealMCPActorIndex::FindActorByLabel(const FString& Label)
+{
+    check(IsInGameThread());
+    EnsureUpToDate();
+
+    for (auto It = ActorsByLabel.CreateConstKeyIterator(Label); It; ++It)
+    {
+        // The entry is stale if the actor died or was relabelled without an event; skip it
+        AActor* Actor = It.Value().Get();
+        if (IsValid(Actor) && Actor->GetActorLabel() == Label)
+        {
+            return Actor;
+        }
+        bHasDeadEntries |= !IsValid(Actor);
+    }
+    return nullptr;
+}
+
+void FUnrealMCPActorIndex::GetActorsOfClass(const UClass* Class, TArray<AActor*>& OutActors, bool bIncludeSubclasses)
+{
+    CollectActors([Class, bIncludeSubclasses](const UClass* IndexedClass)
+    {
+        return IndexedClass == Class || (bIncludeSubclasses && IndexedClass->IsChildOf(Class));
+    }, OutActors);
+}
+
+void FUnrealMCPActorIndex::GetActorsOfClass(const FString& ClassName, TArray<AActor*>& OutActors)
+{
+    CollectActors([&ClassName](const UClass* IndexedClass)
+    {
+        for (const UClass* Class = IndexedClass; Class; Class = Class->GetSuperClass())
+        {
+            if (Class->GetName() == ClassName)
+            {
+                return true;
+            }
+        }
+        return false;
+    }, OutActors);
+}
+
+void FUnrealMCPActorIndex::CollectActors(TFunctionRef<bool(const UClass*)> ClassFilter, TArray<AActor*>& OutActors)
+{
+    check(IsInGameThread());
+    EnsureUpToDate();
+
+    for (const TPair<TWeakObjectPtr<UClass>, TSet<TWeakObjectPtr<AActor>>>& Pair : ActorsByClass)
+    {
+        const UClass* IndexedClass = Pair.Key.Get();
+        if (!IndexedClass || !ClassFilter(IndexedClass))
+        {
+            continue;
+        }
+
+        for (const TWeakObjectPtr<AActor>& WeakActor : Pair.Value)
+        {
+            AActor* Actor = WeakActor.Get();
+            if (IsValid(Actor))
+            {
+                OutActors.Add(Actor);
+            }
+            else
+            {
+                bHasDeadEntries = true;
+            }
+        }
+    }
+}
+
+int32 FUnrealMCPActorIndex::Num()
+{
+    check(IsInGameThread());
+    EnsureUpToDate();
+
+    // Dead entries can go unnoticed by lookups, so always check before counting
+    bHasDeadEntries = true;
+    PruneDeadEntries();
+    return IndexedActors.Num();
+}
+
+const TArray<FUnrealMCPActorIndex::FNamedActor>& FUnrealMCPActorIndex::GetActorsSortedByName()
+{
+    check(IsInGameThread());
+    EnsureUpToDate();
+
+    if (bSortedDirty)
+    {
+        ActorsSortedByName.Reset(IndexedActors.Num());
+        for (const TPair<TWeakObjectPtr<AActor>, FIndexedActor>& Pair : IndexedActors)
+        {
+            if (Pair.Key.IsValid())
+            {
+                ActorsSortedByName.Add({ Pair.Value.Name, Pair.Key });
+            }
+        }
+        ActorsSortedByName.Sort([](const FNamedActor& A, const FNamedActor& B)
+        {
+            return A.Name.LexicalLess(B.Name);
+        });
+        bSortedDirty = false;
+    }
+    return ActorsSortedByName;
+}
+
+void FUnrealMCPActorIndex::EnsureUpToDate()
+{
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (bDirty || IndexedWorld.Get() != World)
+    {
+        Rebuild(World);
+    }
+    else if (bHasDeadEntries)
+    {
+        PruneDeadEntries();
+    }
+}
+
+void FUnrealMCPActorIndex::Rebuild(UWorld* World)
+{
+    Reset();
+    IndexedWorld = World;
+    bDirty = false;
+
+    if (!World)
+    {
+        return;
+    }
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AddActor(*It);
+    }
+
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPActorIndex: Indexed %d actors"), IndexedActors.Num());
+}
+
+void FUnrealMCPActorIndex::Reset()
+{
+    ActorsByLabel.Reset();
+    ActorsByName.Reset();
+    ActorsByClass.Reset();
+    IndexedActors.Reset();
+    IndexedWorld.Reset();
+    bHasDeadEntries = false;
+    ActorsSortedByName.Reset();
+    bSortedDirty = true;
+}
+
+void FUnrealMCPActorIndex::AddActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || IndexedActors.Contains(Actor))
+    {
+        return;
+    }
+
+    FIndexedActor Entry;
+    Entry.Label = Actor->GetActorLabel();
+    Entry.Name = Actor->GetFName();
+    Entry.Class = Actor->GetClass();
+
+    ActorsByLabel.Add(Entry.Label, Actor);
+    ActorsByName.Add(Entry.Name, Actor);
+    ActorsByClass.FindOrAdd(Entry.Class).Add(Actor);
+    IndexedActors.Add(Actor, MoveTemp(Entry));
+    bSortedDirty = true;
+}
+
+void FUnrealMCPActorIndex::RemoveActor(AActor* Actor)
+{
+    // Removed under the keys it was indexed with, which may no longer be its current ones
+    const TWeakObjectPtr<AActor> WeakActor(Actor);
+    FIndexedActor Entry;
+    if (!IndexedActors.RemoveAndCopyValue(WeakActor, Entry))
+    {
+        return;
+    }
+
+    ActorsByLabel.RemoveSingle(Entry.Label, WeakActor);
+    ActorsByName.RemoveSingle(Entry.Name, WeakActor);
+    if (TSet<TWeakObjectPtr<AActor>>* ClassActors = ActorsByClass.Find(Entry.Class))
+    {
+        ClassActors->Remove(WeakActor);
+    }
+    bSortedDirty = true;
+}
+
+void FUnrealMCPActorIndex::PruneDeadEntries()
+{
+    if (!bHasDeadEntries)
+    {
+        return;
+    }
+    bHasDeadEntries = false;
+
+    int32 Pruned = 0;
+    for (auto It = IndexedActors.CreateIterator(); It; ++It)
+    {
+        if (IsValid(It.Key().Get()))
+        {
+            continue;
+        }
+
+        // A stale weak pointer still compares equal to the one stored in the other tables
+        const FIndexedActor& Entry = It.Value();
+        ActorsByLabel.RemoveSingle(Entry.Label, It.Key());
+        ActorsByName.RemoveSingle(Entry.Name, It.Key());
+        if (TSet<TWeakObjectPtr<AActor>>* ClassActors = ActorsByClass.Find(Entry.Class))
+        {
+            ClassActors->Remove(It.Key());
+        }
+        It.RemoveCurrent();
+        ++Pruned;
+    }
+
+    if (Pruned > 0)
+    {
+        UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPActorIndex: Pruned %d dead actors"), Pruned);
+    }
+}
+
+void FUnrealMCPActorIndex::OnLevelActorAdded(AActor* Actor)
+{
+    // Ignore PIE and preview worlds, and don't bother while a rebuild is pending anyway
+    if (!bDirty && Actor && Actor->GetWorld() == IndexedWorld.Get())
+    {
+        AddActor(Actor);
+    }
+}
+
+void FUnrealMCPActorIndex::OnLevelActorDeleted(AActor* Actor)
+{
+    if (!bDirty && Actor)
+    {
+        RemoveActor(Actor);
+    }
+}
+
+void FUnrealMCPActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+    if (bDirty || !Actor)
+    {
+        return;
+    }
+
+    FIndexedActor* Entry = IndexedActors.Find(Actor);
+    if (!Entry)
+    {
+        return;
+    }
+
+    ActorsByLabel.RemoveSingle(Entry->Label, Actor);
+    Entry->Label = Actor->GetActorLabel();
+    ActorsByLabel.Add(Entry->Label, Actor);
+}
+
+void FUnrealMCPActorIndex::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+    AActor* Actor = Cast<AActor>(Object);
+    if (bDirty || !Actor)
+    {
+        return;
+    }
+
+    FIndexedActor* Entry = IndexedActors.Find(Actor);
+    if (!Entry)
+    {
+        return;
+    }
+
+    // Renaming into another world or level takes the actor out of the indexed world
+    if (Actor->GetWorld() != IndexedWorld.Get())
+    {
+        RemoveActor(Actor);
+        return;
+    }
+
+    ActorsByName.RemoveSingle(Entry->Name, Actor);
+    Entry->Name = Actor->GetFName();
+    ActorsByName.Add(Entry->Name, Actor);
+    bSortedDirty = true;
+}
+
+void FUnrealMCPActorIndex::OnInvalidated()
+{
+    bDirty = true;
+}
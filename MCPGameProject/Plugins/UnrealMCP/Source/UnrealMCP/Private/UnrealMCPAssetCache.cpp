@@ -0,0 +1,221 @@
+#include "UnrealMCPAssetCache.h"
+#include "UnrealMCPLog.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+
+FUnrealMCPAssetCache::FUnrealMCPAssetCache()
+    : bIndexed(false)
+    , Hits(0)
+    , Misses(0)
+    , NotFound(0)
+    , Invalidations(0)
+{
+}
+
+FUnrealMCPAssetCache::~FUnrealMCPAssetCache()
+{
+    Shutdown();
+}
+
+void FUnrealMCPAssetCache::Initialize()
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUnrealMCPAssetCache::OnAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUnrealMCPAssetCache::OnAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUnrealMCPAssetCache::OnAssetRenamed);
+
+    Reset();
+}
+
+void FUnrealMCPAssetCache::Shutdown()
+{
+    // The registry may already be gone during editor shutdown
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetRenamedHandle.Reset();
+
+    Reset();
+}
+
+UBlueprint* FUnrealMCPAssetCache::FindBlueprint(const FString& Name, const UClass* BlueprintClass, const FString& PreferredPath)
+{
+    check(IsInGameThread());
+
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // A full object path needs no index; LoadObject returns already loaded objects without touching disk
+    if (Name.StartsWith(TEXT("/")))
+    {
+        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *Name);
+        return Blueprint && Blueprint->IsA(BlueprintClass) ? Blueprint : nullptr;
+    }
+
+    if (const TWeakObjectPtr<UBlueprint>* CachedBlueprint = Resolved.Find(Name))
+    {
+        UBlueprint* Blueprint = CachedBlueprint->Get();
+        if (IsValid(Blueprint) && Blueprint->IsA(BlueprintClass))
+        {
+            ++Hits;
+            return Blueprint;
+        }
+    }
+
+    EnsureIndexed();
+
+    // Asset names are FNames; don't add a name that no asset uses to the name table
+    const FAssetData* BestMatch = nullptr;
+    const FName AssetName(*Name, FNAME_Find);
+    if (!AssetName.IsNone())
+    {
+        const FName PreferredPackagePath(*PreferredPath, FNAME_Find);
+        for (auto It = AssetsByName.CreateConstKeyIterator(AssetName); It; ++It)
+        {
+            const FAssetData& AssetData = It.Value();
+            if (!AssetData.IsInstanceOf(BlueprintClass))
+            {
+                continue;
+            }
+            if (!BestMatch || AssetData.PackagePath == PreferredPackagePath)
+            {
+                BestMatch = &AssetData;
+            }
+        }
+    }
+
+    UBlueprint* Blueprint = nullptr;
+    if (BestMatch)
+    {
+        Blueprint = Cast<UBlueprint>(BestMatch->GetAsset());
+    }
+    else if (IAssetRegistry::GetChecked().IsLoadingAssets())
+    {
+        // The registry is still discovering assets, so the index can't be trusted to be complete yet
+        const FString AssetPath = PreferredPath / Name;
+        if (FPackageName::DoesPackageExist(AssetPath))
+        {
+            Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        }
+    }
+
+    if (!Blueprint || !Blueprint->IsA(BlueprintClass))
+    {
+        ++NotFound;
+        return nullptr;
+    }
+
+    ++Misses;
+    Resolved.Add(Name, Blueprint);
+    return Blueprint;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPAssetCache::GetStats() const
+{
+    const int64 Lookups = Hits + Misses + NotFound;
+
+    TSharedPtr<FJsonObject> Stats = MakeShared<FJsonObject>();
+    Stats->SetNumberField(TEXT("indexed_assets"), AssetsByName.Num());
+    Stats->SetNumberField(TEXT("cached"), Resolved.Num());
+    Stats->SetNumberField(TEXT("hits"), Hits);
+    Stats->SetNumberField(TEXT("misses"), Misses);
+    Stats->SetNumberField(TEXT("not_found"), NotFound);
+    Stats->SetNumberField(TEXT("invalidations"), Invalidations);
+    Stats->SetNumberField(TEXT("hit_rate"), Lookups > 0 ? static_cast<double>(Hits) / Lookups : 0.0);
+    return Stats;
+}
+
+void FUnrealMCPAssetCache::EnsureIndexed()
+{
+    if (bIndexed)
+    {
+        return;
+    }
+
+    // Reads registry metadata only; no package is loaded
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+
+    TArray<FAssetData> Assets;
+    IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+
+    AssetsByName.Reset();
+    for (const FAssetData& AssetData : Assets)
+    {
+        AssetsByName.Add(AssetData.AssetName, AssetData);
+    }
+
+    bIndexed = true;
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPAssetCache: Indexed %d Blueprint assets"), AssetsByName.Num());
+}
+
+void FUnrealMCPAssetCache::Reset()
+{
+    AssetsByName.Reset();
+    Resolved.Reset();
+    bIndexed = false;
+}
+
+void FUnrealMCPAssetCache::AddAsset(const FAssetData& AssetData)
+{
+    if (AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+    {
+        AssetsByName.Add(AssetData.AssetName, AssetData);
+    }
+}
+
+void FUnrealMCPAssetCache::RemoveAsset(FName AssetName, const FSoftObjectPath& ObjectPath)
+{
+    for (auto It = AssetsByName.CreateKeyIterator(AssetName); It; ++It)
+    {
+        if (It.Value().GetSoftObjectPath() == ObjectPath)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    if (Resolved.Remove(AssetName.ToString()) > 0)
+    {
+        ++Invalidations;
+    }
+}
+
+void FUnrealMCPAssetCache::OnAssetAdded(const FAssetData& AssetData)
+{
+    // Before the first lookup there is no index to update; it is built from the registry then
+    if (bIndexed)
+    {
+        AddAsset(AssetData);
+    }
+}
+
+void FUnrealMCPAssetCache::OnAssetRemoved(const FAssetData& AssetData)
+{
+    if (bIndexed)
+    {
+        RemoveAsset(AssetData.AssetName, AssetData.GetSoftObjectPath());
+    }
+}
+
+void FUnrealMCPAssetCache::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    if (bIndexed)
+    {
+        const FName OldAssetName(*FPackageName::ObjectPathToObjectName(OldObjectPath));
+        RemoveAsset(OldAssetName, FSoftObjectPath(OldObjectPath));
+        AddAsset(AssetData);
+    }
+}
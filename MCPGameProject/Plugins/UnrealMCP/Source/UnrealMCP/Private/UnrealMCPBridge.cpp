@@ -1,5 +1,7 @@
 #include "UnrealMCPBridge.h"
 #include "MCPServerRunnable.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPSettings.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "HAL/RunnableThread.h"
@@ -22,6 +24,7 @@
 #include "Engine/Selection.h"
 #include "Kismet/GameplayStatics.h"
 #include "Async/Async.h"
+#include "ScopedTransaction.h"
 // Add Blueprint related includes
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -57,11 +60,19 @@
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "UnrealMCPResponseWriter.h"
+#include "UnrealMCPMallocCounter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 // Default settings
 #define MCP_SERVER_HOST "127.0.0.1"
 #define MCP_SERVER_PORT 55557
 
+// Streamed responses larger than this don't keep their buffer around for the next one
+static const int32 MaxRetainedStreamBufferSize = 4 * 1024 * 1024;
+
 UUnrealMCPBridge::UUnrealMCPBridge()
 {
     EditorCommands = MakeShared<FUnrealMCPEditorCommands>();
@@ -69,6 +80,8 @@ UUnrealMCPBridge::UUnrealMCPBridge()
     BlueprintNodeCommands = MakeShared<FUnrealMCPBlueprintNodeCommands>();
     ProjectCommands = MakeShared<FUnrealMCPProjectCommands>();
     UMGCommands = MakeShared<FUnrealMCPUMGCommands>();
+
+    RegisterCommands();
 }
 
 UUnrealMCPBridge::~UUnrealMCPBridge()
@@ -80,27 +93,110 @@ UUnrealMCPBridge::~UUnrealMCPBridge()
     UMGCommands.Reset();
 }
 
+// Build the command table from the bridge's own commands and every handler class
+void UUnrealMCPBridge::RegisterCommands()
+{
+    CommandRegistry.Register(TEXT("ping"), TEXT("server"), FUnrealMCPCommandHandler::CreateLambda([](const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+        return ResultJson;
+    }), EUnrealMCPCommandThread::AnyThread);
+    CommandRegistry.Register(TEXT("batch"), TEXT("server"), FUnrealMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleBatchCommand));
+    CommandRegistry.Register(TEXT("list_commands"), TEXT("server"), FUnrealMCPCommandHandler::CreateLambda([this](const TSharedPtr<FJsonObject>& Params)
+    {
+        // The registry is only written during construction, so reading it from any thread is safe
+        return CommandRegistry.ListCommands();
+    }), EUnrealMCPCommandThread::AnyThread);
+    CommandRegistry.Register(TEXT("get_cache_stats"), TEXT("server"), FUnrealMCPCommandHandler::CreateLambda([this](const TSharedPtr<FJsonObject>& Params)
+    {
+        TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetObjectField(TEXT("blueprints"), AssetCache.GetStats());
+        return ResultJson;
+    }));
+    CommandRegistry.Register(TEXT("benchmark_serialization"), TEXT("server"), FUnrealMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleBenchmarkSerialization));
+    CommandRegistry.Register(TEXT("set_log_options"), TEXT("server"), FUnrealMCPCommandHandler::CreateLambda([](const TSharedPtr<FJsonObject>& Params)
+    {
+        // Omitted options keep their current values; the options only live until the editor restarts
+        UnrealMCPLog::FPayloadLogOptions Options = UnrealMCPLog::GetPayloadLogOptions();
+        Params->TryGetBoolField(TEXT("log_payloads"), Options.bEnabled);
+        Params->TryGetNumberField(TEXT("max_payload_length"), Options.MaxLength);
+        Params->TryGetNumberField(TEXT("sample_interval"), Options.SampleInterval);
+        UnrealMCPLog::SetPayloadLogOptions(Options);
+        
+        Options = UnrealMCPLog::GetPayloadLogOptions();
+        TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetBoolField(TEXT("log_payloads"), Options.bEnabled);
+        ResultJson->SetNumberField(TEXT("max_payload_length"), Options.MaxLength);
+        ResultJson->SetNumberField(TEXT("sample_interval"), Options.SampleInterval);
+        return ResultJson;
+    }), EUnrealMCPCommandThread::AnyThread);
+    CommandRegistry.Register(TEXT("get_server_stats"), TEXT("server"), FUnrealMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleGetServerStats), EUnrealMCPCommandThread::AnyThread);
+    CommandRegistry.Register(TEXT("begin_transaction"), TEXT("server"), FUnrealMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleBeginTransaction));
+    CommandRegistry.Register(TEXT("end_transaction"), TEXT("server"), FUnrealMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleEndTransaction));
+    CommandRegistry.Register(TEXT("start_trace_recording"), TEXT("server"), FUnrealMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleStartTraceRecording), EUnrealMCPCommandThread::AnyThread);
+    CommandRegistry.Register(TEXT("stop_trace_recording"), TEXT("server"), FUnrealMCPCommandHandler::CreateUObject(this, &UUnrealMCPBridge::HandleStopTraceRecording), EUnrealMCPCommandThread::AnyThread);
+
+    EditorCommands->RegisterCommands(CommandRegistry);
+    BlueprintCommands->RegisterCommands(CommandRegistry);
+    BlueprintNodeCommands->RegisterCommands(CommandRegistry);
+    ProjectCommands->RegisterCommands(CommandRegistry);
+    UMGCommands->RegisterCommands(CommandRegistry);
+}
+
 // Initialize subsystem
 void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Initializing"));
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Initializing"));
     
     bIsRunning = false;
     ListenerSocket = nullptr;
-    ConnectionSocket = nullptr;
     ServerThread = nullptr;
     Port = MCP_SERVER_PORT;
     FIPv4Address::Parse(MCP_SERVER_HOST, ServerAddress);
 
-    // Start the server automatically
-    StartServer();
+    GetDefault<UUnrealMCPSettings>()->ApplyLogOptions();
+
+    TArray<FName> CommandNames;
+    CommandRegistry.GetCommandNames(CommandNames);
+    ServerStats = MakeShared<FUnrealMCPServerStats, ESPMode::ThreadSafe>(CommandNames);
+
+    TraceRecorder = MakeShared<FUnrealMCPTraceRecorder, ESPMode::ThreadSafe>();
+    if (GetDefault<UUnrealMCPSettings>()->bRecordTrace)
+    {
+        FString Error;
+        if (!TraceRecorder->Start(FUnrealMCPTraceRecorder::GetDefaultFilePath(), Error))
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: %s"), *Error);
+        }
+    }
+
+    ActorIndex.Initialize();
+    CompileScheduler.Initialize();
+    AssetCache.Initialize();
+    ClassIndex.Initialize();
+    TransactionManager.Initialize();
+
+    // Start the server automatically, except in commandlets such as UnrealMCPReplay,
+    // which call ExecuteCommand directly and may run next to an editor that owns the port
+    if (!IsRunningCommandlet())
+    {
+        StartServer();
+    }
 }
 
 // Clean up resources when subsystem is destroyed
 void UUnrealMCPBridge::Deinitialize()
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Shutting down"));
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Shutting down"));
     StopServer();
+    WriteServerStatsCsv();
+    TraceRecorder->Stop();
+    TransactionManager.Shutdown();
+    CompileScheduler.Shutdown();
+    AssetCache.Shutdown();
+    ClassIndex.Shutdown();
+    ActorIndex.Shutdown();
 }
 
 // Start the MCP server
@@ -108,7 +204,7 @@ void UUnrealMCPBridge::StartServer()
 {
     if (bIsRunning)
     {
-        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Server is already running"));
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Server is already running"));
         return;
     }
 
@@ -116,7 +212,7 @@ void UUnrealMCPBridge::StartServer()
     ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
     if (!SocketSubsystem)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to get socket subsystem"));
         return;
     }
 
@@ -124,32 +220,33 @@ void UUnrealMCPBridge::StartServer()
     TSharedPtr<FSocket> NewListenerSocket = MakeShareable(SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealMCPListener"), false));
     if (!NewListenerSocket.IsValid())
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create listener socket"));
         return;
     }
 
     // Allow address reuse for quick restarts
     NewListenerSocket->SetReuseAddr(true);
-    NewListenerSocket->SetNonBlocking(true);
+    // Blocking so the server thread sleeps in Accept() instead of polling
+    NewListenerSocket->SetNonBlocking(false);
 
     // Bind to address
     FIPv4Endpoint Endpoint(ServerAddress, Port);
     if (!NewListenerSocket->Bind(*Endpoint.ToInternetAddr()))
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *ServerAddress.ToString(), Port);
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to bind listener socket to %s:%d"), *ServerAddress.ToString(), Port);
         return;
     }
 
     // Start listening
     if (!NewListenerSocket->Listen(5))
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
         return;
     }
 
     ListenerSocket = NewListenerSocket;
     bIsRunning = true;
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
 
     // Start server thread
     ServerThread = FRunnableThread::Create(
@@ -160,7 +257,7 @@ void UUnrealMCPBridge::StartServer()
 
     if (!ServerThread)
     {
-        UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPBridge: Failed to create server thread"));
         StopServer();
         return;
     }
@@ -176,7 +273,7 @@ void UUnrealMCPBridge::StopServer()
 
     bIsRunning = false;
 
-    // Clean up thread
+    // Clean up thread; the server runnable closes its client sessions on the way out
     if (ServerThread)
     {
         ServerThread->Kill(true);
@@ -185,149 +282,554 @@ void UUnrealMCPBridge::StopServer()
     }
 
     // Close sockets
-    if (ConnectionSocket.IsValid())
-    {
-        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ConnectionSocket.Get());
-        ConnectionSocket.Reset();
-    }
-
     if (ListenerSocket.IsValid())
     {
         ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenerSocket.Get());
         ListenerSocket.Reset();
     }
 
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server stopped"));
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Server stopped"));
 }
 
 // Execute a command received from a client
-FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+FUnrealMCPResponse UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, MCPProtocol::EMCPPayloadEncoding Encoding, const FUnrealMCPCommandTiming& Timing)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+    
+    FUnrealMCPCommandTiming QueuedTiming = Timing;
+    QueuedTiming.Enqueued = FPlatformTime::Cycles64();
+    
+    // Thread-safe commands run right here. So does everything when we are already on the
+    // game thread (e.g. called from editor scripting): queueing and waiting would deadlock.
+    if (GetCommandThread(CommandType) == EUnrealMCPCommandThread::AnyThread || IsInGameThread())
+    {
+        return ExecuteQueuedCommand(CommandType, Params, nullptr, QueuedTiming, Encoding);
+    }
     
     // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
+    TPromise<FUnrealMCPResponse> Promise;
+    TFuture<FUnrealMCPResponse> Future = Promise.GetFuture();
     
     // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, QueuedTiming, Encoding, Promise = MoveTemp(Promise)]() mutable
     {
-        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+        Promise.SetValue(ExecuteQueuedCommand(CommandType, Params, nullptr, QueuedTiming, Encoding));
+    });
+    
+    return Future.Get();
+}
+
+// Queue a command without waiting for its result
+void UUnrealMCPBridge::ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId, MCPProtocol::EMCPPayloadEncoding Encoding, const FUnrealMCPCommandTiming& Timing, TFunction<void(FUnrealMCPResponse&&)> OnComplete)
+{
+    UE_LOG(LogUnrealMCP, Verbose, TEXT("UnrealMCPBridge: Queueing command: %s"), *CommandType);
+    
+    FUnrealMCPCommandTiming QueuedTiming = Timing;
+    QueuedTiming.Enqueued = FPlatformTime::Cycles64();
+    
+    if (GetCommandThread(CommandType) == EUnrealMCPCommandThread::AnyThread)
+    {
+        OnComplete(ExecuteQueuedCommand(CommandType, Params, RequestId, QueuedTiming, Encoding));
+        return;
+    }
+    
+    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, RequestId, QueuedTiming, Encoding, OnComplete = MoveTemp(OnComplete)]()
+    {
+        OnComplete(ExecuteQueuedCommand(CommandType, Params, RequestId, QueuedTiming, Encoding));
+    });
+}
+
+// Pick the lane a command runs on
+EUnrealMCPCommandThread UUnrealMCPBridge::GetCommandThread(const FString& CommandType) const
+{
+    // Unknown commands only produce an error, which needs no game thread either
+    const FUnrealMCPCommand* Command = CommandRegistry.Find(CommandType);
+    return Command ? Command->Thread : EUnrealMCPCommandThread::AnyThread;
+}
+
+// Route a command to its handler and build the response
+FUnrealMCPResponse UUnrealMCPBridge::ExecuteQueuedCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId, const FUnrealMCPCommandTiming& Timing, MCPProtocol::EMCPPayloadEncoding Encoding)
+{
+    const EUnrealMCPCommandThread Thread = GetCommandThread(CommandType);
+    check(Thread == EUnrealMCPCommandThread::AnyThread || IsInGameThread());
+    
+    FUnrealMCPResponse Response;
+    Response.Command = FName(*CommandType, FNAME_Find);
+    Response.Timing = Timing;
+    Response.Timing.Started = FPlatformTime::Cycles64();
+    
+    // Commands keep an open undo group alive; only the game thread may touch it
+    if (IsInGameThread() && CommandType != TEXT("end_transaction"))
+    {
+        TransactionManager.NoteCommand();
+    }
+    
+    // Time spent waiting for the lane, e.g. for the game thread to finish its current frame
+    const double QueueTimeMs = FPlatformTime::ToMilliseconds64(Response.Timing.Started - Response.Timing.Enqueued);
+    
+    // Bulk commands write the whole response, envelope included, straight into the payload
+    const FUnrealMCPCommand* Command = CommandRegistry.Find(CommandType);
+    if (Command && Command->StreamingHandler.IsBound())
+    {
+        // The game thread reuses one buffer, so a response costs one exact-size copy instead of repeated growth
+        TArray<uint8> LocalBuffer;
+        TArray<uint8>& Buffer = IsInGameThread() ? StreamBuffer : LocalBuffer;
+        Buffer.Reset();
         
-        try
+        FString ErrorMessage;
+        const bool bStreamed = StreamCommandResponse(*Command, Params, RequestId, Thread, QueueTimeMs, Encoding, Buffer, ErrorMessage);
+        if (bStreamed)
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            
-            if (CommandType == TEXT("ping"))
-            {
-                ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-            }
-            // Editor Commands (including actor manipulation)
-            else if (CommandType == TEXT("get_actors_in_level") || 
-                     CommandType == TEXT("find_actors_by_name") ||
-                     CommandType == TEXT("spawn_actor") ||
-                     CommandType == TEXT("create_actor") ||
-                     CommandType == TEXT("delete_actor") || 
-                     CommandType == TEXT("set_actor_transform") ||
-                     CommandType == TEXT("get_actor_properties") ||
-                     CommandType == TEXT("set_actor_property") ||
-                     CommandType == TEXT("spawn_blueprint_actor") ||
-                     CommandType == TEXT("focus_viewport") || 
-                     CommandType == TEXT("take_screenshot") ||
-                     CommandType == TEXT("set_actor_material"))
-            {
-                ResultJson = EditorCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Commands
-            else if (CommandType == TEXT("create_blueprint") || 
-                     CommandType == TEXT("add_component_to_blueprint") || 
-                     CommandType == TEXT("set_component_property") || 
-                     CommandType == TEXT("set_physics_properties") || 
-                     CommandType == TEXT("compile_blueprint") || 
-                     CommandType == TEXT("set_blueprint_property") || 
-                     CommandType == TEXT("set_static_mesh_properties") ||
-                     CommandType == TEXT("set_pawn_properties"))
-            {
-                ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Node Commands
-            else if (CommandType == TEXT("connect_blueprint_nodes") || 
-                     CommandType == TEXT("add_blueprint_get_self_component_reference") ||
-                     CommandType == TEXT("add_blueprint_self_reference") ||
-                     CommandType == TEXT("find_blueprint_nodes") ||
-                     CommandType == TEXT("add_blueprint_event_node") ||
-                     CommandType == TEXT("add_blueprint_input_action_node") ||
-                     CommandType == TEXT("add_blueprint_function_node") ||
-                     CommandType == TEXT("add_blueprint_get_component_node") ||
-                     CommandType == TEXT("add_blueprint_variable"))
-            {
-                ResultJson = BlueprintNodeCommands->HandleCommand(CommandType, Params);
-            }
-            // Project Commands
-            else if (CommandType == TEXT("create_input_mapping"))
-            {
-                ResultJson = ProjectCommands->HandleCommand(CommandType, Params);
-            }
-            // UMG Commands
-            else if (CommandType == TEXT("create_umg_widget_blueprint") ||
-                     CommandType == TEXT("add_text_block_to_widget") ||
-                     CommandType == TEXT("add_button_to_widget") ||
-                     CommandType == TEXT("bind_widget_event") ||
-                     CommandType == TEXT("set_text_block_binding") ||
-                     CommandType == TEXT("add_widget_to_viewport"))
-            {
-                ResultJson = UMGCommands->HandleCommand(CommandType, Params);
-            }
-            else
+            Response.Payload = Buffer;
+            Response.Encoding = Encoding;
+        }
+        else
+        {
+            // Whatever the handler wrote before failing is dropped
+            Response.Object = MakeShareable(new FJsonObject);
+            Response.Object->SetStringField(TEXT("status"), TEXT("error"));
+            Response.Object->SetStringField(TEXT("error"), ErrorMessage);
+        }
+        
+        if (&Buffer == &StreamBuffer && StreamBuffer.Max() > MaxRetainedStreamBufferSize)
+        {
+            StreamBuffer.Empty();
+        }
+        
+        if (bStreamed)
+        {
+            Response.Timing.Handled = FPlatformTime::Cycles64();
+            return Response;
+        }
+    }
+    else
+    {
+        // While a begin_transaction group is open, the command's edits get an undo record of their own,
+        // closed before the response goes out so the editor never waits inside a transaction
+        const bool bGroupedCommand = IsInGameThread() && TransactionManager.BeginCommand(CommandType);
+        Response.Object = BuildCommandResponse(CommandType, Params);
+        if (bGroupedCommand)
+        {
+            TransactionManager.EndCommand();
+        }
+    }
+    
+    TSharedPtr<FJsonObject>& ResponseJson = Response.Object;
+    ResponseJson->SetStringField(TEXT("lane"), LexToString(Thread));
+    ResponseJson->SetNumberField(TEXT("queue_time_ms"), QueueTimeMs);
+    
+    // Echo the request id so pipelining clients can match responses to requests
+    if (RequestId.IsValid())
+    {
+        ResponseJson->SetField(TEXT("id"), RequestId);
+    }
+    
+    Response.Timing.Handled = FPlatformTime::Cycles64();
+    return Response;
+}
+
+// Write a streaming command's response without building an object tree
+bool UUnrealMCPBridge::StreamCommandResponse(const FUnrealMCPCommand& Command, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId, EUnrealMCPCommandThread Thread, double QueueTimeMs, MCPProtocol::EMCPPayloadEncoding Encoding, TArray<uint8>& OutPayload, FString& OutError)
+{
+    // Same fields, in the same order, as the responses built by BuildCommandResponse and ExecuteQueuedCommand
+    FUnrealMCPResponseWriter Writer(OutPayload, Encoding);
+    Writer.WriteObjectStart();
+    Writer.WriteValue(TEXT("status"), TEXT("success"));
+    Writer.WriteObjectStart(TEXT("result"));
+    
+    if (!Command.StreamingHandler.Execute(Params, Writer, OutError))
+    {
+        return false;
+    }
+    
+    Writer.WriteObjectEnd();
+    Writer.WriteValue(TEXT("lane"), LexToString(Thread));
+    Writer.WriteValue(TEXT("queue_time_ms"), QueueTimeMs);
+    if (RequestId.IsValid())
+    {
+        Writer.WriteJsonValue(TEXT("id"), RequestId);
+    }
+    Writer.WriteObjectEnd();
+    Writer.Close();
+    return true;
+}
+
+// Run a command and wrap its result in a {status, result|error} object
+TSharedPtr<FJsonObject> UUnrealMCPBridge::BuildCommandResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+    
+    try
+    {
+        TSharedPtr<FJsonObject> ResultJson = RouteCommand(CommandType, Params);
+        
+        // Check if the result contains an error
+        bool bSuccess = true;
+        FString ErrorMessage;
+        
+        if (ResultJson->HasField(TEXT("success")))
+        {
+            bSuccess = ResultJson->GetBoolField(TEXT("success"));
+            if (!bSuccess && ResultJson->HasField(TEXT("error")))
             {
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-                
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                Promise.SetValue(ResultString);
-                return;
+                ErrorMessage = ResultJson->GetStringField(TEXT("error"));
             }
-            
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (ResultJson->HasField(TEXT("success")))
+        }
+        
+        if (bSuccess)
+        {
+            // Set success status and include the result
+            ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+            ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+        }
+        else
+        {
+            // Set error status and include the error message
+            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+            ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+        ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+    }
+    
+    return ResponseJson;
+}
+
+// Route a command to the handler that implements it
+TSharedPtr<FJsonObject> UUnrealMCPBridge::RouteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    const FUnrealMCPCommand* Command = CommandRegistry.Find(CommandType);
+    if (!Command)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+    }
+    
+    if (Command->StreamingHandler.IsBound())
+    {
+        // Callers that need the result as an object, such as batch, get a tree built by the writer
+        FUnrealMCPResponseWriter Writer;
+        Writer.WriteObjectStart();
+        FString ErrorMessage;
+        if (!Command->StreamingHandler.Execute(Params, Writer, ErrorMessage))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage);
+        }
+        Writer.WriteObjectEnd();
+        Writer.Close();
+        return Writer.GetObject();
+    }
+    
+    return Command->Handler.Execute(Params);
+}
+
+// Run a list of commands inside the current game-thread task
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBatchCommand(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+    if (!Params->TryGetArrayField(TEXT("commands"), Commands))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'commands' parameter"));
+    }
+    
+    bool bStopOnError = false;
+    Params->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+    
+    bool bUseTransaction = true;
+    Params->TryGetBoolField(TEXT("transaction"), bUseTransaction);
+    
+    FString TransactionName = TEXT("MCP Batch");
+    Params->TryGetStringField(TEXT("transaction_name"), TransactionName);
+    
+    // One undo record for the whole batch, unless it is already recorded as a command of an open group
+    TUniquePtr<FScopedTransaction> Transaction;
+    if (bUseTransaction && !TransactionManager.IsOpen())
+    {
+        Transaction = MakeUnique<FScopedTransaction>(FUnrealMCPTransactionManager::TransactionContext, FText::FromString(TransactionName), nullptr);
+    }
+    
+    TArray<TSharedPtr<FJsonValue>> Results;
+    Results.Reserve(Commands->Num());
+    int32 FailedCount = 0;
+    bool bStopped = false;
+    
+    for (const TSharedPtr<FJsonValue>& CommandValue : *Commands)
+    {
+        TSharedPtr<FJsonObject> ItemResponse;
+        
+        const TSharedPtr<FJsonObject>* CommandObject = nullptr;
+        FString ItemType;
+        if (!CommandValue->TryGetObject(CommandObject) || !(*CommandObject)->TryGetStringField(TEXT("type"), ItemType))
+        {
+            ItemResponse = MakeShareable(new FJsonObject);
+            ItemResponse->SetStringField(TEXT("status"), TEXT("error"));
+            ItemResponse->SetStringField(TEXT("error"), TEXT("Batch entry must be an object with a 'type' field"));
+        }
+        else if (ItemType == TEXT("batch"))
+        {
+            ItemResponse = MakeShareable(new FJsonObject);
+            ItemResponse->SetStringField(TEXT("status"), TEXT("error"));
+            ItemResponse->SetStringField(TEXT("error"), TEXT("Batches cannot be nested"));
+        }
+        else
+        {
+            TSharedPtr<FJsonObject> ItemParams = MakeShareable(new FJsonObject);
+            const TSharedPtr<FJsonObject>* ItemParamsObject = nullptr;
+            if ((*CommandObject)->TryGetObjectField(TEXT("params"), ItemParamsObject))
             {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess && ResultJson->HasField(TEXT("error")))
-                {
-                    ErrorMessage = ResultJson->GetStringField(TEXT("error"));
-                }
+                ItemParams = *ItemParamsObject;
             }
             
-            if (bSuccess)
-            {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
-            }
-            else
+            ItemResponse = BuildCommandResponse(ItemType, ItemParams);
+        }
+        
+        Results.Add(MakeShared<FJsonValueObject>(ItemResponse));
+        
+        if (ItemResponse->GetStringField(TEXT("status")) != TEXT("success"))
+        {
+            ++FailedCount;
+            if (bStopOnError)
             {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+                bStopped = true;
+                break;
             }
         }
-        catch (const std::exception& e)
+    }
+    
+    if (Transaction.IsValid())
+    {
+        Transaction.Reset();
+        TransactionManager.EnforceMemoryBudget();
+    }
+    
+    // Compile each Blueprint the batch edited once, rather than once per edit
+    int32 CompilesAvoided = 0;
+    const int32 CompiledCount = CompileScheduler.FlushAll(&CompilesAvoided);
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetArrayField(TEXT("results"), Results);
+    ResultJson->SetNumberField(TEXT("executed"), Results.Num());
+    ResultJson->SetNumberField(TEXT("failed"), FailedCount);
+    ResultJson->SetBoolField(TEXT("stopped"), bStopped);
+    ResultJson->SetNumberField(TEXT("blueprints_compiled"), CompiledCount);
+    ResultJson->SetNumberField(TEXT("compiles_avoided"), CompilesAvoided);
+    ResultJson->SetBoolField(TEXT("transaction"), bUseTransaction);
+    return ResultJson;
+}
+
+// Compare building a response as an object tree with streaming it
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBenchmarkSerialization(const TSharedPtr<FJsonObject>& Params)
+{
+    FString CommandType;
+    if (!Params->TryGetStringField(TEXT("command"), CommandType))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'command' parameter"));
+    }
+    
+    const FUnrealMCPCommand* Command = CommandRegistry.Find(CommandType);
+    if (!Command || !Command->StreamingHandler.IsBound())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("'%s' is not a streaming command"), *CommandType));
+    }
+    
+    TSharedPtr<FJsonObject> CommandParams = MakeShareable(new FJsonObject);
+    const TSharedPtr<FJsonObject>* CommandParamsObject = nullptr;
+    if (Params->TryGetObjectField(TEXT("params"), CommandParamsObject))
+    {
+        CommandParams = *CommandParamsObject;
+    }
+    
+    FString EncodingName = TEXT("json");
+    Params->TryGetStringField(TEXT("encoding"), EncodingName);
+    MCPProtocol::EMCPPayloadEncoding Encoding = MCPProtocol::EMCPPayloadEncoding::Json;
+    if (!MCPProtocol::LexTryParseEncoding(EncodingName, Encoding))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown encoding '%s'"), *EncodingName));
+    }
+    
+    int32 Iterations = 10;
+    Params->TryGetNumberField(TEXT("iterations"), Iterations);
+    Iterations = FMath::Clamp(Iterations, 1, 1000);
+    
+    // A failing command would only measure how fast it fails
+    FString ErrorMessage;
+    StreamBuffer.Reset();
+    if (!StreamCommandResponse(*Command, CommandParams, nullptr, EUnrealMCPCommandThread::GameThread, 0.0, Encoding, StreamBuffer, ErrorMessage))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ErrorMessage);
+    }
+    
+    FUnrealMCPMallocCounter& MallocCounter = FUnrealMCPMallocCounter::Get();
+    
+    // Runs Build once to warm caches, then Iterations times while counting allocations
+    auto Measure = [Iterations, &MallocCounter](TFunctionRef<int32()> Build)
+    {
+        Build();
+        
+        MallocCounter.Begin();
+        const double StartTime = FPlatformTime::Seconds();
+        int32 Bytes = 0;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
         {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+            Bytes = Build();
         }
+        const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+        const int64 Allocations = MallocCounter.End();
         
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
+        TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetNumberField(TEXT("ms_per_call"), ElapsedMs / Iterations);
+        ResultJson->SetNumberField(TEXT("allocations_per_call"), static_cast<double>(Allocations) / Iterations);
+        ResultJson->SetNumberField(TEXT("bytes"), Bytes);
+        return ResultJson;
+    };
+    
+    // What a command without a streaming handler costs: a result tree, the envelope around it, then encoding
+    TSharedPtr<FJsonObject> TreeJson = Measure([this, &CommandType, &CommandParams, Encoding]()
+    {
+        TSharedPtr<FJsonObject> ResponseJson = BuildCommandResponse(CommandType, CommandParams);
+        ResponseJson->SetStringField(TEXT("lane"), LexToString(EUnrealMCPCommandThread::GameThread));
+        ResponseJson->SetNumberField(TEXT("queue_time_ms"), 0.0);
+        
+        TArray<uint8> Payload;
+        MCPProtocol::EncodePayload(ResponseJson.ToSharedRef(), Encoding, Payload);
+        return Payload.Num();
     });
     
-    return Future.Get();
-}
\ No newline at end of file
+    // What ExecuteQueuedCommand does for a streaming command
+    TSharedPtr<FJsonObject> StreamingJson = Measure([this, Command, &CommandParams, Encoding, &ErrorMessage]()
+    {
+        StreamBuffer.Reset();
+        StreamCommandResponse(*Command, CommandParams, nullptr, EUnrealMCPCommandThread::GameThread, 0.0, Encoding, StreamBuffer, ErrorMessage);
+        
+        TArray<uint8> Payload = StreamBuffer;
+        return Payload.Num();
+    });
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetStringField(TEXT("command"), CommandType);
+    ResultJson->SetStringField(TEXT("encoding"), EncodingName.ToLower());
+    ResultJson->SetNumberField(TEXT("iterations"), Iterations);
+    ResultJson->SetObjectField(TEXT("tree"), TreeJson);
+    ResultJson->SetObjectField(TEXT("streaming"), StreamingJson);
+    return ResultJson;
+}
+
+// Report the per-command latency statistics
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleGetServerStats(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!ServerStats.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Server statistics are not available"));
+    }
+    
+    FString CommandFilter;
+    Params->TryGetStringField(TEXT("command"), CommandFilter);
+    
+    // The statistics reported are the ones being discarded, so a nightly run can read and reset in one call
+    TSharedPtr<FJsonObject> ResultJson = ServerStats->ToJson(CommandFilter);
+    
+    bool bReset = false;
+    if (Params->TryGetBoolField(TEXT("reset"), bReset) && bReset)
+    {
+        ServerStats->Reset();
+    }
+    ResultJson->SetBoolField(TEXT("reset"), bReset);
+    return ResultJson;
+}
+
+// Open an undo group spanning the commands that follow
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBeginTransaction(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Description = TEXT("MCP Edit");
+    Params->TryGetStringField(TEXT("name"), Description);
+    
+    FString Error;
+    if (!TransactionManager.Begin(Description, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    return TransactionManager.GetStats();
+}
+
+// Close the undo group, keeping its edits or reverting them
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleEndTransaction(const TSharedPtr<FJsonObject>& Params)
+{
+    bool bUndo = false;
+    Params->TryGetBoolField(TEXT("undo"), bUndo);
+    
+    int32 Commands = 0;
+    FString Error;
+    if (!TransactionManager.End(bUndo, Commands, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = TransactionManager.GetStats();
+    ResultJson->SetNumberField(TEXT("commands"), Commands);
+    ResultJson->SetBoolField(TEXT("undone"), bUndo);
+    return ResultJson;
+}
+
+// Record the requests answered from now on
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleStartTraceRecording(const TSharedPtr<FJsonObject>& Params)
+{
+    FString FilePath;
+    if (!Params->TryGetStringField(TEXT("path"), FilePath) || FilePath.IsEmpty())
+    {
+        FilePath = FUnrealMCPTraceRecorder::GetDefaultFilePath();
+    }
+    else if (FPaths::IsRelative(FilePath))
+    {
+        FilePath = FPaths::ProjectSavedDir() / TEXT("UnrealMCP") / TEXT("Traces") / FilePath;
+    }
+    FilePath = FPaths::ConvertRelativePathToFull(FilePath);
+    
+    FString Error;
+    if (!TraceRecorder->Start(FilePath, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetBoolField(TEXT("recording"), true);
+    ResultJson->SetStringField(TEXT("path"), FilePath);
+    return ResultJson;
+}
+
+// Close the trace; this command's own response is no longer recorded
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleStopTraceRecording(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!TraceRecorder->IsRecording())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("No trace is being recorded"));
+    }
+    
+    const int64 NumRecords = TraceRecorder->Stop();
+    
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetBoolField(TEXT("recording"), false);
+    ResultJson->SetStringField(TEXT("path"), TraceRecorder->GetFilePath());
+    ResultJson->SetNumberField(TEXT("requests"), (double)NumRecords);
+    return ResultJson;
+}
+
+// Keep the session's latency statistics after the editor closes
+void UUnrealMCPBridge::WriteServerStatsCsv() const
+{
+    if (!ServerStats.IsValid() || !GetDefault<UUnrealMCPSettings>()->bWriteServerStatsOnShutdown)
+    {
+        return;
+    }
+    
+    const FString FilePath = FPaths::ProjectSavedDir() / TEXT("UnrealMCP") / FString::Printf(TEXT("ServerStats-%s.csv"), *FDateTime::Now().ToString());
+    if (FFileHelper::SaveStringToFile(ServerStats->ToCsv(), *FilePath))
+    {
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPBridge: Wrote server statistics to %s"), *FilePath);
+    }
+    else
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPBridge: Failed to write server statistics to %s"), *FilePath);
+    }
+}
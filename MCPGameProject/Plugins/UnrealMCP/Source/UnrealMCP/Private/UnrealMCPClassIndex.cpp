@@ -0,0 +1,280 @@
+#include "UnrealMCPClassIndex.h"
+#include "UnrealMCPLog.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+    /** Edit distance between two lower-case strings, giving up once it exceeds MaxDistance */
+    int32 EditDistance(const FString& A, const FString& B, int32 MaxDistance)
+    {
+        if (FMath::Abs(A.Len() - B.Len()) > MaxDistance)
+        {
+            return MaxDistance + 1;
+        }
+
+        TArray<int32, TInlineAllocator<64>> Previous;
+        TArray<int32, TInlineAllocator<64>> Current;
+        Previous.SetNumUninitialized(B.Len() + 1);
+        Current.SetNumUninitialized(B.Len() + 1);
+        for (int32 j = 0; j <= B.Len(); ++j)
+        {
+            Previous[j] = j;
+        }
+
+        for (int32 i = 1; i <= A.Len(); ++i)
+        {
+            Current[0] = i;
+            int32 RowMinimum = Current[0];
+            for (int32 j = 1; j <= B.Len(); ++j)
+            {
+                const int32 Cost = A[i - 1] == B[j - 1] ? 0 : 1;
+                Current[j] = FMath::Min3(Previous[j] + 1, Current[j - 1] + 1, Previous[j - 1] + Cost);
+                RowMinimum = FMath::Min(RowMinimum, Current[j]);
+            }
+            if (RowMinimum > MaxDistance)
+            {
+                return MaxDistance + 1;
+            }
+            Swap(Previous, Current);
+        }
+        return Previous[B.Len()];
+    }
+
+    /** "UStaticMeshComponent" -> "StaticMeshComponent"; names without a C++ prefix are returned as they are */
+    FString StripClassPrefix(const FString& Name)
+    {
+        if (Name.Len() > 1 && (Name[0] == TEXT('U') || Name[0] == TEXT('A')) && FChar::IsUpper(Name[1]))
+        {
+            return Name.RightChop(1);
+        }
+        return Name;
+    }
+}
+
+FUnrealMCPClassIndex::FUnrealMCPClassIndex()
+    : bDirty(true)
+{
+}
+
+FUnrealMCPClassIndex::~FUnrealMCPClassIndex()
+{
+    Shutdown();
+}
+
+void FUnrealMCPClassIndex::Initialize()
+{
+    // New modules bring new native classes; hot reload replaces existing ones
+    ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([this](FName ModuleName, EModuleChangeReason Reason)
+    {
+        if (Reason == EModuleChangeReason::ModuleLoaded)
+        {
+            bDirty = true;
+        }
+    });
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason Reason)
+    {
+        bDirty = true;
+    });
+
+    Rebuild();
+}
+
+void FUnrealMCPClassIndex::Shutdown()
+{
+    if (FModuleManager* ModuleManager = FModuleManager::GetPtr())
+    {
+        ModuleManager->OnModulesChanged().Remove(ModulesChangedHandle);
+    }
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+
+    ModulesChangedHandle.Reset();
+    ReloadCompleteHandle.Reset();
+
+    ClassesByName.Reset();
+    bDirty = true;
+}
+
+UClass* FUnrealMCPClassIndex::FindClass(const FString& Name, const UClass* BaseClass)
+{
+    check(IsInGameThread());
+
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // Object paths such as /Script/Engine.Actor or /Game/BP_Door.BP_Door_C name the class exactly
+    if (Name.StartsWith(TEXT("/")))
+    {
+        UClass* Class = LoadObject<UClass>(nullptr, *Name);
+        return Class && (!BaseClass || Class->IsChildOf(BaseClass)) ? Class : nullptr;
+    }
+
+    EnsureUpToDate();
+
+    if (UClass* Class = FindIndexed(Name, BaseClass))
+    {
+        return Class;
+    }
+
+    // Only misses search the object table: the class may have been loaded since the index was built
+    const FString Stripped = StripClassPrefix(Name);
+    const FString Candidates[] = { Name, Stripped, Stripped + TEXT("Component"), Stripped + TEXT("_C") };
+    for (const FString& Candidate : Candidates)
+    {
+        UClass* Class = FindFirstObject<UClass>(*Candidate, EFindFirstObjectOptions::None);
+        if (Class && IsIndexable(Class))
+        {
+            AddClass(Class);
+        }
+    }
+
+    return FindIndexed(Name, BaseClass);
+}
+
+TArray<FString> FUnrealMCPClassIndex::GetSuggestions(const FString& Name, const UClass* BaseClass, int32 MaxSuggestions)
+{
+    check(IsInGameThread());
+    EnsureUpToDate();
+
+    const FString Needle = StripClassPrefix(Name).ToLower();
+    const int32 MaxDistance = FMath::Max(2, Needle.Len() / 3);
+
+    // Best score per class, so several aliases of one class produce one suggestion
+    TMap<UClass*, int32> Scores;
+    for (const TPair<FString, TArray<FEntry>>& Pair : ClassesByName)
+    {
+        const FString Key = Pair.Key.ToLower();
+
+        int32 Score = EditDistance(Needle, Key, MaxDistance);
+        if (Score > MaxDistance && Needle.Len() >= 3 && Key.Contains(Needle))
+        {
+            // "Mesh" should still suggest "StaticMeshComponent"; rank containment after close spellings
+            Score = MaxDistance + 1 + (Key.Len() - Needle.Len()) / 4;
+        }
+        else if (Score > MaxDistance)
+        {
+            continue;
+        }
+
+        for (const FEntry& Entry : Pair.Value)
+        {
+            UClass* Class = Entry.Class.Get();
+            if (Class && (!BaseClass || Class->IsChildOf(BaseClass)))
+            {
+                int32& BestScore = Scores.FindOrAdd(Class, MAX_int32);
+                BestScore = FMath::Min(BestScore, Score);
+            }
+        }
+    }
+
+    Scores.ValueSort([](int32 A, int32 B) { return A < B; });
+
+    TArray<FString> Suggestions;
+    for (const TPair<UClass*, int32>& Pair : Scores)
+    {
+        if (Suggestions.Num() >= MaxSuggestions)
+        {
+            break;
+        }
+        Suggestions.Add(Pair.Key->GetName());
+    }
+    return Suggestions;
+}
+
+void FUnrealMCPClassIndex::EnsureUpToDate()
+{
+    if (bDirty)
+    {
+        Rebuild();
+    }
+}
+
+void FUnrealMCPClassIndex::Rebuild()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    ClassesByName.Reset();
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        if (IsIndexable(*It))
+        {
+            AddClass(*It);
+        }
+    }
+    bDirty = false;
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPClassIndex: Indexed %d class names in %.1f ms"),
+        ClassesByName.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FUnrealMCPClassIndex::AddClass(UClass* Class)
+{
+    const FString Name = Class->GetName();
+    AddName(Name, Class, EMatch::Name);
+
+    // The C++ spelling, e.g. UStaticMeshComponent or APawn
+    AddName(Class->GetPrefixCPP() + Name, Class, EMatch::PrefixedName);
+
+    // Short forms commands commonly use: StaticMesh for StaticMeshComponent, BP_Door for BP_Door_C
+    if (Name.Len() > 9 && Name.EndsWith(TEXT("Component")))
+    {
+        AddName(Name.LeftChop(9), Class, EMatch::Alias);
+    }
+    else if (Name.Len() > 2 && Name.EndsWith(TEXT("_C")))
+    {
+        AddName(Name.LeftChop(2), Class, EMatch::Alias);
+    }
+}
+
+void FUnrealMCPClassIndex::AddName(const FString& Name, UClass* Class, EMatch Match)
+{
+    TArray<FEntry>& Entries = ClassesByName.FindOrAdd(Name);
+    for (const FEntry& Entry : Entries)
+    {
+        if (Entry.Class == Class)
+        {
+            return;
+        }
+    }
+    Entries.Add({ Class, Match });
+}
+
+UClass* FUnrealMCPClassIndex::FindIndexed(const FString& Name, const UClass* BaseClass) const
+{
+    const TArray<FEntry>* Entries = ClassesByName.Find(Name);
+    if (!Entries)
+    {
+        return nullptr;
+    }
+
+    UClass* BestClass = nullptr;
+    EMatch BestMatch = EMatch::Alias;
+    for (const FEntry& Entry : *Entries)
+    {
+        UClass* Class = Entry.Class.Get();
+        if (!IsValid(Class) || (BaseClass && !Class->IsChildOf(BaseClass)))
+        {
+            continue;
+        }
+        if (!BestClass || Entry.Match < BestMatch)
+        {
+            BestClass = Class;
+            BestMatch = Entry.Match;
+        }
+    }
+    return BestClass;
+}
+
+bool FUnrealMCPClassIndex::IsIndexable(const UClass* Class)
+{
+    if (Class->HasAnyClassFlags(CLASS_NewerVersionExists | CLASS_Deprecated))
+    {
+        return false;
+    }
+
+    const FString Name = Class->GetName();
+    return !Name.StartsWith(TEXT("SKEL_")) && !Name.StartsWith(TEXT("REINST_")) && !Name.StartsWith(TEXT("TRASHCLASS_"));
+}
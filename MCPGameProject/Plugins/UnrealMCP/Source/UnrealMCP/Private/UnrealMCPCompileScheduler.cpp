@@ -0,0 +1,187 @@
+#include "UnrealMCPCompileScheduler.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPSettings.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "EditorAssetLibrary.h"
+
+FUnrealMCPCompileScheduler::FUnrealMCPCompileScheduler()
+    : LastEditTime(0.0)
+    , TotalCompiles(0)
+    , TotalCompilesAvoided(0)
+{
+}
+
+FUnrealMCPCompileScheduler::~FUnrealMCPCompileScheduler()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+void FUnrealMCPCompileScheduler::Initialize()
+{
+    PendingEdits.Reset();
+    PendingSaves.Reset();
+    LastEditTime = 0.0;
+}
+
+void FUnrealMCPCompileScheduler::Shutdown()
+{
+    // The editor is going away; compiling now would only slow down shutdown
+    if (PendingEdits.Num() > 0)
+    {
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPCompileScheduler: Dropping %d pending Blueprint compile(s)"), PendingEdits.Num());
+        PendingEdits.Reset();
+    }
+
+    // Their packages stay dirty, so the editor still offers to save them
+    if (PendingSaves.Num() > 0)
+    {
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPCompileScheduler: Dropping %d pending Blueprint save(s)"), PendingSaves.Num());
+        PendingSaves.Reset();
+    }
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+void FUnrealMCPCompileScheduler::MarkDirty(UBlueprint* Blueprint, bool bSaveAfterCompile)
+{
+    check(IsInGameThread());
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    ++PendingEdits.FindOrAdd(Blueprint);
+    if (bSaveAfterCompile)
+    {
+        PendingSaves.Add(Blueprint);
+    }
+    LastEditTime = FPlatformTime::Seconds();
+
+    // The ticker only runs while something is pending, so an idle editor pays nothing
+    if (!TickerHandle.IsValid())
+    {
+        const float DebounceSeconds = GetDefault<UUnrealMCPSettings>()->CompileDebounceSeconds;
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FUnrealMCPCompileScheduler::Tick),
+            FMath::Max(DebounceSeconds, 0.0f));
+    }
+}
+
+bool FUnrealMCPCompileScheduler::IsPending(const UBlueprint* Blueprint) const
+{
+    return Blueprint && PendingEdits.Contains(Blueprint);
+}
+
+int32 FUnrealMCPCompileScheduler::Compile(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+    if (!Blueprint)
+    {
+        return 0;
+    }
+
+    // Without the scheduler every pending edit would have compiled on its own, before this compile
+    int32 Edits = 0;
+    PendingEdits.RemoveAndCopyValue(Blueprint, Edits);
+
+    CompileNow(Blueprint);
+    TotalCompilesAvoided += Edits;
+    return Edits;
+}
+
+void FUnrealMCPCompileScheduler::Flush(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+
+    int32 Edits = 0;
+    if (!Blueprint || !PendingEdits.RemoveAndCopyValue(Blueprint, Edits))
+    {
+        return;
+    }
+
+    // This compile stands in for the one the first edit would have run
+    CompileNow(Blueprint);
+    TotalCompilesAvoided += Edits - 1;
+}
+
+int32 FUnrealMCPCompileScheduler::FlushAll(int32* OutCompilesAvoided)
+{
+    check(IsInGameThread());
+
+    // Compiling can run editor callbacks that edit other Blueprints, so work on a snapshot
+    TMap<TWeakObjectPtr<UBlueprint>, int32> Snapshot = MoveTemp(PendingEdits);
+    PendingEdits.Reset();
+
+    int32 Compiled = 0;
+    int32 Avoided = 0;
+    for (const TPair<TWeakObjectPtr<UBlueprint>, int32>& Pair : Snapshot)
+    {
+        UBlueprint* Blueprint = Pair.Key.Get();
+        if (!IsValid(Blueprint))
+        {
+            continue;
+        }
+
+        CompileNow(Blueprint);
+        ++Compiled;
+        Avoided += Pair.Value - 1;
+    }
+
+    TotalCompilesAvoided += Avoided;
+
+    if (Compiled > 0)
+    {
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPCompileScheduler: Compiled %d Blueprint(s), %d compile(s) avoided"), Compiled, Avoided);
+    }
+
+    if (OutCompilesAvoided)
+    {
+        *OutCompilesAvoided = Avoided;
+    }
+    return Compiled;
+}
+
+void FUnrealMCPCompileScheduler::CompileNow(UBlueprint* Blueprint)
+{
+    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    ++TotalCompiles;
+
+    if (Blueprint->Status == BS_Error)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPCompileScheduler: Blueprint %s compiled with errors"), *Blueprint->GetName());
+    }
+
+    if (PendingSaves.Remove(Blueprint) > 0)
+    {
+        UEditorAssetLibrary::SaveLoadedAsset(Blueprint, false);
+    }
+}
+
+bool FUnrealMCPCompileScheduler::Tick(float DeltaTime)
+{
+    if (PendingEdits.Num() == 0)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    // Wait until edits stop arriving for the debounce period
+    const double DebounceSeconds = GetDefault<UUnrealMCPSettings>()->CompileDebounceSeconds;
+    if (FPlatformTime::Seconds() - LastEditTime < DebounceSeconds)
+    {
+        return true;
+    }
+
+    FlushAll();
+    TickerHandle.Reset();
+    return false;
+}
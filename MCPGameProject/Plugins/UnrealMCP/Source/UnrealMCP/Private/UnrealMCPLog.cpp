@@ -0,0 +1,82 @@
+#include "UnrealMCPLog.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY(LogUnrealMCP);
+
+namespace UnrealMCPLog
+{
+    namespace
+    {
+        std::atomic<bool> bPayloadLogEnabled(false);
+        std::atomic<int32> PayloadLogMaxLength(1024);
+        std::atomic<int32> PayloadLogSampleInterval(1);
+        std::atomic<uint32> PayloadCounters[2] = { {0}, {0} };
+
+        /** Checked before anything is converted or formatted, so disabled logging costs two loads */
+        bool ShouldLogPayload(EPayloadDirection Direction)
+        {
+            if (!bPayloadLogEnabled.load(std::memory_order_relaxed) || !UE_LOG_ACTIVE(LogUnrealMCP, Log))
+            {
+                return false;
+            }
+            const int32 SampleInterval = PayloadLogSampleInterval.load(std::memory_order_relaxed);
+            return SampleInterval <= 1 || PayloadCounters[static_cast<int32>(Direction)].fetch_add(1, std::memory_order_relaxed) % SampleInterval == 0;
+        }
+
+        void WritePayload(EPayloadDirection Direction, const FString& Payload, int32 Size, bool bTruncated)
+        {
+            const TCHAR* Label = Direction == EPayloadDirection::Received ? TEXT("MCPClientSession: Received") : TEXT("MCPClientSession: Sending response");
+            if (bTruncated)
+            {
+                UE_LOG(LogUnrealMCP, Log, TEXT("%s (%d bytes): %s..."), Label, Size, *Payload);
+            }
+            else
+            {
+                UE_LOG(LogUnrealMCP, Log, TEXT("%s (%d bytes): %s"), Label, Size, *Payload);
+            }
+        }
+    }
+
+    void SetPayloadLogOptions(const FPayloadLogOptions& Options)
+    {
+        bPayloadLogEnabled = Options.bEnabled;
+        PayloadLogMaxLength = FMath::Max(0, Options.MaxLength);
+        PayloadLogSampleInterval = FMath::Max(1, Options.SampleInterval);
+    }
+
+    FPayloadLogOptions GetPayloadLogOptions()
+    {
+        FPayloadLogOptions Options;
+        Options.bEnabled = bPayloadLogEnabled;
+        Options.MaxLength = PayloadLogMaxLength;
+        Options.SampleInterval = PayloadLogSampleInterval;
+        return Options;
+    }
+
+    void LogPayload(EPayloadDirection Direction, const uint8* Payload, int32 Size)
+    {
+        if (!ShouldLogPayload(Direction))
+        {
+            return;
+        }
+
+        // Only the logged prefix is converted; a multi-byte character cut in half is replaced
+        const int32 MaxLength = PayloadLogMaxLength;
+        const int32 LoggedSize = MaxLength > 0 ? FMath::Min(Size, MaxLength) : Size;
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Payload), LoggedSize);
+        WritePayload(Direction, FString(Converted.Length(), Converted.Get()), Size, LoggedSize < Size);
+    }
+
+    void LogPayload(EPayloadDirection Direction, const FString& Payload)
+    {
+        if (!ShouldLogPayload(Direction))
+        {
+            return;
+        }
+
+        // Error responses built as strings are short and ASCII, so characters stand in for bytes
+        const int32 MaxLength = PayloadLogMaxLength;
+        const bool bTruncated = MaxLength > 0 && Payload.Len() > MaxLength;
+        WritePayload(Direction, bTruncated ? Payload.Left(MaxLength) : Payload, Payload.Len(), bTruncated);
+    }
+}
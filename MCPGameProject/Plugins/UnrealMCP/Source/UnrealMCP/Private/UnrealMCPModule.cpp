@@ -1,4 +1,5 @@
 #include "UnrealMCPModule.h"
+#include "UnrealMCPLog.h"
 #include "UnrealMCPBridge.h"
 #include "Modules/ModuleManager.h"
 #include "EditorSubsystem.h"
@@ -8,12 +9,12 @@
 
 void FUnrealMCPModule::StartupModule()
 {
-	UE_LOG(LogTemp, Display, TEXT("Unreal MCP Module has started"));
+	UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP Module has started"));
 }
 
 void FUnrealMCPModule::ShutdownModule()
 {
-	UE_LOG(LogTemp, Display, TEXT("Unreal MCP Module has shut down"));
+	UE_LOG(LogUnrealMCP, Display, TEXT("Unreal MCP Module has shut down"));
 }
 
 #undef LOCTEXT_NAMESPACE
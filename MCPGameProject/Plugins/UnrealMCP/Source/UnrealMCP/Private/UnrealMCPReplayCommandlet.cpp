@@ -0,0 +1,238 @@
+#include "UnrealMCPReplayCommandlet.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPBridge.h"
+#include "UnrealMCPServerStats.h"
+#include "UnrealMCPTraceRecorder.h"
+#include "MCPProtocol.h"
+#include "Algo/StableSort.h"
+#include "Editor.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    // Requests whose status changed are listed individually up to this many
+    const int32 MaxReportedStatusChanges = 10;
+
+    /** Latency of one command in the recorded session */
+    struct FRecordedCommand
+    {
+        int64 Count = 0;
+        int64 Errors = 0;
+        uint64 TotalUs = 0;
+        uint32 MaxUs = 0;
+    };
+}
+
+UUnrealMCPReplayCommandlet::UUnrealMCPReplayCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Replays a request trace recorded by the Unreal MCP server");
+    HelpUsage = TEXT("UnrealEditor-Cmd <project> -run=UnrealMCPReplay -Trace=<file> [-MaxSpeed] [-Map=<map>] [-Output=<file.json>]");
+}
+
+int32 UUnrealMCPReplayCommandlet::Main(const FString& Params)
+{
+    FString TracePath;
+    if (!FParse::Value(*Params, TEXT("Trace="), TracePath))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPReplayCommandlet: Missing -Trace. Usage: %s"), *HelpUsage);
+        return 1;
+    }
+    const bool bMaxSpeed = FParse::Param(*Params, TEXT("MaxSpeed"));
+    FString OutputPath;
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    UUnrealMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UUnrealMCPBridge>() : nullptr;
+    if (!Bridge)
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPReplayCommandlet: The UnrealMCP bridge subsystem is not available"));
+        return 1;
+    }
+
+    TArray<FUnrealMCPTraceRecord> Records;
+    FString Error;
+    if (!FUnrealMCPTraceRecorder::Load(TracePath, Records, Error))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPReplayCommandlet: %s"), *Error);
+        return 1;
+    }
+    if (Records.Num() == 0)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPReplayCommandlet: %s holds no requests"), *TracePath);
+        return 0;
+    }
+
+    // Records are written as responses are sent, which with pipelined or concurrent sessions is not the
+    // order requests arrived in; replay them in arrival order, keeping the send order of simultaneous ones
+    Algo::StableSortBy(Records, &FUnrealMCPTraceRecord::TimestampUs);
+
+    // Commands that find actors by name need the level the session worked in
+    FString MapName;
+    if (FParse::Value(*Params, TEXT("Map="), MapName) && !UEditorLoadingAndSavingUtils::LoadMap(MapName))
+    {
+        UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPReplayCommandlet: Failed to load map %s"), *MapName);
+        return 1;
+    }
+
+    // Parse every request up front so parsing is not part of the replay
+    TArray<TSharedPtr<FJsonObject>> RequestParams;
+    TArray<FName> CommandNames;
+    TMap<FString, FRecordedCommand> RecordedCommands;
+    RequestParams.Reserve(Records.Num());
+    for (const FUnrealMCPTraceRecord& TraceRecord : Records)
+    {
+        TSharedPtr<FJsonObject> RequestParamsObject;
+        if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(TraceRecord.Params), RequestParamsObject) || !RequestParamsObject.IsValid())
+        {
+            UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPReplayCommandlet: Invalid parameters for %s, replaying it without any"), *TraceRecord.Command);
+            RequestParamsObject = MakeShareable(new FJsonObject);
+        }
+        RequestParams.Add(RequestParamsObject);
+        CommandNames.AddUnique(FName(*TraceRecord.Command));
+
+        FRecordedCommand& Recorded = RecordedCommands.FindOrAdd(TraceRecord.Command);
+        ++Recorded.Count;
+        Recorded.Errors += TraceRecord.bSucceeded ? 0 : 1;
+        Recorded.TotalUs += TraceRecord.LatencyUs;
+        Recorded.MaxUs = FMath::Max(Recorded.MaxUs, TraceRecord.LatencyUs);
+    }
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPReplayCommandlet: Replaying %d requests from %s at %s"),
+        Records.Num(), *TracePath, bMaxSpeed ? TEXT("maximum speed") : TEXT("the recorded pace"));
+
+    FUnrealMCPServerStats ReplayStats(CommandNames);
+    TArray<uint8> EncodeBuffer;
+    int32 NumFailed = 0;
+    int32 NumStatusChanged = 0;
+    const double FirstTimestampSeconds = Records[0].TimestampUs / 1000000.0;
+    const double ReplayStartSeconds = FPlatformTime::Seconds();
+
+    for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+    {
+        const FUnrealMCPTraceRecord& TraceRecord = Records[RecordIndex];
+        if (!bMaxSpeed)
+        {
+            const double Delay = ReplayStartSeconds + (TraceRecord.TimestampUs / 1000000.0 - FirstTimestampSeconds) - FPlatformTime::Seconds();
+            if (Delay > 0.0)
+            {
+                FPlatformProcess::Sleep((float)Delay);
+            }
+        }
+
+        // Runs inline on the game thread, like every command the editor executes
+        FUnrealMCPCommandTiming Timing;
+        Timing.FirstByte = FPlatformTime::Cycles64();
+        Timing.Received = Timing.FirstByte;
+        FUnrealMCPResponse Response = Bridge->ExecuteCommand(TraceRecord.Command, RequestParams[RecordIndex], MCPProtocol::EMCPPayloadEncoding::Json, Timing);
+
+        // Encoded the way a session would, so the serialize phase matches the editor's
+        bool bSucceeded = true;
+        if (Response.Object.IsValid())
+        {
+            FString Status;
+            bSucceeded = Response.Object->TryGetStringField(TEXT("status"), Status) && Status == TEXT("success");
+            EncodeBuffer.Reset();
+            MCPProtocol::EncodePayload(Response.Object.ToSharedRef(), MCPProtocol::EMCPPayloadEncoding::Json, EncodeBuffer);
+        }
+        Response.Timing.Serialized = FPlatformTime::Cycles64();
+        Response.Timing.Sent = Response.Timing.Serialized;
+        ReplayStats.Record(FName(*TraceRecord.Command), Response.Timing, bSucceeded);
+
+        NumFailed += bSucceeded ? 0 : 1;
+        if (bSucceeded != TraceRecord.bSucceeded)
+        {
+            if (NumStatusChanged < MaxReportedStatusChanges)
+            {
+                UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPReplayCommandlet: Request %d (%s) %s when recorded but %s on replay"), RecordIndex, *TraceRecord.Command,
+                    TraceRecord.bSucceeded ? TEXT("succeeded") : TEXT("failed"), bSucceeded ? TEXT("succeeded") : TEXT("failed"));
+            }
+            ++NumStatusChanged;
+        }
+    }
+    const double ReplaySeconds = FPlatformTime::Seconds() - ReplayStartSeconds;
+
+    // Without editor ticks the debounced compiles never run, so they are flushed and timed separately
+    const double CompileStartSeconds = FPlatformTime::Seconds();
+    const int32 NumDeferredCompiles = Bridge->GetCompileScheduler().FlushAll();
+    const double CompileSeconds = FPlatformTime::Seconds() - CompileStartSeconds;
+
+    // The session ended with the last response sent, which need not belong to the last request to arrive
+    double LastResponseSeconds = FirstTimestampSeconds;
+    for (const FUnrealMCPTraceRecord& TraceRecord : Records)
+    {
+        LastResponseSeconds = FMath::Max(LastResponseSeconds, ((double)TraceRecord.TimestampUs + TraceRecord.LatencyUs) / 1000000.0);
+    }
+    const double RecordedSeconds = LastResponseSeconds - FirstTimestampSeconds;
+    TSharedPtr<FJsonObject> ReplayedJson = ReplayStats.ToJson();
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPReplayCommandlet: Replayed %d requests in %.3f s (recorded session: %.3f s), %d failed, %d changed status, %d deferred compiles in %.3f s"),
+        Records.Num(), ReplaySeconds, RecordedSeconds, NumFailed, NumStatusChanged, NumDeferredCompiles, CompileSeconds);
+
+    TSharedPtr<FJsonObject> RecordedJson = MakeShareable(new FJsonObject);
+    const TSharedPtr<FJsonObject>* ReplayedCommands = nullptr;
+    ReplayedJson->TryGetObjectField(TEXT("commands"), ReplayedCommands);
+    RecordedCommands.KeySort(TLess<FString>());
+    for (const TPair<FString, FRecordedCommand>& Pair : RecordedCommands)
+    {
+        const FRecordedCommand& Recorded = Pair.Value;
+        const double RecordedMeanMs = Recorded.TotalUs / 1000.0 / Recorded.Count;
+
+        TSharedPtr<FJsonObject> CommandJson = MakeShareable(new FJsonObject);
+        CommandJson->SetNumberField(TEXT("count"), (double)Recorded.Count);
+        CommandJson->SetNumberField(TEXT("errors"), (double)Recorded.Errors);
+        CommandJson->SetNumberField(TEXT("mean_ms"), RecordedMeanMs);
+        CommandJson->SetNumberField(TEXT("max_ms"), Recorded.MaxUs / 1000.0);
+        RecordedJson->SetObjectField(Pair.Key, CommandJson);
+
+        // The recorded latency includes the network and the wait for the editor frame; the replayed one does not
+        double ReplayedMeanMs = 0.0;
+        const TSharedPtr<FJsonObject>* ReplayedCommand = nullptr;
+        const TSharedPtr<FJsonObject>* Phases = nullptr;
+        const TSharedPtr<FJsonObject>* Total = nullptr;
+        if (ReplayedCommands && (*ReplayedCommands)->TryGetObjectField(Pair.Key, ReplayedCommand) &&
+            (*ReplayedCommand)->TryGetObjectField(TEXT("phases"), Phases) && (*Phases)->TryGetObjectField(TEXT("total"), Total))
+        {
+            ReplayedMeanMs = (*Total)->GetNumberField(TEXT("mean_ms"));
+        }
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPReplayCommandlet:   %-32s %6lld requests, mean %9.3f ms recorded, %9.3f ms replayed"),
+            *Pair.Key, Recorded.Count, RecordedMeanMs, ReplayedMeanMs);
+    }
+
+    if (!OutputPath.IsEmpty())
+    {
+        TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+        ResultJson->SetStringField(TEXT("trace"), FPaths::GetCleanFilename(TracePath));
+        ResultJson->SetStringField(TEXT("mode"), bMaxSpeed ? TEXT("max_speed") : TEXT("recorded_pace"));
+        ResultJson->SetNumberField(TEXT("requests"), Records.Num());
+        ResultJson->SetNumberField(TEXT("failed"), NumFailed);
+        ResultJson->SetNumberField(TEXT("status_changed"), NumStatusChanged);
+        ResultJson->SetNumberField(TEXT("recorded_duration_s"), RecordedSeconds);
+        ResultJson->SetNumberField(TEXT("replay_duration_s"), ReplaySeconds);
+        ResultJson->SetNumberField(TEXT("deferred_compiles"), NumDeferredCompiles);
+        ResultJson->SetNumberField(TEXT("compile_s"), CompileSeconds);
+        ResultJson->SetObjectField(TEXT("recorded"), RecordedJson);
+        ResultJson->SetObjectField(TEXT("replayed"), ReplayedJson);
+
+        FString Output;
+        FJsonSerializer::Serialize(ResultJson.ToSharedRef(), TJsonWriterFactory<>::Create(&Output));
+        if (!FFileHelper::SaveStringToFile(Output, *OutputPath))
+        {
+            UE_LOG(LogUnrealMCP, Error, TEXT("UnrealMCPReplayCommandlet: Failed to write %s"), *OutputPath);
+            return 1;
+        }
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPReplayCommandlet: Results written to %s"), *OutputPath);
+    }
+    return 0;
+}
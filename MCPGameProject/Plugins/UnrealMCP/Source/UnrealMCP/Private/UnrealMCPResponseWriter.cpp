@@ -0,0 +1,442 @@
+#include "UnrealMCPResponseWriter.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    /** Largest magnitude up to which every integer is exactly representable as a double */
+    constexpr double MaxExactInteger = 9007199254740992.0;
+
+    // CBOR major types (RFC 8949, section 3.1)
+    constexpr uint8 CborUnsigned = 0;
+    constexpr uint8 CborNegative = 1;
+    constexpr uint8 CborText = 3;
+    constexpr uint8 CborIndefiniteArray = 0x9F;
+    constexpr uint8 CborIndefiniteMap = 0xBF;
+    constexpr uint8 CborFalse = 0xF4;
+    constexpr uint8 CborTrue = 0xF5;
+    constexpr uint8 CborNull = 0xF6;
+    constexpr uint8 CborDouble = 0xFB;
+    constexpr uint8 CborBreak = 0xFF;
+}
+
+FUnrealMCPResponseWriter::FUnrealMCPResponseWriter(TArray<uint8>& OutBuffer, MCPProtocol::EMCPPayloadEncoding InEncoding)
+    : Target(InEncoding == MCPProtocol::EMCPPayloadEncoding::Cbor ? ETarget::Cbor : ETarget::Json)
+    , Buffer(&OutBuffer)
+{
+    if (Target == ETarget::Json)
+    {
+        // Append after whatever the caller already put in the buffer
+        JsonArchive = MakeUnique<FMemoryWriter>(OutBuffer, false, true);
+        JsonWriter = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(JsonArchive.Get());
+    }
+}
+
+FUnrealMCPResponseWriter::FUnrealMCPResponseWriter()
+    : Target(ETarget::Object)
+    , Buffer(nullptr)
+{
+}
+
+FUnrealMCPResponseWriter::~FUnrealMCPResponseWriter()
+{
+    // The JSON writer holds a pointer to the archive
+    JsonWriter.Reset();
+}
+
+void FUnrealMCPResponseWriter::WriteObjectStart()
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteObjectStart(); break;
+    case ETarget::Cbor: WriteCborByte(CborIndefiniteMap); break;
+    case ETarget::Object: StartTreeContainer(nullptr, true); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteObjectStart(const TCHAR* Key)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteObjectStart(Key); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborByte(CborIndefiniteMap); break;
+    case ETarget::Object: StartTreeContainer(Key, true); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteObjectEnd()
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteObjectEnd(); break;
+    case ETarget::Cbor: WriteCborByte(CborBreak); break;
+    case ETarget::Object: EndTreeContainer(); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteArrayStart()
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteArrayStart(); break;
+    case ETarget::Cbor: WriteCborByte(CborIndefiniteArray); break;
+    case ETarget::Object: StartTreeContainer(nullptr, false); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteArrayStart(const TCHAR* Key)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteArrayStart(Key); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborByte(CborIndefiniteArray); break;
+    case ETarget::Object: StartTreeContainer(Key, false); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteArrayEnd()
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteArrayEnd(); break;
+    case ETarget::Cbor: WriteCborByte(CborBreak); break;
+    case ETarget::Object: EndTreeContainer(); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(const TCHAR* Key, const FString& Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Key, Value); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborString(*Value, Value.Len()); break;
+    case ETarget::Object: AddTreeValue(Key, MakeShared<FJsonValueString>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(const TCHAR* Key, const TCHAR* Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Key, FStringView(Value)); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborString(Value, FCString::Strlen(Value)); break;
+    case ETarget::Object: AddTreeValue(Key, MakeShared<FJsonValueString>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(const TCHAR* Key, double Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Key, Value); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborNumber(Value); break;
+    case ETarget::Object: AddTreeValue(Key, MakeShared<FJsonValueNumber>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(const TCHAR* Key, int64 Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Key, Value); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborNumber(static_cast<double>(Value)); break;
+    case ETarget::Object: AddTreeValue(Key, MakeShared<FJsonValueNumber>(static_cast<double>(Value))); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(const TCHAR* Key, bool Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Key, Value); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborByte(Value ? CborTrue : CborFalse); break;
+    case ETarget::Object: AddTreeValue(Key, MakeShared<FJsonValueBoolean>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteNull(const TCHAR* Key)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteNull(Key); break;
+    case ETarget::Cbor: WriteCborKey(Key); WriteCborByte(CborNull); break;
+    case ETarget::Object: AddTreeValue(Key, MakeShared<FJsonValueNull>()); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(const FString& Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Value); break;
+    case ETarget::Cbor: WriteCborString(*Value, Value.Len()); break;
+    case ETarget::Object: AddTreeValue(nullptr, MakeShared<FJsonValueString>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(const TCHAR* Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(FStringView(Value)); break;
+    case ETarget::Cbor: WriteCborString(Value, FCString::Strlen(Value)); break;
+    case ETarget::Object: AddTreeValue(nullptr, MakeShared<FJsonValueString>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(double Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Value); break;
+    case ETarget::Cbor: WriteCborNumber(Value); break;
+    case ETarget::Object: AddTreeValue(nullptr, MakeShared<FJsonValueNumber>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(int64 Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Value); break;
+    case ETarget::Cbor: WriteCborNumber(static_cast<double>(Value)); break;
+    case ETarget::Object: AddTreeValue(nullptr, MakeShared<FJsonValueNumber>(static_cast<double>(Value))); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteValue(bool Value)
+{
+    switch (Target)
+    {
+    case ETarget::Json: JsonWriter->WriteValue(Value); break;
+    case ETarget::Cbor: WriteCborByte(Value ? CborTrue : CborFalse); break;
+    case ETarget::Object: AddTreeValue(nullptr, MakeShared<FJsonValueBoolean>(Value)); break;
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteVector(const TCHAR* Key, const FVector& Value)
+{
+    WriteArrayStart(Key);
+    WriteValue(Value.X);
+    WriteValue(Value.Y);
+    WriteValue(Value.Z);
+    WriteArrayEnd();
+}
+
+void FUnrealMCPResponseWriter::WriteRotator(const TCHAR* Key, const FRotator& Value)
+{
+    WriteArrayStart(Key);
+    WriteValue(Value.Pitch);
+    WriteValue(Value.Yaw);
+    WriteValue(Value.Roll);
+    WriteArrayEnd();
+}
+
+void FUnrealMCPResponseWriter::WriteJsonValue(const TCHAR* Key, const TSharedPtr<FJsonValue>& Value)
+{
+    if (Target == ETarget::Object)
+    {
+        // Values are immutable once built, so the tree can share them
+        AddTreeValue(Key, Value.IsValid() ? Value : MakeShared<FJsonValueNull>());
+        return;
+    }
+
+    const EJson Type = Value.IsValid() ? Value->Type : EJson::Null;
+    if (Type == EJson::Array)
+    {
+        if (Key)
+        {
+            WriteArrayStart(Key);
+        }
+        else
+        {
+            WriteArrayStart();
+        }
+        for (const TSharedPtr<FJsonValue>& Item : Value->AsArray())
+        {
+            WriteJsonValue(nullptr, Item);
+        }
+        WriteArrayEnd();
+    }
+    else if (Type == EJson::Object && Value->AsObject().IsValid())
+    {
+        if (Key)
+        {
+            WriteObjectStart(Key);
+        }
+        else
+        {
+            WriteObjectStart();
+        }
+        WriteJsonFields(*Value->AsObject());
+        WriteObjectEnd();
+    }
+    else if (Key)
+    {
+        switch (Type)
+        {
+        case EJson::String: WriteValue(Key, Value->AsString()); break;
+        case EJson::Number: WriteValue(Key, Value->AsNumber()); break;
+        case EJson::Boolean: WriteValue(Key, Value->AsBool()); break;
+        default: WriteNull(Key); break;
+        }
+    }
+    else
+    {
+        switch (Type)
+        {
+        case EJson::String: WriteValue(Value->AsString()); break;
+        case EJson::Number: WriteValue(Value->AsNumber()); break;
+        case EJson::Boolean: WriteValue(Value->AsBool()); break;
+        default:
+            if (Target == ETarget::Json)
+            {
+                JsonWriter->WriteNull();
+            }
+            else
+            {
+                WriteCborByte(CborNull);
+            }
+            break;
+        }
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteJsonFields(const FJsonObject& Object)
+{
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object.Values)
+    {
+        WriteJsonValue(*Pair.Key, Pair.Value);
+    }
+}
+
+void FUnrealMCPResponseWriter::Close()
+{
+    if (Target == ETarget::Json)
+    {
+        JsonWriter->Close();
+    }
+    check(TreeStack.Num() == 0);
+}
+
+void FUnrealMCPResponseWriter::WriteCborHeader(uint8 MajorType, uint64 Argument)
+{
+    const uint8 Major = MajorType << 5;
+    if (Argument < 24)
+    {
+        Buffer->Add(Major | static_cast<uint8>(Argument));
+        return;
+    }
+
+    // 1, 2, 4 or 8 argument bytes, big-endian
+    int32 Size = 8;
+    uint8 Info = 27;
+    if (Argument <= MAX_uint8)
+    {
+        Size = 1;
+        Info = 24;
+    }
+    else if (Argument <= MAX_uint16)
+    {
+        Size = 2;
+        Info = 25;
+    }
+    else if (Argument <= MAX_uint32)
+    {
+        Size = 4;
+        Info = 26;
+    }
+
+    Buffer->Add(Major | Info);
+    for (int32 Shift = (Size - 1) * 8; Shift >= 0; Shift -= 8)
+    {
+        Buffer->Add(static_cast<uint8>(Argument >> Shift));
+    }
+}
+
+void FUnrealMCPResponseWriter::WriteCborString(const TCHAR* Value, int32 Length)
+{
+    // Short strings convert on the stack
+    FTCHARToUTF8 Utf8Value(Value, Length);
+    WriteCborHeader(CborText, Utf8Value.Length());
+    Buffer->Append(reinterpret_cast<const uint8*>(Utf8Value.Get()), Utf8Value.Length());
+}
+
+void FUnrealMCPResponseWriter::WriteCborKey(const TCHAR* Key)
+{
+    WriteCborString(Key, FCString::Strlen(Key));
+}
+
+void FUnrealMCPResponseWriter::WriteCborNumber(double Value)
+{
+    // Counts, indices and ids are integral; the integer forms are 1 to 9 bytes instead of 9
+    if (FMath::Abs(Value) <= MaxExactInteger && FMath::RoundToDouble(Value) == Value)
+    {
+        const int64 Integer = static_cast<int64>(Value);
+        if (Integer >= 0)
+        {
+            WriteCborHeader(CborUnsigned, static_cast<uint64>(Integer));
+        }
+        else
+        {
+            WriteCborHeader(CborNegative, static_cast<uint64>(-1 - Integer));
+        }
+        return;
+    }
+
+    uint64 Bits = 0;
+    FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+    Buffer->Add(CborDouble);
+    for (int32 Shift = 56; Shift >= 0; Shift -= 8)
+    {
+        Buffer->Add(static_cast<uint8>(Bits >> Shift));
+    }
+}
+
+void FUnrealMCPResponseWriter::AddTreeValue(const TCHAR* Key, const TSharedPtr<FJsonValue>& Value)
+{
+    check(TreeStack.Num() > 0);
+    FTreeContainer& Container = TreeStack.Last();
+    if (Container.Object.IsValid())
+    {
+        Container.Object->SetField(Key, Value);
+    }
+    else
+    {
+        Container.Array.Add(Value);
+    }
+}
+
+void FUnrealMCPResponseWriter::StartTreeContainer(const TCHAR* Key, bool bIsObject)
+{
+    FTreeContainer& Container = TreeStack.AddDefaulted_GetRef();
+    if (bIsObject)
+    {
+        Container.Object = MakeShared<FJsonObject>();
+    }
+    if (Key)
+    {
+        Container.Key = Key;
+    }
+}
+
+void FUnrealMCPResponseWriter::EndTreeContainer()
+{
+    FTreeContainer Container = TreeStack.Pop(EAllowShrinking::No);
+    if (TreeStack.Num() == 0)
+    {
+        check(Container.Object.IsValid());
+        RootObject = Container.Object;
+        return;
+    }
+
+    TSharedPtr<FJsonValue> Value;
+    if (Container.Object.IsValid())
+    {
+        Value = MakeShared<FJsonValueObject>(Container.Object);
+    }
+    else
+    {
+        Value = MakeShared<FJsonValueArray>(Container.Array);
+    }
+    AddTreeValue(TreeStack.Last().Object.IsValid() ? *Container.Key : nullptr, Value);
+}
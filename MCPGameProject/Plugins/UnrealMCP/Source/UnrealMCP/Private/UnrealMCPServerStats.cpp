@@ -0,0 +1,291 @@
+#include "UnrealMCPServerStats.h"
+#include "Dom/JsonObject.h"
+
+namespace
+{
+    const TCHAR* const UnknownCommandName = TEXT("<unknown>");
+
+    const double Percentiles[] = { 50.0, 90.0, 99.0 };
+
+    /** Duration between two times, or -1 if either was not reached */
+    int64 GetMicroseconds(uint64 StartCycles, uint64 EndCycles)
+    {
+        if (StartCycles == 0 || EndCycles == 0 || EndCycles < StartCycles)
+        {
+            return -1;
+        }
+        return (int64)(FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1000000.0);
+    }
+
+    double ToMilliseconds(double Microseconds)
+    {
+        return Microseconds / 1000.0;
+    }
+}
+
+const TCHAR* LexToString(EUnrealMCPCommandPhase Phase)
+{
+    switch (Phase)
+    {
+    case EUnrealMCPCommandPhase::Receive: return TEXT("receive");
+    case EUnrealMCPCommandPhase::Parse: return TEXT("parse");
+    case EUnrealMCPCommandPhase::Queue: return TEXT("queue");
+    case EUnrealMCPCommandPhase::Handler: return TEXT("handler");
+    case EUnrealMCPCommandPhase::Serialize: return TEXT("serialize");
+    case EUnrealMCPCommandPhase::Send: return TEXT("send");
+    case EUnrealMCPCommandPhase::Total: return TEXT("total");
+    default: return TEXT("unknown");
+    }
+}
+
+FUnrealMCPLatencyHistogram::FUnrealMCPLatencyHistogram()
+{
+    Reset();
+}
+
+void FUnrealMCPLatencyHistogram::Record(uint64 Microseconds)
+{
+    Buckets[GetBucketIndex(Microseconds)].fetch_add(1, std::memory_order_relaxed);
+    Count.fetch_add(1, std::memory_order_relaxed);
+    Sum.fetch_add(Microseconds, std::memory_order_relaxed);
+
+    uint64 CurrentMax = Max.load(std::memory_order_relaxed);
+    while (Microseconds > CurrentMax && !Max.compare_exchange_weak(CurrentMax, Microseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+double FUnrealMCPLatencyHistogram::GetMean() const
+{
+    const uint64 NumValues = GetCount();
+    return NumValues > 0 ? (double)Sum.load(std::memory_order_relaxed) / NumValues : 0.0;
+}
+
+uint64 FUnrealMCPLatencyHistogram::GetPercentile(double Percentile) const
+{
+    const uint64 NumValues = GetCount();
+    if (NumValues == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the value we are after, counting from 1
+    const uint64 Rank = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(Percentile / 100.0 * NumValues));
+    uint64 Seen = 0;
+    for (int32 Index = 0; Index < NumBuckets; ++Index)
+    {
+        Seen += Buckets[Index].load(std::memory_order_relaxed);
+        if (Seen >= Rank)
+        {
+            // No value in the bucket exceeds the largest one recorded
+            return FMath::Min(GetBucketUpperBound(Index), GetMax());
+        }
+    }
+    return GetMax();
+}
+
+void FUnrealMCPLatencyHistogram::Reset()
+{
+    for (std::atomic<uint64>& Bucket : Buckets)
+    {
+        Bucket.store(0, std::memory_order_relaxed);
+    }
+    Count.store(0, std::memory_order_relaxed);
+    Sum.store(0, std::memory_order_relaxed);
+    Max.store(0, std::memory_order_relaxed);
+}
+
+int32 FUnrealMCPLatencyHistogram::GetBucketIndex(uint64 Value)
+{
+    // Values below SubBucketCount get a bucket each
+    if (Value < SubBucketCount)
+    {
+        return (int32)Value;
+    }
+    if (Value >= (1ull << MaxValueBits))
+    {
+        return NumBuckets - 1;
+    }
+
+    // The highest bit picks the block, the SubBucketBits bits below it the bucket within the block
+    const int32 Exponent = 63 - (int32)FPlatformMath::CountLeadingZeros64(Value);
+    const int32 SubBucket = (int32)(Value >> (Exponent - SubBucketBits)) & (SubBucketCount - 1);
+    return (Exponent - SubBucketBits + 1) * SubBucketCount + SubBucket;
+}
+
+uint64 FUnrealMCPLatencyHistogram::GetBucketUpperBound(int32 Index)
+{
+    if (Index < SubBucketCount)
+    {
+        return Index;
+    }
+
+    const int32 Exponent = Index / SubBucketCount + SubBucketBits - 1;
+    const int32 SubBucket = Index % SubBucketCount;
+    const uint64 Width = 1ull << (Exponent - SubBucketBits);
+    return (1ull << Exponent) + SubBucket * Width + Width - 1;
+}
+
+FUnrealMCPServerStats::FUnrealMCPServerStats(const TArray<FName>& CommandNames)
+    : ResetCycles(FPlatformTime::Cycles64())
+{
+    Commands.Reserve(CommandNames.Num());
+    for (const FName& CommandName : CommandNames)
+    {
+        Commands.Add(CommandName, MakeUnique<FCommandStats>());
+    }
+}
+
+void FUnrealMCPServerStats::Record(FName Command, const FUnrealMCPCommandTiming& Timing, bool bSucceeded)
+{
+    FCommandStats& Stats = FindStats(Command);
+    Stats.Count.fetch_add(1, std::memory_order_relaxed);
+    if (!bSucceeded)
+    {
+        Stats.Errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const int64 Durations[] =
+    {
+        GetMicroseconds(Timing.FirstByte, Timing.Received),
+        GetMicroseconds(Timing.Received, Timing.Enqueued),
+        GetMicroseconds(Timing.Enqueued, Timing.Started),
+        GetMicroseconds(Timing.Started, Timing.Handled),
+        GetMicroseconds(Timing.Handled, Timing.Serialized),
+        GetMicroseconds(Timing.Serialized, Timing.Sent),
+        GetMicroseconds(Timing.FirstByte, Timing.Sent),
+    };
+    static_assert(UE_ARRAY_COUNT(Durations) == (int32)EUnrealMCPCommandPhase::Count, "One duration per phase");
+
+    for (int32 PhaseIndex = 0; PhaseIndex < (int32)EUnrealMCPCommandPhase::Count; ++PhaseIndex)
+    {
+        if (Durations[PhaseIndex] >= 0)
+        {
+            Stats.Phases[PhaseIndex].Record((uint64)Durations[PhaseIndex]);
+        }
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPServerStats::ToJson(const FString& CommandFilter) const
+{
+    TSharedPtr<FJsonObject> CommandsJson = MakeShared<FJsonObject>();
+    for (const TPair<FName, const FCommandStats*>& Pair : GetCalledCommands())
+    {
+        const FString CommandName = Pair.Key.IsNone() ? UnknownCommandName : Pair.Key.ToString();
+        if (!CommandFilter.IsEmpty() && CommandName != CommandFilter)
+        {
+            continue;
+        }
+
+        const FCommandStats& Stats = *Pair.Value;
+        TSharedPtr<FJsonObject> PhasesJson = MakeShared<FJsonObject>();
+        for (int32 PhaseIndex = 0; PhaseIndex < (int32)EUnrealMCPCommandPhase::Count; ++PhaseIndex)
+        {
+            const FUnrealMCPLatencyHistogram& Histogram = Stats.Phases[PhaseIndex];
+            if (Histogram.GetCount() == 0)
+            {
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> PhaseJson = MakeShared<FJsonObject>();
+            PhaseJson->SetNumberField(TEXT("count"), (double)Histogram.GetCount());
+            PhaseJson->SetNumberField(TEXT("mean_ms"), ToMilliseconds(Histogram.GetMean()));
+            for (double Percentile : Percentiles)
+            {
+                PhaseJson->SetNumberField(FString::Printf(TEXT("p%d_ms"), (int32)Percentile), ToMilliseconds(Histogram.GetPercentile(Percentile)));
+            }
+            PhaseJson->SetNumberField(TEXT("max_ms"), ToMilliseconds(Histogram.GetMax()));
+            PhasesJson->SetObjectField(LexToString((EUnrealMCPCommandPhase)PhaseIndex), PhaseJson);
+        }
+
+        TSharedPtr<FJsonObject> CommandJson = MakeShared<FJsonObject>();
+        CommandJson->SetNumberField(TEXT("count"), (double)Stats.Count.load(std::memory_order_relaxed));
+        CommandJson->SetNumberField(TEXT("errors"), (double)Stats.Errors.load(std::memory_order_relaxed));
+        CommandJson->SetObjectField(TEXT("phases"), PhasesJson);
+        CommandsJson->SetObjectField(CommandName, CommandJson);
+    }
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetNumberField(TEXT("since_reset_s"), FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - ResetCycles.load(std::memory_order_relaxed)));
+    ResultJson->SetObjectField(TEXT("commands"), CommandsJson);
+    return ResultJson;
+}
+
+FString FUnrealMCPServerStats::ToCsv() const
+{
+    FString Csv = TEXT("command,count,errors,phase,samples,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n");
+    for (const TPair<FName, const FCommandStats*>& Pair : GetCalledCommands())
+    {
+        const FString CommandName = Pair.Key.IsNone() ? UnknownCommandName : Pair.Key.ToString();
+        const FCommandStats& Stats = *Pair.Value;
+        for (int32 PhaseIndex = 0; PhaseIndex < (int32)EUnrealMCPCommandPhase::Count; ++PhaseIndex)
+        {
+            const FUnrealMCPLatencyHistogram& Histogram = Stats.Phases[PhaseIndex];
+            if (Histogram.GetCount() == 0)
+            {
+                continue;
+            }
+
+            Csv += FString::Printf(TEXT("%s,%llu,%llu,%s,%llu,%.3f"), *CommandName,
+                Stats.Count.load(std::memory_order_relaxed), Stats.Errors.load(std::memory_order_relaxed),
+                LexToString((EUnrealMCPCommandPhase)PhaseIndex), Histogram.GetCount(), ToMilliseconds(Histogram.GetMean()));
+            for (double Percentile : Percentiles)
+            {
+                Csv += FString::Printf(TEXT(",%.3f"), ToMilliseconds(Histogram.GetPercentile(Percentile)));
+            }
+            Csv += FString::Printf(TEXT(",%.3f\n"), ToMilliseconds(Histogram.GetMax()));
+        }
+    }
+    return Csv;
+}
+
+void FUnrealMCPServerStats::Reset()
+{
+    for (const TPair<FName, TUniquePtr<FCommandStats>>& Pair : Commands)
+    {
+        Pair.Value->Count.store(0, std::memory_order_relaxed);
+        Pair.Value->Errors.store(0, std::memory_order_relaxed);
+        for (FUnrealMCPLatencyHistogram& Histogram : Pair.Value->Phases)
+        {
+            Histogram.Reset();
+        }
+    }
+
+    UnknownCommands.Count.store(0, std::memory_order_relaxed);
+    UnknownCommands.Errors.store(0, std::memory_order_relaxed);
+    for (FUnrealMCPLatencyHistogram& Histogram : UnknownCommands.Phases)
+    {
+        Histogram.Reset();
+    }
+
+    ResetCycles.store(FPlatformTime::Cycles64(), std::memory_order_relaxed);
+}
+
+FUnrealMCPServerStats::FCommandStats& FUnrealMCPServerStats::FindStats(FName Command)
+{
+    const TUniquePtr<FCommandStats>* Stats = Command.IsNone() ? nullptr : Commands.Find(Command);
+    return Stats ? **Stats : UnknownCommands;
+}
+
+TArray<TPair<FName, const FUnrealMCPServerStats::FCommandStats*>> FUnrealMCPServerStats::GetCalledCommands() const
+{
+    TArray<TPair<FName, const FCommandStats*>> Called;
+    for (const TPair<FName, TUniquePtr<FCommandStats>>& Pair : Commands)
+    {
+        if (Pair.Value->Count.load(std::memory_order_relaxed) > 0)
+        {
+            Called.Emplace(Pair.Key, Pair.Value.Get());
+        }
+    }
+    Called.Sort([](const TPair<FName, const FCommandStats*>& A, const TPair<FName, const FCommandStats*>& B)
+    {
+        return A.Key.LexicalLess(B.Key);
+    });
+
+    // NAME_None stands for the unknown commands, listed last
+    if (UnknownCommands.Count.load(std::memory_order_relaxed) > 0)
+    {
+        Called.Emplace(NAME_None, &UnknownCommands);
+    }
+    return Called;
+}
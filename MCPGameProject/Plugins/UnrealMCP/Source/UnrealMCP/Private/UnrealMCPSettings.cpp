@@ -0,0 +1,32 @@
+#include "UnrealMCPSettings.h"
+#include "UnrealMCPLog.h"
+
+UUnrealMCPSettings::UUnrealMCPSettings()
+{
+    MaxConcurrentSessions = 8;
+    CompileDebounceSeconds = 0.5f;
+    MaxUndoMemoryMB = 64;
+    TransactionIdleTimeoutSeconds = 120.0f;
+    bLogPayloads = false;
+    MaxLoggedPayloadLength = 1024;
+    PayloadLogSampleInterval = 1;
+    bWriteServerStatsOnShutdown = false;
+    bRecordTrace = false;
+}
+
+void UUnrealMCPSettings::ApplyLogOptions() const
+{
+    UnrealMCPLog::FPayloadLogOptions Options;
+    Options.bEnabled = bLogPayloads;
+    Options.MaxLength = MaxLoggedPayloadLength;
+    Options.SampleInterval = PayloadLogSampleInterval;
+    UnrealMCPLog::SetPayloadLogOptions(Options);
+}
+
+#if WITH_EDITOR
+void UUnrealMCPSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    ApplyLogOptions();
+}
+#endif
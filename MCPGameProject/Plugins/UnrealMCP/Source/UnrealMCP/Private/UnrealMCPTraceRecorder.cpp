@@ -0,0 +1,220 @@
+#include "UnrealMCPTraceRecorder.h"
+#include "UnrealMCPLog.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+    const uint8 TraceMagic[4] = { 'U', 'M', 'C', 'T' };
+
+    // Longest string a record may hold; a larger count means the file is corrupt
+    const uint32 MaxStringBytes = 256 * 1024 * 1024;
+
+    enum ETraceRecordFlags : uint8
+    {
+        TraceRecordFlag_Succeeded = 1 << 0,
+    };
+
+    /** A uint32 byte count followed by UTF-8 text */
+    void SerializeString(FArchive& Ar, FString& Value)
+    {
+        if (Ar.IsLoading())
+        {
+            uint32 NumBytes = 0;
+            Ar << NumBytes;
+            if (NumBytes > MaxStringBytes || Ar.Tell() + NumBytes > Ar.TotalSize())
+            {
+                Ar.SetError();
+                return;
+            }
+            TArray<uint8> Bytes;
+            Bytes.SetNumUninitialized(NumBytes);
+            Ar.Serialize(Bytes.GetData(), NumBytes);
+            Value = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), NumBytes));
+        }
+        else
+        {
+            FTCHARToUTF8 Utf8(*Value, Value.Len());
+            uint32 NumBytes = Utf8.Length();
+            Ar << NumBytes;
+            Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), NumBytes);
+        }
+    }
+
+    /** Microseconds between two times, 0 if either was not reached */
+    uint64 GetMicroseconds(uint64 StartCycles, uint64 EndCycles)
+    {
+        if (StartCycles == 0 || EndCycles < StartCycles)
+        {
+            return 0;
+        }
+        return (uint64)(FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1000000.0);
+    }
+}
+
+FUnrealMCPTraceRecorder::FUnrealMCPTraceRecorder()
+    : StartCycles(0)
+    , NumRecords(0)
+    , bRecording(false)
+{
+}
+
+FUnrealMCPTraceRecorder::~FUnrealMCPTraceRecorder()
+{
+    Stop();
+}
+
+bool FUnrealMCPTraceRecorder::Start(const FString& InFilePath, FString& OutError)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (File.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Already recording to %s"), *FilePath);
+        return false;
+    }
+
+    File.Reset(IFileManager::Get().CreateFileWriter(*InFilePath));
+    if (!File.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Failed to create trace file %s"), *InFilePath);
+        return false;
+    }
+
+    uint32 Version = FormatVersion;
+    int64 StartUnixMs = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMillisecond;
+    File->Serialize(const_cast<uint8*>(TraceMagic), sizeof(TraceMagic));
+    *File << Version;
+    *File << StartUnixMs;
+
+    FilePath = InFilePath;
+    StartCycles = FPlatformTime::Cycles64();
+    NumRecords = 0;
+    bRecording.store(true, std::memory_order_relaxed);
+
+    UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPTraceRecorder: Recording requests to %s"), *FilePath);
+    return true;
+}
+
+int64 FUnrealMCPTraceRecorder::Stop()
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!File.IsValid())
+    {
+        return NumRecords;
+    }
+
+    bRecording.store(false, std::memory_order_relaxed);
+    const bool bClosed = File->Close();
+    File.Reset();
+
+    if (bClosed)
+    {
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPTraceRecorder: Wrote %lld requests to %s"), NumRecords, *FilePath);
+    }
+    else
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPTraceRecorder: Failed to write %s; the trace is incomplete"), *FilePath);
+    }
+    return NumRecords;
+}
+
+FString FUnrealMCPTraceRecorder::GetFilePath() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FilePath;
+}
+
+int64 FUnrealMCPTraceRecorder::GetNumRecords() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return NumRecords;
+}
+
+void FUnrealMCPTraceRecorder::Record(FUnrealMCPTraceRecord& TraceRecord, const FUnrealMCPCommandTiming& Timing)
+{
+    // Requests that were not received from a socket have no first byte; they are timed from their start
+    const uint64 FirstCycles = Timing.FirstByte ? Timing.FirstByte : Timing.Started;
+    const uint64 LastCycles = Timing.Sent ? Timing.Sent : Timing.Handled;
+    TraceRecord.LatencyUs = (uint32)FMath::Min<uint64>(GetMicroseconds(FirstCycles, LastCycles), MAX_uint32);
+
+    FScopeLock ScopeLock(&Lock);
+    if (!File.IsValid())
+    {
+        return;
+    }
+
+    // A request that arrived before the recording started is placed at its start
+    TraceRecord.TimestampUs = FirstCycles > StartCycles ? GetMicroseconds(StartCycles, FirstCycles) : 0;
+    SerializeRecord(*File, TraceRecord);
+    ++NumRecords;
+}
+
+bool FUnrealMCPTraceRecorder::Load(const FString& InFilePath, TArray<FUnrealMCPTraceRecord>& OutRecords, FString& OutError)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InFilePath));
+    if (!Reader.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Failed to open trace file %s"), *InFilePath);
+        return false;
+    }
+
+    uint8 Magic[4] = {};
+    uint32 Version = 0;
+    int64 StartUnixMs = 0;
+    if (Reader->TotalSize() >= (int64)(sizeof(Magic) + sizeof(Version) + sizeof(StartUnixMs)))
+    {
+        Reader->Serialize(Magic, sizeof(Magic));
+        *Reader << Version;
+        *Reader << StartUnixMs;
+    }
+    if (FMemory::Memcmp(Magic, TraceMagic, sizeof(Magic)) != 0)
+    {
+        OutError = FString::Printf(TEXT("%s is not an MCP trace file"), *InFilePath);
+        return false;
+    }
+    if (Version != FormatVersion)
+    {
+        OutError = FString::Printf(TEXT("%s has trace format version %u; this build reads version %u"), *InFilePath, Version, FormatVersion);
+        return false;
+    }
+
+    OutRecords.Reset();
+    while (Reader->Tell() < Reader->TotalSize() && !Reader->IsError())
+    {
+        FUnrealMCPTraceRecord TraceRecord;
+        SerializeRecord(*Reader, TraceRecord);
+        if (!Reader->IsError())
+        {
+            OutRecords.Add(MoveTemp(TraceRecord));
+        }
+    }
+
+    // A trace whose editor was killed mid-write ends in a partial record; the complete ones are still usable
+    if (Reader->IsError())
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPTraceRecorder: %s ends in a truncated record; read %d complete records"), *InFilePath, OutRecords.Num());
+    }
+    return true;
+}
+
+FString FUnrealMCPTraceRecorder::GetDefaultFilePath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("UnrealMCP") / TEXT("Traces") / FString::Printf(TEXT("Trace-%s.mcptrace"), *FDateTime::Now().ToString());
+}
+
+void FUnrealMCPTraceRecorder::SerializeRecord(FArchive& Ar, FUnrealMCPTraceRecord& TraceRecord)
+{
+    uint8 Flags = TraceRecord.bSucceeded ? TraceRecordFlag_Succeeded : 0;
+
+    Ar << TraceRecord.TimestampUs;
+    Ar << TraceRecord.ConnectionId;
+    SerializeString(Ar, TraceRecord.Command);
+    SerializeString(Ar, TraceRecord.Params);
+    Ar << TraceRecord.ResponseSize;
+    Ar << TraceRecord.LatencyUs;
+    Ar << Flags;
+
+    TraceRecord.bSucceeded = (Flags & TraceRecordFlag_Succeeded) != 0;
+}
@@ -0,0 +1,288 @@
+#include "UnrealMCPTransactionManager.h"
+#include "UnrealMCPLog.h"
+#include "UnrealMCPSettings.h"
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
+#include "Dom/JsonObject.h"
+
+// How often an open group is checked for the idle timeout
+static const float IdleCheckInterval = 1.0f;
+
+const TCHAR* const FUnrealMCPTransactionManager::TransactionContext = TEXT("UnrealMCP");
+
+// Batches record under the plain context, groups under the context followed by their id
+static bool IsMCPContext(const FString& Context)
+{
+    return Context.StartsWith(FUnrealMCPTransactionManager::TransactionContext, ESearchCase::CaseSensitive);
+}
+
+FUnrealMCPTransactionManager::FUnrealMCPTransactionManager()
+    : OpenCommands(0)
+    , LastCommandTime(0.0)
+    , bCommandOpen(false)
+    , TotalRecordsDropped(0)
+{
+}
+
+FUnrealMCPTransactionManager::~FUnrealMCPTransactionManager()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+void FUnrealMCPTransactionManager::Initialize()
+{
+    OpenContext.Reset();
+    OpenCommands = 0;
+    bCommandOpen = false;
+    TotalRecordsDropped = 0;
+}
+
+void FUnrealMCPTransactionManager::Shutdown()
+{
+    if (IsOpen())
+    {
+        int32 Commands = 0;
+        FString Error;
+        End(false, Commands, Error);
+    }
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+bool FUnrealMCPTransactionManager::Begin(const FString& Description, FString& OutError)
+{
+    check(IsInGameThread());
+    if (!GEditor || !GEditor->Trans)
+    {
+        OutError = TEXT("The editor has no undo history");
+        return false;
+    }
+    if (IsOpen())
+    {
+        OutError = FString::Printf(TEXT("Transaction '%s' is already open; end it first"), *OpenDescription);
+        return false;
+    }
+
+    // Nothing is recorded yet; each command opens and closes a transaction of its own
+    OpenContext = FString::Printf(TEXT("%s.%s"), TransactionContext, *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+    OpenDescription = Description;
+    OpenCommands = 0;
+    LastCommandTime = FPlatformTime::Seconds();
+
+    // The ticker only runs while a group is open
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FUnrealMCPTransactionManager::Tick), IdleCheckInterval);
+    }
+    return true;
+}
+
+bool FUnrealMCPTransactionManager::End(bool bUndo, int32& OutCommands, FString& OutError)
+{
+    check(IsInGameThread());
+    if (!IsOpen())
+    {
+        OutError = TEXT("No transaction is open");
+        return false;
+    }
+
+    if (bUndo)
+    {
+        // Only the group's own records are reverted; anything recorded after them, e.g. an edit made
+        // by hand, would have to be undone first, so the group is left open for the caller to decide
+        int32 Records = 0;
+        if (!CountUndoableGroupRecords(Records))
+        {
+            OutError = FString::Printf(TEXT("Other edits were recorded after transaction '%s'; undo them first or end it without undo"), *OpenDescription);
+            return false;
+        }
+        for (int32 Index = 0; Index < Records; ++Index)
+        {
+            GEditor->UndoTransaction();
+        }
+    }
+
+    OutCommands = OpenCommands;
+    OpenContext.Reset();
+    OpenCommands = 0;
+
+    EnforceMemoryBudget();
+    return true;
+}
+
+void FUnrealMCPTransactionManager::NoteCommand()
+{
+    if (IsOpen())
+    {
+        ++OpenCommands;
+        LastCommandTime = FPlatformTime::Seconds();
+    }
+}
+
+bool FUnrealMCPTransactionManager::BeginCommand(const FString& CommandType)
+{
+    check(IsInGameThread());
+    if (!IsOpen() || bCommandOpen || CommandType == TEXT("begin_transaction") || CommandType == TEXT("end_transaction"))
+    {
+        return false;
+    }
+
+    // A command that changes nothing leaves no record
+    GEditor->BeginTransaction(*OpenContext, FText::FromString(FString::Printf(TEXT("%s (%s)"), *OpenDescription, *CommandType)), nullptr);
+    bCommandOpen = true;
+    return true;
+}
+
+void FUnrealMCPTransactionManager::EndCommand()
+{
+    check(IsInGameThread());
+    if (bCommandOpen)
+    {
+        GEditor->EndTransaction();
+        bCommandOpen = false;
+        EnforceMemoryBudget();
+    }
+}
+
+bool FUnrealMCPTransactionManager::CountUndoableGroupRecords(int32& OutRecords) const
+{
+    OutRecords = 0;
+    const UTransBuffer* TransBuffer = GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+    if (!TransBuffer)
+    {
+        return true;
+    }
+
+    // Records already undone in the editor sit above UndoCount and are left for redo
+    bool bForeignRecordSeen = false;
+    for (int32 Index = TransBuffer->UndoBuffer.Num() - TransBuffer->UndoCount - 1; Index >= 0; --Index)
+    {
+        if (TransBuffer->UndoBuffer[Index]->GetContext().Context != OpenContext)
+        {
+            bForeignRecordSeen = true;
+        }
+        else if (bForeignRecordSeen)
+        {
+            return false;
+        }
+        else
+        {
+            ++OutRecords;
+        }
+    }
+    return true;
+}
+
+int32 FUnrealMCPTransactionManager::EnforceMemoryBudget()
+{
+    check(IsInGameThread());
+    UTransBuffer* TransBuffer = GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr;
+    if (!TransBuffer)
+    {
+        return 0;
+    }
+
+    const uint64 Budget = (uint64)FMath::Max(GetDefault<UUnrealMCPSettings>()->MaxUndoMemoryMB, 1) * 1024 * 1024;
+    uint64 Bytes = 0;
+    for (const TSharedRef<FTransaction>& Transaction : TransBuffer->UndoBuffer)
+    {
+        if (IsMCPContext(Transaction->GetContext().Context))
+        {
+            Bytes += Transaction->DataSize();
+        }
+    }
+
+    // Only records that can still be undone are dropped, oldest first; undone ones are kept for redo,
+    // and the open group's are kept so that ending it with undo reverts all of its edits
+    int32 Limit = TransBuffer->UndoBuffer.Num() - TransBuffer->UndoCount;
+
+    int32 Dropped = 0;
+    for (int32 Index = 0; Index < Limit && Bytes > Budget; )
+    {
+        const FTransaction& Transaction = TransBuffer->UndoBuffer[Index].Get();
+        const FString& Context = Transaction.GetContext().Context;
+        if (!IsMCPContext(Context) || (IsOpen() && Context == OpenContext))
+        {
+            ++Index;
+            continue;
+        }
+
+        Bytes -= FMath::Min<uint64>(Bytes, Transaction.DataSize());
+        TransBuffer->UndoBuffer.RemoveAt(Index);
+        --Limit;
+        ++Dropped;
+    }
+
+    if (Dropped > 0)
+    {
+        TotalRecordsDropped += Dropped;
+        TransBuffer->OnUndoBufferChanged().Broadcast();
+        UE_LOG(LogUnrealMCP, Display, TEXT("UnrealMCPTransactionManager: Dropped the %d oldest MCP undo record(s) to stay within %llu MB"),
+            Dropped, Budget / (1024 * 1024));
+    }
+    return Dropped;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPTransactionManager::GetStats() const
+{
+    int32 Records = 0;
+    uint64 Bytes = 0;
+    if (GEditor && GEditor->Trans)
+    {
+        for (int32 Index = 0; Index < GEditor->Trans->GetQueueLength(); ++Index)
+        {
+            const FTransaction* Transaction = GEditor->Trans->GetTransaction(Index);
+            if (Transaction && IsMCPContext(Transaction->GetContext().Context))
+            {
+                ++Records;
+                Bytes += Transaction->DataSize();
+            }
+        }
+    }
+
+    TSharedPtr<FJsonObject> StatsJson = MakeShareable(new FJsonObject);
+    StatsJson->SetBoolField(TEXT("open"), IsOpen());
+    if (IsOpen())
+    {
+        StatsJson->SetStringField(TEXT("description"), OpenDescription);
+        StatsJson->SetNumberField(TEXT("commands"), OpenCommands);
+        int32 GroupRecords = 0;
+        CountUndoableGroupRecords(GroupRecords);
+        StatsJson->SetNumberField(TEXT("group_records"), GroupRecords);
+    }
+    StatsJson->SetNumberField(TEXT("undo_records"), Records);
+    StatsJson->SetNumberField(TEXT("undo_bytes"), (double)Bytes);
+    StatsJson->SetNumberField(TEXT("max_undo_bytes"), (double)FMath::Max(GetDefault<UUnrealMCPSettings>()->MaxUndoMemoryMB, 1) * 1024 * 1024);
+    StatsJson->SetNumberField(TEXT("records_dropped"), (double)TotalRecordsDropped);
+    return StatsJson;
+}
+
+bool FUnrealMCPTransactionManager::Tick(float DeltaTime)
+{
+    if (!IsOpen())
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    const float Timeout = GetDefault<UUnrealMCPSettings>()->TransactionIdleTimeoutSeconds;
+    if (Timeout > 0.0f && FPlatformTime::Seconds() - LastCommandTime > Timeout)
+    {
+        UE_LOG(LogUnrealMCP, Warning, TEXT("UnrealMCPTransactionManager: Ending transaction '%s' after %.0f s without a command"), *OpenDescription, Timeout);
+        int32 Commands = 0;
+        FString Error;
+        End(false, Commands, Error);
+        TickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FUnrealMCPCommandRegistry;
+
 /**
  * Handler class for Blueprint-related MCP commands
  */
@@ -11,8 +13,8 @@ class UNREALMCP_API FUnrealMCPBlueprintCommands
 public:
     FUnrealMCPBlueprintCommands();
 
-    // Handle blueprint commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register blueprint commands with the command registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     // Specific blueprint command handlers
@@ -21,7 +23,6 @@ private:
     TSharedPtr<FJsonObject> HandleSetComponentProperty(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetPhysicsProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleCompileBlueprint(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetBlueprintProperty(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetStaticMeshProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetPawnProperties(const TSharedPtr<FJsonObject>& Params);
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FUnrealMCPCommandRegistry;
+
 /**
  * Handler class for Blueprint Node-related MCP commands
  */
@@ -11,8 +13,8 @@ class UNREALMCP_API FUnrealMCPBlueprintNodeCommands
 public:
     FUnrealMCPBlueprintNodeCommands();
 
-    // Handle blueprint node commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register blueprint node commands with the command registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     // Specific blueprint node command handlers
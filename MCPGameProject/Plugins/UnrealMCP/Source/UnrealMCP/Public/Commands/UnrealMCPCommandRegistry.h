@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+class FUnrealMCPResponseWriter;
+
+/** Signature of every MCP command handler: JSON params in, JSON result out */
+DECLARE_DELEGATE_RetVal_OneParam(TSharedPtr<FJsonObject>, FUnrealMCPCommandHandler, const TSharedPtr<FJsonObject>& /*Params*/);
+
+/**
+ * Signature of a streaming command handler, used by commands with bulk results
+ * The handler writes the fields of its result object into Writer, whose result object is
+ * already open. On failure it returns false with OutError set; anything already written is discarded.
+ */
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FUnrealMCPStreamingCommandHandler, const TSharedPtr<FJsonObject>& /*Params*/, FUnrealMCPResponseWriter& /*Writer*/, FString& /*OutError*/);
+
+/** Thread a command handler has to run on */
+enum class EUnrealMCPCommandThread : uint8
+{
+    /** Touches UObjects or editor state, so it is marshalled to the game thread */
+    GameThread,
+    /** Thread-safe, so it runs directly on the client session thread and never waits for a frame */
+    AnyThread,
+};
+
+/** Lane name reported in responses and by list_commands */
+UNREALMCP_API const TCHAR* LexToString(EUnrealMCPCommandThread Thread);
+
+/** A registered command */
+struct FUnrealMCPCommand
+{
+    FString Category;
+    EUnrealMCPCommandThread Thread = EUnrealMCPCommandThread::GameThread;
+    FUnrealMCPCommandHandler Handler;
+    /** Set instead of Handler for commands that write their result without building an object tree */
+    FUnrealMCPStreamingCommandHandler StreamingHandler;
+};
+
+/**
+ * Name-keyed table of every command the bridge can execute
+ * Each handler class registers its commands once, so dispatch is a single
+ * hash lookup and the list of supported commands lives in one place.
+ */
+class UNREALMCP_API FUnrealMCPCommandRegistry
+{
+public:
+    /**
+     * Register a command handler
+     * @param CommandName - Name clients use in the "type" field
+     * @param Category - Group reported by list_commands (e.g. "editor", "blueprint")
+     * @param Handler - Delegate that executes the command
+     * @param Thread - Thread the handler may run on; only declare AnyThread for handlers that never touch UObjects
+     * @return false if the name is already registered; the existing handler is kept
+     */
+    bool Register(FName CommandName, const FString& Category, FUnrealMCPCommandHandler Handler, EUnrealMCPCommandThread Thread = EUnrealMCPCommandThread::GameThread);
+
+    /** Register a streaming command handler; see FUnrealMCPStreamingCommandHandler */
+    bool Register(FName CommandName, const FString& Category, FUnrealMCPStreamingCommandHandler Handler, EUnrealMCPCommandThread Thread = EUnrealMCPCommandThread::GameThread);
+
+    /** Find a command, or nullptr if none is registered under that name */
+    const FUnrealMCPCommand* Find(FName CommandName) const;
+
+    /** Find a command by a name received from a client, without adding unknown names to the name table */
+    const FUnrealMCPCommand* Find(const FString& CommandName) const;
+
+    /** Number of registered commands */
+    int32 Num() const { return Commands.Num(); }
+
+    /** Names of every registered command, in no particular order */
+    void GetCommandNames(TArray<FName>& OutNames) const { Commands.GetKeys(OutNames); }
+
+    /** Build the list_commands result: every command name with its category, thread and whether it streams, sorted by name */
+    TSharedPtr<FJsonObject> ListCommands() const;
+
+private:
+    /** Add an entry for CommandName, or return nullptr if the name is taken */
+    FUnrealMCPCommand* Add(FName CommandName, const FString& Category, EUnrealMCPCommandThread Thread);
+
+    TMap<FName, FUnrealMCPCommand> Commands;
+};
@@ -5,6 +5,8 @@
 
 // Forward declarations
 class AActor;
+class FUnrealMCPActorIndex;
+class FUnrealMCPCompileScheduler;
 class UBlueprint;
 class UEdGraph;
 class UEdGraphNode;
@@ -16,6 +18,7 @@ class UK2Node_VariableSet;
 class UK2Node_InputAction;
 class UK2Node_Self;
 class UFunction;
+class UClass;
 
 /**
  * Common utilities for UnrealMCP commands
@@ -33,13 +36,25 @@ public:
     static FRotator GetRotatorFromJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& FieldName);
     
     // Actor utilities
+    static FUnrealMCPActorIndex* GetActorIndex();
+    static AActor* FindActorByName(const FString& ActorName);
+    static AActor* FindActorByLabel(const FString& ActorLabel);
     static TSharedPtr<FJsonValue> ActorToJson(AActor* Actor);
     static TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, bool bDetailed = false);
     
+    // Class utilities
+    static UClass* FindClassByName(const FString& ClassName, const UClass* BaseClass = nullptr);
+    static FString GetClassSuggestionText(const FString& ClassName, const UClass* BaseClass = nullptr);
+    
     // Blueprint utilities
     static UBlueprint* FindBlueprint(const FString& BlueprintName);
     static UBlueprint* FindBlueprintByName(const FString& BlueprintName);
+    static UBlueprint* FindWidgetBlueprint(const FString& BlueprintName);
     static UEdGraph* FindOrCreateEventGraph(UBlueprint* Blueprint);
+    static FUnrealMCPCompileScheduler* GetCompileScheduler();
+    /** Queue Blueprint for a deferred compile; with bSave its package is saved after that compile */
+    static void MarkBlueprintForCompile(UBlueprint* Blueprint, bool bSave = false);
+    static void FlushBlueprintCompile(UBlueprint* Blueprint);
     
     // Blueprint node utilities
     static UK2Node_Event* CreateEventNode(UEdGraph* Graph, const FString& EventName, const FVector2D& Position);
@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FUnrealMCPCommandRegistry;
+class FUnrealMCPResponseWriter;
+
 /**
  * Handler class for Editor-related MCP commands
  * Handles viewport control, actor manipulation, and level management
@@ -12,17 +15,19 @@ class UNREALMCP_API FUnrealMCPEditorCommands
 public:
     FUnrealMCPEditorCommands();
 
-    // Handle editor commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register editor commands with the command registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
+    // Actor queries; these return many actors, so they stream their results
+    bool HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params, FUnrealMCPResponseWriter& Writer, FString& OutError);
+    bool HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params, FUnrealMCPResponseWriter& Writer, FString& OutError);
+    bool HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params, FUnrealMCPResponseWriter& Writer, FString& OutError);
+
     // Actor manipulation commands
-    TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSpawnActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params);
 
     // Blueprint actor spawning
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FUnrealMCPCommandRegistry;
+
 /**
  * Handler class for Project-wide MCP commands
  */
@@ -11,10 +13,12 @@ class UNREALMCP_API FUnrealMCPProjectCommands
 public:
     FUnrealMCPProjectCommands();
 
-    // Handle project commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register project commands with the command registry
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     // Specific project command handlers
     TSharedPtr<FJsonObject> HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindAssets(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleListBlueprints(const TSharedPtr<FJsonObject>& Params);
 }; 
\ No newline at end of file
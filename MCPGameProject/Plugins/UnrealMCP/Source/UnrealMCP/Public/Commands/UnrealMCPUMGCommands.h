@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Json.h"
 
+class FUnrealMCPCommandRegistry;
+
 /**
  * Handles UMG (Widget Blueprint) related MCP commands
  * Responsible for creating and modifying UMG Widget Blueprints,
@@ -14,12 +16,10 @@ public:
     FUnrealMCPUMGCommands();
 
     /**
-     * Handle UMG-related commands
-     * @param CommandType - The type of command to handle
-     * @param Params - JSON parameters for the command
-     * @return JSON response with results or error
+     * Register the UMG commands with the bridge's command registry
+     * @param Registry - Registry that dispatches incoming commands
      */
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     /**
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/Queue.h"
+#include "Sockets.h"
+#include "MCPProtocol.h"
+#include "UnrealMCPServerStats.h"
+#include "UnrealMCPTraceRecorder.h"
+#include <atomic>
+
+class UUnrealMCPBridge;
+class FRunnableThread;
+class FJsonObject;
+class FMCPReceiveBuffer;
+struct FUnrealMCPResponse;
+
+/**
+ * One connected client.
+ *
+ * Each session runs its own thread that reads and parses the client's messages and
+ * hands the commands to UUnrealMCPBridge, which queues them on the game thread. The
+ * game-thread task queue is therefore the dispatch queue shared by all sessions.
+ * The connection is kept open until the client disconnects, and the message framing
+ * is detected from the first bytes received (see MCPProtocol.h).
+ *
+ * A request carrying an "id" field is pipelined: the session keeps reading while it
+ * executes, and its response, tagged with the same id, is written when it completes.
+ * Requests without an id are answered before the next message is read.
+ *
+ * Framed requests may set "encoding" to have their response encoded as CBOR instead of JSON.
+ * Responses built as objects are never encoded on the game thread: the session thread encodes
+ * and sends the responses it waits for, and the responses of pipelined requests, which complete
+ * on the game thread, go through the session's send queue, drained by a thread-pool task. The
+ * game thread therefore never waits for a client that is slow to read.
+ *
+ * Every answered command is timed from the read that brought its first byte to the write of
+ * its last, and recorded in the bridge's FUnrealMCPServerStats, and in its trace while one is
+ * being recorded.
+ */
+class FMCPClientSession : public FRunnable
+{
+public:
+	FMCPClientSession(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InSocket, int32 InSessionId);
+	virtual ~FMCPClientSession();
+
+	/** Starts the session's read thread */
+	bool Start();
+
+	/** True once the read loop has exited, after which the session can be destroyed */
+	bool IsFinished() const { return bFinished; }
+
+	int32 GetSessionId() const { return SessionId; }
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+protected:
+	/** Message framing used by a client connection */
+	enum class EMessageFraming : uint8
+	{
+		Unknown,
+		Framed,
+		Newline,
+		Legacy,
+	};
+
+	/** Write side of the connection, shared with completion callbacks and send tasks that may outlive the session */
+	class FResponseWriter : public TSharedFromThis<FResponseWriter, ESPMode::ThreadSafe>
+	{
+	public:
+		FResponseWriter(TSharedPtr<FSocket> InSocket, TSharedPtr<FUnrealMCPServerStats, ESPMode::ThreadSafe> InStats, TSharedPtr<FUnrealMCPTraceRecorder, ESPMode::ThreadSafe> InTraceRecorder);
+		~FResponseWriter();
+
+		/** Sends one response; safe to call from any thread */
+		void SendResponse(const FString& Response, EMessageFraming Framing);
+
+		/**
+		 * Encodes and sends one response; only framed connections can use an encoding other than JSON
+		 * Timing, if given, receives the times the response was encoded and sent.
+		 * Returns the size of the encoded payload.
+		 */
+		int32 SendResponse(const TSharedPtr<FJsonObject>& Response, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPCommandTiming* Timing = nullptr);
+
+		/**
+		 * Sends a command response, encoding it first unless it was streamed, and records its timing
+		 * TraceRecord, if given, holds the request's command and parameters and is written to the trace.
+		 */
+		void SendResponse(const FUnrealMCPResponse& Response, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPTraceRecord* TraceRecord = nullptr);
+
+		/**
+		 * Queues a command response and returns at once; a thread-pool task encodes and sends it
+		 * Safe to call from any thread. Queued responses are sent in the order they were queued.
+		 */
+		void QueueResponse(FUnrealMCPResponse&& Response, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, TSharedPtr<FUnrealMCPTraceRecord> TraceRecord);
+
+	private:
+		struct FQueuedResponse;
+
+		/** Sends queued responses until none are left; only one drain task runs at a time */
+		void DrainQueue();
+
+		/** Frames an encoded payload and writes it to the socket */
+		void SendPayload(const uint8* Payload, int32 PayloadSize, EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPCommandTiming* Timing);
+
+		/** Starts a message in SendBuffer, leaving room for the frame header; SendLock must be held */
+		void BeginMessage(EMessageFraming Framing);
+
+		/** Completes the message whose payload was appended after BeginMessage and sends it; SendLock must be held */
+		void FinishMessage(EMessageFraming Framing, MCPProtocol::EMCPPayloadEncoding Encoding, FUnrealMCPCommandTiming* Timing = nullptr);
+
+		/** Writes all Size bytes, waiting while the socket's send buffer is full */
+		bool SendAll(const uint8* Data, int32 Size);
+
+		TSharedPtr<FSocket> Socket;
+		FCriticalSection SendLock;
+
+		/** Where answered commands are recorded; may be null */
+		TSharedPtr<FUnrealMCPServerStats, ESPMode::ThreadSafe> Stats;
+
+		/** Where answered commands are traced while a recording is on; may be null */
+		TSharedPtr<FUnrealMCPTraceRecorder, ESPMode::ThreadSafe> TraceRecorder;
+
+		/** Header, payload and terminator of the message being sent, reused between messages; guarded by SendLock */
+		TArray<uint8> SendBuffer;
+
+		/** Set when a send failed part way; the stream can't be resynchronized, so nothing more is written */
+		bool bBroken;
+
+		/** Responses waiting for the drain task */
+		TQueue<TUniquePtr<FQueuedResponse>, EQueueMode::Mpsc> SendQueue;
+
+		/** Number of responses queued and not sent yet; the one that makes it non-zero starts the drain task */
+		std::atomic<int32> QueuedResponses;
+	};
+
+	/** Processes every complete message in ReceiveBuffer; returns false on a protocol error */
+	bool ProcessReceivedData(FMCPReceiveBuffer& ReceiveBuffer, EMessageFraming& Framing);
+	/** Parses one complete message and starts its timing in MessageTiming */
+	bool ParseMessage(const uint8* Data, int32 Size, TSharedPtr<FJsonObject>& OutJsonMessage);
+	void ProcessMessage(const TSharedPtr<FJsonObject>& JsonMessage, EMessageFraming Framing);
+	void SendResponse(const FString& Response, EMessageFraming Framing);
+
+	/** The response encoding a request asks for; JSON unless the connection is framed */
+	MCPProtocol::EMCPPayloadEncoding GetResponseEncoding(const TSharedPtr<FJsonObject>& JsonMessage, EMessageFraming Framing) const;
+
+private:
+	UUnrealMCPBridge* Bridge;
+	TSharedPtr<FSocket> Socket;
+	TSharedRef<FResponseWriter, ESPMode::ThreadSafe> Writer;
+	FRunnableThread* Thread;
+	int32 SessionId;
+	std::atomic<bool> bRunning;
+	std::atomic<bool> bFinished;
+
+	/** Time of the read that brought the first byte of the next message */
+	uint64 MessageStartCycles;
+
+	/** Time of the latest read */
+	uint64 LastReceiveCycles;
+
+	/** Timing of the message being processed */
+	FUnrealMCPCommandTiming MessageTiming;
+};
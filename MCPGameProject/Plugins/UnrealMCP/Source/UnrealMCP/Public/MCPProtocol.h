@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Wire protocol shared by the MCP server and its clients.
+ *
+ * Three framings are accepted on a connection, selected by the first byte the client sends:
+ *  - Framed:  every message is prefixed with an 8 byte header (see below). Used by current clients.
+ *  - Newline: every message is a JSON object terminated by '\n'.
+ *  - Legacy:  one unterminated JSON object per request, answered as soon as it parses. The response
+ *             ends with '\n' like a newline one, so a newline client whose first message arrived
+ *             split before its terminator is answered correctly too.
+ *
+ * Unframed messages larger than MaxPayloadSize are a protocol error, like oversized frames.
+ *
+ * Frame header layout (all multi-byte fields big-endian):
+ *   [0..1] magic 'U' 'M'
+ *   [2]    protocol version
+ *   [3]    payload encoding (EMCPPayloadEncoding)
+ *   [4..7] payload length in bytes
+ *
+ * Requests are always JSON. A framed client may ask for a compact response encoding by adding
+ * "encoding": "cbor" to a request; the header of each response frame says which encoding its
+ * payload actually uses, so a client can mix encodings on one connection. Servers that do not
+ * know the field ignore it and answer in JSON, which is also what unframed connections get.
+ */
+namespace MCPProtocol
+{
+	constexpr uint8 FrameMagic0 = 'U';
+	constexpr uint8 FrameMagic1 = 'M';
+	constexpr uint8 FrameVersion = 1;
+	constexpr int32 FrameHeaderSize = 8;
+
+	/** Upper bound on a single payload; larger frames are treated as a protocol error */
+	constexpr uint32 MaxPayloadSize = 64 * 1024 * 1024;
+
+	/** How the payload bytes of a frame are encoded */
+	enum class EMCPPayloadEncoding : uint8
+	{
+		/** UTF-8 JSON text */
+		Json = 0,
+		/** CBOR (RFC 8949): indefinite-length maps and arrays, integral numbers as integers, strings as UTF-8 */
+		Cbor = 1,
+	};
+
+	struct FFrameHeader
+	{
+		uint8 Version = FrameVersion;
+		EMCPPayloadEncoding Encoding = EMCPPayloadEncoding::Json;
+		uint32 PayloadSize = 0;
+	};
+
+	/** Writes a frame header for a payload of the given size into OutHeader */
+	inline void WriteFrameHeader(uint8 (&OutHeader)[FrameHeaderSize], uint32 PayloadSize, EMCPPayloadEncoding Encoding = EMCPPayloadEncoding::Json)
+	{
+		OutHeader[0] = FrameMagic0;
+		OutHeader[1] = FrameMagic1;
+		OutHeader[2] = FrameVersion;
+		OutHeader[3] = static_cast<uint8>(Encoding);
+		OutHeader[4] = static_cast<uint8>(PayloadSize >> 24);
+		OutHeader[5] = static_cast<uint8>(PayloadSize >> 16);
+		OutHeader[6] = static_cast<uint8>(PayloadSize >> 8);
+		OutHeader[7] = static_cast<uint8>(PayloadSize);
+	}
+
+	/** Parses a frame header. Returns false if the magic does not match. */
+	inline bool ReadFrameHeader(const uint8* Data, FFrameHeader& OutHeader)
+	{
+		if (Data[0] != FrameMagic0 || Data[1] != FrameMagic1)
+		{
+			return false;
+		}
+
+		OutHeader.Version = Data[2];
+		OutHeader.Encoding = static_cast<EMCPPayloadEncoding>(Data[3]);
+		OutHeader.PayloadSize = (static_cast<uint32>(Data[4]) << 24)
+			| (static_cast<uint32>(Data[5]) << 16)
+			| (static_cast<uint32>(Data[6]) << 8)
+			| static_cast<uint32>(Data[7]);
+		return true;
+	}
+
+	/** Parses an encoding name sent by a client ("json" or "cbor", case-insensitive). Returns false for unknown names. */
+	UNREALMCP_API bool LexTryParseEncoding(const FString& Name, EMCPPayloadEncoding& OutEncoding);
+
+	/**
+	 * Serializes a message and appends it to OutBytes using the given encoding.
+	 * Both encodings are written straight from the object tree without an intermediate string.
+	 */
+	UNREALMCP_API void EncodePayload(const TSharedRef<FJsonObject>& Message, EMCPPayloadEncoding Encoding, TArray<uint8>& OutBytes);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bytes received on one connection that have not been consumed as messages yet.
+ *
+ * Data is received straight into the free space at the end of the buffer, and consuming a
+ * message only advances the read position, so nothing is copied per message. Pending bytes
+ * are moved to the front only when the free space runs out, and the buffer doubles when they
+ * still don't fit, which keeps every message contiguous for the JSON parser.
+ *
+ * Delimiters are found incrementally: each scan starts where the previous one stopped, so
+ * a message that arrives in many small reads is scanned once rather than once per read.
+ * Only used by the session thread that owns the connection.
+ */
+class FMCPReceiveBuffer
+{
+public:
+	FMCPReceiveBuffer();
+
+	/**
+	 * Returns the free space at the end of the buffer, making room for at least MinSize bytes
+	 * @param OutSize Receives the number of bytes that can be written
+	 */
+	uint8* PrepareWrite(int32 MinSize, int32& OutSize);
+
+	/** Adds Size bytes written to the space returned by PrepareWrite */
+	void CommitWrite(int32 Size);
+
+	/** Pending bytes, starting at the first unconsumed one */
+	const uint8* GetData() const { return Data.GetData() + ReadOffset; }
+	int32 Num() const { return WriteOffset - ReadOffset; }
+
+	/** Drops the first Size pending bytes; they stay readable until the next PrepareWrite */
+	void Consume(int32 Size);
+
+	/** Makes room for Size pending bytes, e.g. a frame whose header has arrived, so it is received without regrowing */
+	void Reserve(int32 Size);
+
+	/** Offset of the first pending '\n', or INDEX_NONE; only bytes received since the last call are scanned */
+	int32 FindNewline();
+
+	/**
+	 * Length of the JSON object at the start of the pending bytes if it is complete, or INDEX_NONE
+	 * Brackets are counted outside of strings only; the object is not validated.
+	 */
+	int32 FindObjectEnd();
+
+private:
+	/** Moves the pending bytes to the front of the buffer */
+	void Compact();
+
+	TArray<uint8> Data;
+	int32 ReadOffset;
+	int32 WriteOffset;
+
+	// Incremental scan positions, relative to the start of Data
+	int32 NewlineScanOffset;
+	int32 ObjectScanOffset;
+
+	// Object scan state; ObjectEndOffset is set once the object's closing bracket has been seen
+	int32 ObjectEndOffset;
+	int32 ObjectDepth;
+	bool bInString;
+	bool bEscaped;
+};
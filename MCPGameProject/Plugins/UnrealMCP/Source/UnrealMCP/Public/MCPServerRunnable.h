@@ -4,11 +4,21 @@
 #include "HAL/Runnable.h"
 #include "Sockets.h"
 #include "Interfaces/IPv4/IPv4Address.h"
+#include <atomic>
 
 class UUnrealMCPBridge;
+class FMCPClientSession;
 
 /**
  * Runnable class for the MCP server thread
+ *
+ * Accepts client connections and hands each one to its own FMCPClientSession,
+ * so several clients can be served concurrently. The number of simultaneous
+ * sessions is capped by UUnrealMCPSettings::MaxConcurrentSessions.
+ *
+ * The thread blocks in Accept() and sessions block in Recv(), so a server without
+ * clients does not wake up at all; Stop() releases the blocked calls. While sessions
+ * are running, the thread wakes once a second to reap those that have finished.
  */
 class FMCPServerRunnable : public FRunnable
 {
@@ -23,12 +33,16 @@ public:
 	virtual void Exit() override;
 
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
+	void AcceptClient(TSharedPtr<FSocket> ClientSocket);
+	void ReapFinishedSessions();
+
+	/** Unblocks the Accept() call in Run() by connecting to the listener */
+	void WakeListener();
 
 private:
 	UUnrealMCPBridge* Bridge;
 	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
-	bool bRunning;
-}; 
\ No newline at end of file
+	TArray<TUniquePtr<FMCPClientSession>> Sessions;
+	int32 NextSessionId;
+	std::atomic<bool> bRunning;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UClass;
+class UWorld;
+
+/**
+ * Lookup tables for the actors of the editor world
+ * Maps actor labels, object names and classes to the actors that use them so that
+ * name-based commands don't have to scan every actor in the level. The index is
+ * kept up to date from the engine's actor added/deleted, label changed and object
+ * renamed events, and rebuilt lazily when the editor world changes or after undo/redo.
+ * Entries of actors that died without an event are pruned when they are found.
+ * Must only be used on the game thread.
+ */
+class UNREALMCP_API FUnrealMCPActorIndex
+{
+public:
+    FUnrealMCPActorIndex();
+    ~FUnrealMCPActorIndex();
+
+    /** Subscribe to the editor events that keep the index current */
+    void Initialize();
+
+    /** Unsubscribe from editor events and drop all entries */
+    void Shutdown();
+
+    /** Find an actor by label, falling back to its object name; returns nullptr if there is none */
+    AActor* FindActorByName(const FString& Name);
+
+    /** Find an actor whose label matches exactly (case-insensitive) */
+    AActor* FindActorByLabel(const FString& Label);
+
+    /** Collect the actors whose class is exactly Class, or derives from it when bIncludeSubclasses is set */
+    void GetActorsOfClass(const UClass* Class, TArray<AActor*>& OutActors, bool bIncludeSubclasses = true);
+
+    /**
+     * Collect the actors whose class, or one of its parent classes, is named ClassName (e.g. "StaticMeshActor", "BP_Door_C")
+     * Only the classes present in the level are checked, so no global class lookup is needed.
+     */
+    void GetActorsOfClass(const FString& ClassName, TArray<AActor*>& OutActors);
+
+    /** Number of live actors currently indexed */
+    int32 Num();
+
+    /** An actor and the object name it was sorted under */
+    struct FNamedActor
+    {
+        FName Name;
+        TWeakObjectPtr<AActor> Actor;
+    };
+
+    /**
+     * Every indexed actor ordered by object name (FName::LexicalLess), the order pages of actors are listed in
+     * Sorted once and kept until an actor is added, removed or renamed, so a cursor can be found by binary search.
+     * Entries may refer to actors that died since; skip those.
+     */
+    const TArray<FNamedActor>& GetActorsSortedByName();
+
+private:
+    /** Rebuild the tables if the editor world changed or an event invalidated them */
+    void EnsureUpToDate();
+    void Rebuild(UWorld* World);
+    void Reset();
+
+    /** Collect the actors of every indexed class that ClassFilter accepts */
+    void CollectActors(TFunctionRef<bool(const UClass*)> ClassFilter, TArray<AActor*>& OutActors);
+
+    void AddActor(AActor* Actor);
+    void RemoveActor(AActor* Actor);
+
+    /** Drop the entries of actors that were destroyed or garbage collected without a deleted event */
+    void PruneDeadEntries();
+
+    // Editor event handlers
+    void OnLevelActorAdded(AActor* Actor);
+    void OnLevelActorDeleted(AActor* Actor);
+    void OnActorLabelChanged(AActor* Actor);
+    void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName);
+    void OnInvalidated();
+
+    /** Keys an actor was indexed under, so its entries can be removed after it was relabelled, renamed or destroyed */
+    struct FIndexedActor
+    {
+        FString Label;
+        FName Name;
+        TWeakObjectPtr<UClass> Class;
+    };
+
+    TMultiMap<FString, TWeakObjectPtr<AActor>> ActorsByLabel;
+    TMultiMap<FName, TWeakObjectPtr<AActor>> ActorsByName;
+    TMap<TWeakObjectPtr<UClass>, TSet<TWeakObjectPtr<AActor>>> ActorsByClass;
+
+    TMap<TWeakObjectPtr<AActor>, FIndexedActor> IndexedActors;
+
+    /** Built by GetActorsSortedByName; empty while bSortedDirty */
+    TArray<FNamedActor> ActorsSortedByName;
+    bool bSortedDirty;
+
+    /** Set when a lookup came across a dead entry */
+    bool bHasDeadEntries;
+
+    TWeakObjectPtr<UWorld> IndexedWorld;
+    bool bDirty;
+
+    FDelegateHandle LevelActorAddedHandle;
+    FDelegateHandle LevelActorDeletedHandle;
+    FDelegateHandle ActorLabelChangedHandle;
+    FDelegateHandle ObjectRenamedHandle;
+    FDelegateHandle PostUndoRedoHandle;
+    FDelegateHandle MapChangeHandle;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FJsonObject;
+class UBlueprint;
+class UClass;
+
+/**
+ * Name lookup for the project's Blueprint assets
+ * Indexes every Blueprint (including Widget Blueprints) known to the Asset Registry by
+ * asset name, so commands can resolve a Blueprint by name wherever it lives without
+ * probing hard-coded paths. Resolved Blueprints are cached as weak pointers, so repeat
+ * lookups neither search nor load anything. The index follows the registry's asset
+ * added, removed and renamed events.
+ * Must only be used on the game thread.
+ */
+class UNREALMCP_API FUnrealMCPAssetCache
+{
+public:
+    FUnrealMCPAssetCache();
+    ~FUnrealMCPAssetCache();
+
+    /** Subscribe to the Asset Registry events that keep the index current */
+    void Initialize();
+
+    /** Unsubscribe from Asset Registry events and drop all entries */
+    void Shutdown();
+
+    /**
+     * Find a Blueprint by asset name, or by object path when Name starts with '/'
+     * @param BlueprintClass Only accept Blueprints of this type, e.g. UWidgetBlueprint
+     * @param PreferredPath When several assets share the name, the one in this folder wins
+     * @return The loaded Blueprint, or nullptr if there is none
+     */
+    UBlueprint* FindBlueprint(const FString& Name, const UClass* BlueprintClass, const FString& PreferredPath);
+
+    /** Hit and miss counters of the lookup cache */
+    TSharedPtr<FJsonObject> GetStats() const;
+
+private:
+    /** Build the name index from the Asset Registry on first use */
+    void EnsureIndexed();
+    void Reset();
+
+    void AddAsset(const FAssetData& AssetData);
+    void RemoveAsset(FName AssetName, const FSoftObjectPath& ObjectPath);
+
+    // Asset Registry event handlers
+    void OnAssetAdded(const FAssetData& AssetData);
+    void OnAssetRemoved(const FAssetData& AssetData);
+    void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+    /** Every Blueprint asset in the project, by asset name */
+    TMultiMap<FName, FAssetData> AssetsByName;
+
+    /** Blueprints already loaded by a lookup, by the name they were looked up with */
+    TMap<FString, TWeakObjectPtr<UBlueprint>> Resolved;
+
+    bool bIndexed;
+
+    // Lookup statistics
+    int64 Hits;
+    int64 Misses;
+    int64 NotFound;
+    int64 Invalidations;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+};
@@ -13,10 +13,38 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "MCPProtocol.h"
+#include "UnrealMCPActorIndex.h"
+#include "UnrealMCPAssetCache.h"
+#include "UnrealMCPClassIndex.h"
+#include "UnrealMCPCompileScheduler.h"
+#include "UnrealMCPServerStats.h"
+#include "UnrealMCPTraceRecorder.h"
+#include "UnrealMCPTransactionManager.h"
 #include "UnrealMCPBridge.generated.h"
 
 class FMCPServerRunnable;
 
+/** A command's response, ready for a client session to send */
+struct FUnrealMCPResponse
+{
+	/** Response object the session still has to encode; null if the response was streamed into Payload */
+	TSharedPtr<FJsonObject> Object;
+
+	/** Complete payload written by a streaming handler */
+	TArray<uint8> Payload;
+
+	/** Encoding of Payload */
+	MCPProtocol::EMCPPayloadEncoding Encoding = MCPProtocol::EMCPPayloadEncoding::Json;
+
+	/** Command the response answers; NAME_None for unknown commands */
+	FName Command;
+
+	/** When the request reached each point of the server, up to the end of its handler */
+	FUnrealMCPCommandTiming Timing;
+};
+
 /**
  * Editor subsystem for MCP Bridge
  * Handles communication between external tools and the Unreal Editor
@@ -41,14 +69,103 @@ public:
 	void StopServer();
 	bool IsRunning() const { return bIsRunning; }
 
-	// Command execution
-	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	/** Name and class lookup for the actors of the editor world; game thread only */
+	FUnrealMCPActorIndex& GetActorIndex() { return ActorIndex; }
+
+	/** Deferred compilation of the Blueprints that commands edit; game thread only */
+	FUnrealMCPCompileScheduler& GetCompileScheduler() { return CompileScheduler; }
+
+	/** Name lookup for Blueprint assets; game thread only */
+	FUnrealMCPAssetCache& GetAssetCache() { return AssetCache; }
+
+	/** Name lookup for classes; game thread only */
+	FUnrealMCPClassIndex& GetClassIndex() { return ClassIndex; }
+
+	/** Undo groups opened by begin_transaction and batch; game thread only */
+	FUnrealMCPTransactionManager& GetTransactionManager() { return TransactionManager; }
+
+	/** Latency statistics that sessions record their requests in; valid while the subsystem is initialized, safe to use from any thread */
+	TSharedPtr<FUnrealMCPServerStats, ESPMode::ThreadSafe> GetServerStats() const { return ServerStats; }
+
+	/** Trace that sessions record their requests in while a recording is on; valid while the subsystem is initialized, safe to use from any thread */
+	TSharedPtr<FUnrealMCPTraceRecorder, ESPMode::ThreadSafe> GetTraceRecorder() const { return TraceRecorder; }
+
+	/**
+	 * Runs a command and waits for its {status, result|error} response.
+	 * Streaming commands return a payload already written in Encoding; other responses are
+	 * returned as objects and not serialized here, so the caller can encode them off the game thread.
+	 * Timing holds the times the request has already passed; the response carries them on to the handler's end.
+	 */
+	FUnrealMCPResponse ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, MCPProtocol::EMCPPayloadEncoding Encoding = MCPProtocol::EMCPPayloadEncoding::Json, const FUnrealMCPCommandTiming& Timing = FUnrealMCPCommandTiming());
+
+	/**
+	 * Queues a command on the game thread and returns immediately.
+	 * OnComplete is called on the game thread with the response; commands
+	 * registered as AnyThread complete on the calling thread before this returns.
+	 * OnComplete must not block or encode the response: it should hand it on, e.g. to a send queue.
+	 * A valid RequestId is echoed in the response's "id" field.
+	 */
+	void ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId, MCPProtocol::EMCPPayloadEncoding Encoding, const FUnrealMCPCommandTiming& Timing, TFunction<void(FUnrealMCPResponse&&)> OnComplete);
 
 private:
+	/** Thread the command is registered for; unknown commands report AnyThread */
+	EUnrealMCPCommandThread GetCommandThread(const FString& CommandType) const;
+
+	/**
+	 * Routes a command to its handler and builds the response, including the lane it ran on
+	 * and how long it waited there since Timing.Enqueued. Must be called on the command's thread.
+	 */
+	FUnrealMCPResponse ExecuteQueuedCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId, const FUnrealMCPCommandTiming& Timing, MCPProtocol::EMCPPayloadEncoding Encoding);
+
+	/**
+	 * Writes the complete response of a streaming command into OutPayload, envelope included,
+	 * without building an object tree. Returns false with OutError set if the handler fails.
+	 */
+	bool StreamCommandResponse(const FUnrealMCPCommand& Command, const TSharedPtr<FJsonObject>& Params, const TSharedPtr<FJsonValue>& RequestId, EUnrealMCPCommandThread Thread, double QueueTimeMs, MCPProtocol::EMCPPayloadEncoding Encoding, TArray<uint8>& OutPayload, FString& OutError);
+
+	/** Runs a command and wraps its result in a {status, result|error} response object */
+	TSharedPtr<FJsonObject> BuildCommandResponse(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	/** Registers the bridge's own commands and those of every handler class */
+	void RegisterCommands();
+
+	/** Dispatches a command to the handler that implements it and returns the handler's result */
+	TSharedPtr<FJsonObject> RouteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	/**
+	 * Runs the {type, params} entries of a "batch" command one after another in the
+	 * current game-thread task and collects one response object per entry. Blueprints
+	 * edited by the batch are compiled once at the end.
+	 */
+	TSharedPtr<FJsonObject> HandleBatchCommand(const TSharedPtr<FJsonObject>& Params);
+
+	/**
+	 * Runs a streaming command repeatedly, once through an object tree and once streamed,
+	 * and reports the time, allocations and payload size of each way of building the response.
+	 */
+	TSharedPtr<FJsonObject> HandleBenchmarkSerialization(const TSharedPtr<FJsonObject>& Params);
+
+	/** Reports the latency statistics of the commands answered so far, optionally of one command, and can reset them */
+	TSharedPtr<FJsonObject> HandleGetServerStats(const TSharedPtr<FJsonObject>& Params);
+
+	/** Opens an undo group that the following commands are recorded in, until end_transaction */
+	TSharedPtr<FJsonObject> HandleBeginTransaction(const TSharedPtr<FJsonObject>& Params);
+
+	/** Closes the open undo group, optionally undoing it */
+	TSharedPtr<FJsonObject> HandleEndTransaction(const TSharedPtr<FJsonObject>& Params);
+
+	/** Starts recording requests to a trace file, by default one under Saved/UnrealMCP/Traces */
+	TSharedPtr<FJsonObject> HandleStartTraceRecording(const TSharedPtr<FJsonObject>& Params);
+
+	/** Stops the trace recording and reports the file and the number of requests recorded */
+	TSharedPtr<FJsonObject> HandleStopTraceRecording(const TSharedPtr<FJsonObject>& Params);
+
+	/** Writes the latency statistics to Saved/UnrealMCP if the settings ask for it */
+	void WriteServerStatsCsv() const;
+
 	// Server state
 	bool bIsRunning;
 	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ConnectionSocket;
 	FRunnableThread* ServerThread;
 
 	// Server configuration
@@ -61,4 +178,31 @@ private:
 	TSharedPtr<FUnrealMCPBlueprintNodeCommands> BlueprintNodeCommands;
 	TSharedPtr<FUnrealMCPProjectCommands> ProjectCommands;
 	TSharedPtr<FUnrealMCPUMGCommands> UMGCommands;
+
+	// Every command the bridge can execute, keyed by name
+	FUnrealMCPCommandRegistry CommandRegistry;
+
+	// Actor lookup tables shared by the command handlers
+	FUnrealMCPActorIndex ActorIndex;
+
+	// Blueprints edited by commands and waiting to be compiled
+	FUnrealMCPCompileScheduler CompileScheduler;
+
+	// Blueprint assets by name, and the ones already loaded by a lookup
+	FUnrealMCPAssetCache AssetCache;
+
+	// Class names and aliases used by commands that take a class
+	FUnrealMCPClassIndex ClassIndex;
+
+	// Undo group spanning several commands, and the memory budget of MCP undo records
+	FUnrealMCPTransactionManager TransactionManager;
+
+	// Payload buffer reused by streaming commands on the game thread
+	TArray<uint8> StreamBuffer;
+
+	// Per-command latency histograms, shared with the sessions that record into them
+	TSharedPtr<FUnrealMCPServerStats, ESPMode::ThreadSafe> ServerStats;
+
+	// Binary trace of the requests answered, shared with the sessions that record into it
+	TSharedPtr<FUnrealMCPTraceRecorder, ESPMode::ThreadSafe> TraceRecorder;
 }; 
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UClass;
+
+/**
+ * Lookup table from class names to classes
+ * Commands name classes loosely: "StaticMesh" for UStaticMeshComponent, "UGameplayStatics"
+ * for the GameplayStatics class, "BP_Door" for BP_Door_C. The index maps each loaded
+ * class's name and these aliases to the class once, so a lookup is a single map probe
+ * instead of several searches of the global object table. It is rebuilt lazily after
+ * modules are loaded or code is hot-reloaded, and classes loaded later (e.g. Blueprint
+ * classes) are picked up the first time a lookup for them misses.
+ * Must only be used on the game thread.
+ */
+class UNREALMCP_API FUnrealMCPClassIndex
+{
+public:
+    FUnrealMCPClassIndex();
+    ~FUnrealMCPClassIndex();
+
+    /** Build the index and subscribe to the events that invalidate it */
+    void Initialize();
+
+    /** Unsubscribe from engine events and drop all entries */
+    void Shutdown();
+
+    /**
+     * Find a class by name, alias or object path
+     * @param BaseClass Only accept classes derived from this one; it also decides between classes that share an alias
+     * @return The class, or nullptr if none matches
+     */
+    UClass* FindClass(const FString& Name, const UClass* BaseClass = nullptr);
+
+    /** Up to MaxSuggestions indexed names close to Name, for "did you mean" messages; only meant for misses */
+    TArray<FString> GetSuggestions(const FString& Name, const UClass* BaseClass = nullptr, int32 MaxSuggestions = 5);
+
+    /** Number of names and aliases indexed */
+    int32 Num() const { return ClassesByName.Num(); }
+
+private:
+    /** How a name refers to a class; lower values win when several classes share a name */
+    enum class EMatch : uint8
+    {
+        Name,
+        PrefixedName,
+        Alias,
+    };
+
+    struct FEntry
+    {
+        TWeakObjectPtr<UClass> Class;
+        EMatch Match;
+    };
+
+    void EnsureUpToDate();
+    void Rebuild();
+    void AddClass(UClass* Class);
+    void AddName(const FString& Name, UClass* Class, EMatch Match);
+    UClass* FindIndexed(const FString& Name, const UClass* BaseClass) const;
+
+    /** Accepts classes that can be referenced by name: not skeleton, reinstanced or deprecated classes */
+    static bool IsIndexable(const UClass* Class);
+
+    TMap<FString, TArray<FEntry>> ClassesByName;
+    bool bDirty;
+
+    FDelegateHandle ModulesChangedHandle;
+    FDelegateHandle ReloadCompleteHandle;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+
+/**
+ * Deferred Blueprint compilation
+ * Commands that edit a Blueprint mark it for compilation instead of compiling it after
+ * every edit. Pending Blueprints are compiled once, when compile_blueprint asks for one,
+ * at the end of a batch, before a command needs the generated class, or when no edit
+ * has arrived for UUnrealMCPSettings::CompileDebounceSeconds. Blueprints whose edits
+ * should be saved are saved right after that compile, so a save never writes a stale
+ * Blueprint and a run of edits costs one save instead of one per edit.
+ * Must only be used on the game thread.
+ */
+class UNREALMCP_API FUnrealMCPCompileScheduler
+{
+public:
+    FUnrealMCPCompileScheduler();
+    ~FUnrealMCPCompileScheduler();
+
+    /** Start the idle-compile ticker */
+    void Initialize();
+
+    /** Stop the ticker and forget pending compiles and saves */
+    void Shutdown();
+
+    /**
+     * Record an edit to Blueprint; it is compiled later
+     * @param bSaveAfterCompile Save the Blueprint's package once the compile that picks up this edit has run
+     */
+    void MarkDirty(UBlueprint* Blueprint, bool bSaveAfterCompile = false);
+
+    /** True if Blueprint has edits that have not been compiled yet */
+    bool IsPending(const UBlueprint* Blueprint) const;
+
+    /**
+     * Compile Blueprint now, whether it is pending or not
+     * @return Number of compiles saved by coalescing its pending edits into this one
+     */
+    int32 Compile(UBlueprint* Blueprint);
+
+    /** Compile Blueprint if it has pending edits, e.g. before its generated class is used */
+    void Flush(UBlueprint* Blueprint);
+
+    /**
+     * Compile every pending Blueprint
+     * @param OutCompilesAvoided Receives the number of compiles saved by coalescing
+     * @return Number of Blueprints compiled
+     */
+    int32 FlushAll(int32* OutCompilesAvoided = nullptr);
+
+    /** Number of Blueprints waiting to be compiled */
+    int32 NumPending() const { return PendingEdits.Num(); }
+
+    /** Compiles saved since startup: edits that did not trigger a compile of their own */
+    int64 GetTotalCompilesAvoided() const { return TotalCompilesAvoided; }
+
+    /** Compiles run since startup */
+    int64 GetTotalCompiles() const { return TotalCompiles; }
+
+private:
+    bool Tick(float DeltaTime);
+    void CompileNow(UBlueprint* Blueprint);
+
+    /** Edits recorded for each pending Blueprint since it was last compiled */
+    TMap<TWeakObjectPtr<UBlueprint>, int32> PendingEdits;
+
+    /** Blueprints to save after their next compile */
+    TSet<TWeakObjectPtr<UBlueprint>> PendingSaves;
+
+    /** Time of the most recent MarkDirty, for the idle debounce */
+    double LastEditTime;
+
+    int64 TotalCompiles;
+    int64 TotalCompilesAvoided;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+UNREALMCP_API DECLARE_LOG_CATEGORY_EXTERN(LogUnrealMCP, Log, All);
+
+/**
+ * Logging of request and response payloads
+ * Off by default: logging every message in full costs more than handling most commands.
+ * When enabled, payloads are logged at Log verbosity, cut to MaxLength bytes, and only
+ * one in SampleInterval messages is logged. The options start from the plugin settings
+ * and can be changed at runtime with the set_log_options command.
+ * Safe to use from any thread.
+ */
+namespace UnrealMCPLog
+{
+    struct FPayloadLogOptions
+    {
+        bool bEnabled = false;
+
+        /** Bytes of each payload that are logged; 0 logs whole payloads */
+        int32 MaxLength = 1024;
+
+        /** Log one in this many payloads */
+        int32 SampleInterval = 1;
+    };
+
+    /** Requests and responses are sampled separately, so with a synchronous client both halves of an exchange are logged */
+    enum class EPayloadDirection : uint8
+    {
+        Received,
+        Sent,
+    };
+
+    UNREALMCP_API void SetPayloadLogOptions(const FPayloadLogOptions& Options);
+    UNREALMCP_API FPayloadLogOptions GetPayloadLogOptions();
+
+    /** Logs a UTF-8 JSON payload if payload logging is on and this message is sampled */
+    UNREALMCP_API void LogPayload(EPayloadDirection Direction, const uint8* Payload, int32 Size);
+    UNREALMCP_API void LogPayload(EPayloadDirection Direction, const FString& Payload);
+}
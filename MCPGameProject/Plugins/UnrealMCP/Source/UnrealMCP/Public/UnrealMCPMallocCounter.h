@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include <atomic>
+
+/**
+ * Counts the allocations made by the thread that installed it as GMalloc
+ * Every call is forwarded to the allocator it wraps. benchmark_serialization and the
+ * command automation tests install it for the duration of one measurement; measurements
+ * must not overlap.
+ */
+class FUnrealMCPMallocCounter final : public FMalloc
+{
+public:
+    /** The shared counter, wrapping the allocator that was GMalloc when it was first used */
+    static FUnrealMCPMallocCounter& Get()
+    {
+        // Never destroyed: another thread may still be inside it right after it is uninstalled
+        static FUnrealMCPMallocCounter* Counter = new FUnrealMCPMallocCounter(GMalloc);
+        return *Counter;
+    }
+
+    explicit FUnrealMCPMallocCounter(FMalloc* InInner)
+        : Inner(InInner)
+        , CountingThreadId(0)
+        , Allocations(0)
+    {
+    }
+
+    /** Install as GMalloc and count the current thread's allocations until End() */
+    void Begin()
+    {
+        CountingThreadId = FPlatformTLS::GetCurrentThreadId();
+        Allocations = 0;
+        GMalloc = this;
+    }
+
+    /** Restore the wrapped allocator and return the number of allocations counted */
+    int64 End()
+    {
+        GMalloc = Inner;
+        CountingThreadId = 0;
+        return Allocations;
+    }
+
+    virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+    {
+        Record();
+        return Inner->Malloc(Count, Alignment);
+    }
+
+    virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+    {
+        Record();
+        return Inner->TryMalloc(Count, Alignment);
+    }
+
+    virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        if (Count > 0)
+        {
+            Record();
+        }
+        return Inner->Realloc(Original, Count, Alignment);
+    }
+
+    virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+    {
+        if (Count > 0)
+        {
+            Record();
+        }
+        return Inner->TryRealloc(Original, Count, Alignment);
+    }
+
+    virtual void Free(void* Original) override { Inner->Free(Original); }
+    virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+    virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+    virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+    virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+    virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+    virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+    virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+    virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+private:
+    void Record()
+    {
+        if (FPlatformTLS::GetCurrentThreadId() == CountingThreadId)
+        {
+            ++Allocations;
+        }
+    }
+
+    FMalloc* Inner;
+    std::atomic<uint32> CountingThreadId;
+    int64 Allocations;
+};
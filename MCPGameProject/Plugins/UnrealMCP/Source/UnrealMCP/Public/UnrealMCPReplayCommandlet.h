@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealMCPReplayCommandlet.generated.h"
+
+/**
+ * Replays a trace recorded by the MCP server through UUnrealMCPBridge::ExecuteCommand
+ * Each request runs on the game thread as it did in the editor, so two builds can be
+ * compared on the same workload. By default requests start at the times they were
+ * recorded; -MaxSpeed runs them back to back.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd MCPGameProject.uproject -run=UnrealMCPReplay -Trace=<file> [-MaxSpeed] [-Map=<map>] [-Output=<file.json>]
+ */
+UCLASS()
+class UUnrealMCPReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPProtocol.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Streaming writer for command results
+ * Bulk commands write their result field by field straight into the response payload,
+ * in the encoding the client asked for, instead of building an FJsonObject tree that is
+ * serialized afterwards. Keys name the fields of the enclosing object and are left out
+ * for array elements.
+ *
+ * A writer either appends an encoded payload to a caller-provided buffer, so the buffer
+ * can be reused between responses, or builds an FJsonObject for callers that need one
+ * (e.g. batch entries). Handlers are written once against this interface.
+ */
+class UNREALMCP_API FUnrealMCPResponseWriter
+{
+public:
+    /** Append the encoded payload to OutBuffer */
+    FUnrealMCPResponseWriter(TArray<uint8>& OutBuffer, MCPProtocol::EMCPPayloadEncoding InEncoding);
+
+    /** Build an object tree instead; the root value must be an object, returned by GetObject() */
+    FUnrealMCPResponseWriter();
+
+    ~FUnrealMCPResponseWriter();
+
+    FUnrealMCPResponseWriter(const FUnrealMCPResponseWriter&) = delete;
+    FUnrealMCPResponseWriter& operator=(const FUnrealMCPResponseWriter&) = delete;
+
+    // Containers
+    void WriteObjectStart();
+    void WriteObjectStart(const TCHAR* Key);
+    void WriteObjectEnd();
+    void WriteArrayStart();
+    void WriteArrayStart(const TCHAR* Key);
+    void WriteArrayEnd();
+
+    // Object fields
+    void WriteValue(const TCHAR* Key, const FString& Value);
+    void WriteValue(const TCHAR* Key, const TCHAR* Value);
+    void WriteValue(const TCHAR* Key, double Value);
+    void WriteValue(const TCHAR* Key, int64 Value);
+    void WriteValue(const TCHAR* Key, int32 Value) { WriteValue(Key, static_cast<int64>(Value)); }
+    void WriteValue(const TCHAR* Key, bool Value);
+    void WriteNull(const TCHAR* Key);
+
+    // Array elements
+    void WriteValue(const FString& Value);
+    void WriteValue(const TCHAR* Value);
+    void WriteValue(double Value);
+    void WriteValue(int64 Value);
+    void WriteValue(int32 Value) { WriteValue(static_cast<int64>(Value)); }
+    void WriteValue(bool Value);
+
+    /** [X, Y, Z] */
+    void WriteVector(const TCHAR* Key, const FVector& Value);
+
+    /** [Pitch, Yaw, Roll] */
+    void WriteRotator(const TCHAR* Key, const FRotator& Value);
+
+    /** Copies a value from an existing tree, e.g. a request id; a null Key writes an array element */
+    void WriteJsonValue(const TCHAR* Key, const TSharedPtr<FJsonValue>& Value);
+
+    /** Copies every field of Object into the object being written */
+    void WriteJsonFields(const FJsonObject& Object);
+
+    /** Finishes the payload; every container must have been ended */
+    void Close();
+
+    /** The root object of a tree-building writer, valid after Close() */
+    TSharedPtr<FJsonObject> GetObject() const { return RootObject; }
+
+private:
+    enum class ETarget : uint8
+    {
+        Json,
+        Cbor,
+        Object,
+    };
+
+    // CBOR output: indefinite-length maps and arrays, since handlers do not know their sizes up front
+    void WriteCborHeader(uint8 MajorType, uint64 Argument);
+    void WriteCborString(const TCHAR* Value, int32 Length);
+    void WriteCborKey(const TCHAR* Key);
+    void WriteCborNumber(double Value);
+    void WriteCborByte(uint8 Value) { Buffer->Add(Value); }
+
+    // Tree output
+    struct FTreeContainer
+    {
+        TSharedPtr<FJsonObject> Object;
+        TArray<TSharedPtr<FJsonValue>> Array;
+        FString Key;
+    };
+    void AddTreeValue(const TCHAR* Key, const TSharedPtr<FJsonValue>& Value);
+    void StartTreeContainer(const TCHAR* Key, bool bIsObject);
+    void EndTreeContainer();
+
+    ETarget Target;
+    TArray<uint8>* Buffer;
+    TSharedPtr<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> JsonWriter;
+    TUniquePtr<FArchive> JsonArchive;
+    TArray<FTreeContainer, TInlineAllocator<8>> TreeStack;
+    TSharedPtr<FJsonObject> RootObject;
+};
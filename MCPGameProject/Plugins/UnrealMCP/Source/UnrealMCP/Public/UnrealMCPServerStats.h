@@ -0,0 +1,148 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FJsonObject;
+
+/**
+ * Times (FPlatformTime::Cycles64) at which a request passed each point of the server
+ * A time left at 0 was not reached, e.g. for commands run from editor scripting, which
+ * are never received from a socket.
+ */
+struct FUnrealMCPCommandTiming
+{
+    /** The read that delivered the first byte of the request */
+    uint64 FirstByte = 0;
+
+    /** The read that completed the request */
+    uint64 Received = 0;
+
+    /** Parsed and handed to the bridge, which queues it for its lane */
+    uint64 Enqueued = 0;
+
+    /** The handler started, on the command's lane */
+    uint64 Started = 0;
+
+    /** The handler returned and the response was built or streamed */
+    uint64 Handled = 0;
+
+    /** The response was encoded into the send buffer */
+    uint64 Serialized = 0;
+
+    /** The last byte of the response was written to the socket */
+    uint64 Sent = 0;
+};
+
+/** The stretches between the times of FUnrealMCPCommandTiming, each with its own histogram */
+enum class EUnrealMCPCommandPhase : uint8
+{
+    /** FirstByte to Received: waiting for the rest of the request */
+    Receive,
+    /** Received to Enqueued */
+    Parse,
+    /** Enqueued to Started: waiting for the game thread */
+    Queue,
+    /** Started to Handled */
+    Handler,
+    /** Handled to Serialized: back to the session and encoded */
+    Serialize,
+    /** Serialized to Sent */
+    Send,
+    /** FirstByte to Sent */
+    Total,
+
+    Count
+};
+
+UNREALMCP_API const TCHAR* LexToString(EUnrealMCPCommandPhase Phase);
+
+/**
+ * Latency histogram with log-linear buckets, in the style of HdrHistogram
+ * Values are microseconds. Each power of two is split into 8 buckets, so a reported
+ * percentile is within 12.5% of the recorded value, from 1 us up to about 70 minutes;
+ * larger values are counted in the last bucket. Recording is a few relaxed atomic
+ * increments, so any number of threads can record without a lock. Reads are not a
+ * consistent snapshot while other threads record, which is fine for statistics.
+ */
+class UNREALMCP_API FUnrealMCPLatencyHistogram
+{
+public:
+    FUnrealMCPLatencyHistogram();
+
+    void Record(uint64 Microseconds);
+
+    /** Number of values recorded */
+    uint64 GetCount() const { return Count.load(std::memory_order_relaxed); }
+
+    /** Largest value recorded, exactly */
+    uint64 GetMax() const { return Max.load(std::memory_order_relaxed); }
+
+    double GetMean() const;
+
+    /** The value below which Percentile (0-100) percent of the values lie, rounded up to its bucket's upper bound */
+    uint64 GetPercentile(double Percentile) const;
+
+    void Reset();
+
+private:
+    static constexpr int32 SubBucketBits = 3;
+    static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+    static constexpr int32 MaxValueBits = 32;
+    static constexpr int32 NumBuckets = (MaxValueBits - SubBucketBits + 1) * SubBucketCount;
+
+    static int32 GetBucketIndex(uint64 Value);
+    static uint64 GetBucketUpperBound(int32 Index);
+
+    std::atomic<uint64> Buckets[NumBuckets];
+    std::atomic<uint64> Count;
+    std::atomic<uint64> Sum;
+    std::atomic<uint64> Max;
+};
+
+/**
+ * Per-command latency statistics of the server
+ * Sessions record the timing of every request they answer; get_server_stats reports
+ * the percentiles of each phase per command. The table of commands is built once from
+ * the registry, so recording never takes a lock. Requests for unknown commands are
+ * counted under "<unknown>".
+ */
+class UNREALMCP_API FUnrealMCPServerStats
+{
+public:
+    explicit FUnrealMCPServerStats(const TArray<FName>& CommandNames);
+
+    /** Record one answered request; phases whose start or end time is missing are skipped */
+    void Record(FName Command, const FUnrealMCPCommandTiming& Timing, bool bSucceeded);
+
+    /**
+     * {since_reset_s, commands: {name: {count, errors, phases: {phase: {count, mean_ms, p50_ms, p90_ms, p99_ms, max_ms}}}}}
+     * Only commands that were called are listed. A non-empty CommandFilter lists that command only.
+     */
+    TSharedPtr<FJsonObject> ToJson(const FString& CommandFilter = FString()) const;
+
+    /** One row per command and phase, in the units of ToJson */
+    FString ToCsv() const;
+
+    /** Forget everything recorded so far */
+    void Reset();
+
+private:
+    struct FCommandStats
+    {
+        std::atomic<uint64> Count { 0 };
+        std::atomic<uint64> Errors { 0 };
+        FUnrealMCPLatencyHistogram Phases[(int32)EUnrealMCPCommandPhase::Count];
+    };
+
+    FCommandStats& FindStats(FName Command);
+
+    /** Commands sorted by name, for stable output */
+    TArray<TPair<FName, const FCommandStats*>> GetCalledCommands() const;
+
+    /** Only written by the constructor */
+    TMap<FName, TUniquePtr<FCommandStats>> Commands;
+    FCommandStats UnknownCommands;
+
+    std::atomic<uint64> ResetCycles;
+};
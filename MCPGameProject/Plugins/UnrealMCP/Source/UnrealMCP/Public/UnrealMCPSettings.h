@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "UnrealMCPSettings.generated.h"
+
+/**
+ * Project settings for the MCP server
+ * Stored in DefaultEditor.ini under [/Script/UnrealMCP.UnrealMCPSettings]
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Unreal MCP"))
+class UNREALMCP_API UUnrealMCPSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPSettings();
+
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+	/** Maximum number of clients served at the same time. Further connections are closed until a session ends. */
+	UPROPERTY(config, EditAnywhere, Category = "Server", meta = (ClampMin = "1", ClampMax = "256"))
+	int32 MaxConcurrentSessions;
+
+	/**
+	 * Seconds without a Blueprint edit after which edited Blueprints are compiled.
+	 * compile_blueprint and the end of a batch compile earlier.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Blueprints", meta = (ClampMin = "0.0", ClampMax = "60.0", Units = "s"))
+	float CompileDebounceSeconds;
+
+	/**
+	 * Undo memory the transactions recorded by begin_transaction and batch may take.
+	 * Beyond it, the oldest of them are dropped from the undo history; other editor transactions are kept.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Undo", meta = (ClampMin = "1", ClampMax = "4096", Units = "Megabytes"))
+	int32 MaxUndoMemoryMB;
+
+	/** Seconds without a command after which a group opened by begin_transaction is ended. 0 never ends it. */
+	UPROPERTY(config, EditAnywhere, Category = "Undo", meta = (ClampMin = "0.0", Units = "s"))
+	float TransactionIdleTimeoutSeconds;
+
+	/**
+	 * Write request and response payloads to the LogUnrealMCP log.
+	 * Logging every payload in full adds noticeable latency to each command; leave off outside of debugging.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Logging")
+	bool bLogPayloads;
+
+	/** Bytes of each payload that are logged; longer payloads are cut off. 0 logs whole payloads. */
+	UPROPERTY(config, EditAnywhere, Category = "Logging", meta = (ClampMin = "0", Units = "Bytes", EditCondition = "bLogPayloads"))
+	int32 MaxLoggedPayloadLength;
+
+	/** Log only one in this many payloads. */
+	UPROPERTY(config, EditAnywhere, Category = "Logging", meta = (ClampMin = "1", EditCondition = "bLogPayloads"))
+	int32 PayloadLogSampleInterval;
+
+	/**
+	 * Write the per-command latency statistics reported by get_server_stats to
+	 * Saved/UnrealMCP/ServerStats-<date>.csv when the editor shuts down.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Diagnostics")
+	bool bWriteServerStatsOnShutdown;
+
+	/**
+	 * Record every request, with its response size and latency, to Saved/UnrealMCP/Traces/Trace-<date>.mcptrace
+	 * from the time the editor starts. Traces can be replayed with the UnrealMCPReplay commandlet.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Diagnostics")
+	bool bRecordTrace;
+
+	/** Apply the logging options; called when the server starts and when they are edited */
+	void ApplyLogOptions() const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
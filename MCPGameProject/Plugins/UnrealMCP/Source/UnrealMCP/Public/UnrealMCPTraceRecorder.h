@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UnrealMCPServerStats.h"
+#include <atomic>
+
+class FArchive;
+
+/** One request of a command trace */
+struct FUnrealMCPTraceRecord
+{
+    /** Microseconds from the start of the recording to the first byte of the request */
+    uint64 TimestampUs = 0;
+
+    /** Session the request arrived on */
+    int32 ConnectionId = 0;
+
+    /** The request's command type */
+    FString Command;
+
+    /** The request's parameters, as compact JSON */
+    FString Params;
+
+    /** Bytes of the response payload, without framing */
+    uint32 ResponseSize = 0;
+
+    /** First byte of the request received to last byte of the response sent */
+    uint32 LatencyUs = 0;
+
+    bool bSucceeded = false;
+};
+
+/**
+ * Binary trace of the requests the server answers
+ * Sessions record every request they answer while recording is on, so a slow agent session
+ * can be captured and replayed later with the UnrealMCPReplay commandlet.
+ *
+ * The file is little-endian: the bytes "UMCT", a uint32 format version and the start of the
+ * recording as int64 Unix milliseconds, then one record per answered request:
+ * uint64 TimestampUs, int32 ConnectionId, string Command, string Params, uint32 ResponseSize,
+ * uint32 LatencyUs and uint8 Flags (bit 0: succeeded). Strings are a uint32 byte count
+ * followed by UTF-8 text.
+ *
+ * Safe to use from any thread; records are written under a lock, in the order responses are sent.
+ */
+class UNREALMCP_API FUnrealMCPTraceRecorder
+{
+public:
+    static constexpr uint32 FormatVersion = 1;
+
+    FUnrealMCPTraceRecorder();
+    ~FUnrealMCPTraceRecorder();
+
+    /** Starts writing a new trace to FilePath; fails if a recording is already in progress */
+    bool Start(const FString& FilePath, FString& OutError);
+
+    /** Closes the trace and returns the number of records written; does nothing if not recording */
+    int64 Stop();
+
+    /** Cheap check for sessions deciding whether to capture a request */
+    bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+
+    /** File of the current or last recording */
+    FString GetFilePath() const;
+
+    /** Records written by the current or last recording */
+    int64 GetNumRecords() const;
+
+    /**
+     * Writes one answered request; the timestamp and latency are taken from Timing
+     * Requests answered after the recording stopped are dropped.
+     */
+    void Record(FUnrealMCPTraceRecord& TraceRecord, const FUnrealMCPCommandTiming& Timing);
+
+    /** Reads every record of a trace file */
+    static bool Load(const FString& FilePath, TArray<FUnrealMCPTraceRecord>& OutRecords, FString& OutError);
+
+    /** Saved/UnrealMCP/Traces/Trace-<date>.mcptrace */
+    static FString GetDefaultFilePath();
+
+private:
+    static void SerializeRecord(FArchive& Ar, FUnrealMCPTraceRecord& TraceRecord);
+
+    mutable FCriticalSection Lock;
+
+    /** Open trace file; guarded by Lock */
+    TUniquePtr<FArchive> File;
+    FString FilePath;
+    uint64 StartCycles;
+    int64 NumRecords;
+
+    std::atomic<bool> bRecording;
+};
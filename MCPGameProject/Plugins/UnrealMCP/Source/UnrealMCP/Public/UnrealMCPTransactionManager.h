@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FJsonObject;
+
+/**
+ * Undo grouping for the edits commands make
+ * Handlers call Modify() on what they change, so their edits are recorded in whichever
+ * transaction is open. A batch records its edits as one transaction. begin_transaction and
+ * end_transaction open and close a group spanning any number of requests: the editor is never
+ * left inside a transaction between requests, so each command run while the group is open is
+ * recorded as a transaction of its own, tagged with the group's context. Ctrl+Z in the editor
+ * steps back through them one command at a time, and edits made by hand in between get records
+ * of their own rather than being folded into the group. Ending the group with undo reverts all of
+ * its records, and refuses if anything else was recorded after them. Edits made outside a group
+ * or batch are not recorded and cost no undo memory.
+ *
+ * Every record is made under a context starting with "UnrealMCP". Once those records take more
+ * than UUnrealMCPSettings::MaxUndoMemoryMB of the editor's undo history, the oldest are dropped,
+ * except for the open group's. A group that sees no command for
+ * UUnrealMCPSettings::TransactionIdleTimeoutSeconds is ended, so a client that goes away doesn't
+ * leave later commands tagged with its group. Must only be used on the game thread.
+ */
+class UNREALMCP_API FUnrealMCPTransactionManager
+{
+public:
+    /** Context of every transaction the plugin records */
+    static const TCHAR* const TransactionContext;
+
+    FUnrealMCPTransactionManager();
+    ~FUnrealMCPTransactionManager();
+
+    void Initialize();
+
+    /** End the open group, if any, and stop the idle ticker */
+    void Shutdown();
+
+    /** Open a group; fails if one is already open */
+    bool Begin(const FString& Description, FString& OutError);
+
+    /**
+     * Close the open group
+     * @param bUndo - Revert the group's edits right away, e.g. when an agent abandons a step
+     * @param OutCommands - Receives the number of commands run while the group was open
+     */
+    bool End(bool bUndo, int32& OutCommands, FString& OutError);
+
+    bool IsOpen() const { return !OpenContext.IsEmpty(); }
+
+    /** Note that a command ran, which keeps an open group from timing out */
+    void NoteCommand();
+
+    /**
+     * Start recording a command's edits in a transaction of the open group
+     * @return Whether a transaction was started, to be closed with EndCommand once the command has run
+     */
+    bool BeginCommand(const FString& CommandType);
+    void EndCommand();
+
+    /**
+     * Drop the oldest MCP records from the undo history while they take more than the budget
+     * @return Number of records dropped
+     */
+    int32 EnforceMemoryBudget();
+
+    /** {open, description, commands, group_records, undo_records, undo_bytes, max_undo_bytes, records_dropped} */
+    TSharedPtr<FJsonObject> GetStats() const;
+
+private:
+    bool Tick(float DeltaTime);
+
+    /**
+     * Count the open group's records that can still be undone
+     * @return False if another record was made after the group's oldest one
+     */
+    bool CountUndoableGroupRecords(int32& OutRecords) const;
+
+    /** Transaction context of the open group's records, unique per group; empty when no group is open */
+    FString OpenContext;
+    FString OpenDescription;
+    int32 OpenCommands;
+    double LastCommandTime;
+    bool bCommandOpen;
+
+    int64 TotalRecordsDropped;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+"""
+Benchmark the `batch` command against individual commands.
+
+Spawns the same number of actors twice: once with one `spawn_actor` command
+per actor, then with a single `batch` command containing every spawn. The
+actors are deleted again (in one batch) after each run.
+
+Usage:
+    python scripts/benchmarks/benchmark_batch.py --count 1000
+"""
+
+import sys
+import os
+import time
+import logging
+import argparse
+from typing import List, Dict, Any
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_mcp_server import UnrealConnection
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("BenchmarkBatch")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+def spawn_commands(prefix: str, count: int) -> List[Dict[str, Any]]:
+    """Build spawn_actor commands for a grid of point lights."""
+    return [{
+        "type": "spawn_actor",
+        "params": {
+            "name": f"{prefix}_{index}",
+            "type": "PointLight",
+            "location": [float(index % 32) * 100.0, float(index // 32) * 100.0, 200.0],
+            "rotation": [0.0, 0.0, 0.0]
+        }
+    } for index in range(count)]
+
+def delete_actors(connection: UnrealConnection, commands: List[Dict[str, Any]]) -> None:
+    connection.send_command("batch", {
+        "commands": [{"type": "delete_actor", "params": {"name": c["params"]["name"]}} for c in commands]
+    })
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare individual spawn_actor commands with one batch")
+    parser.add_argument("--count", type=int, default=1000, help="Number of actors to spawn per run")
+    args = parser.parse_args()
+
+    connection = UnrealConnection()
+    if not connection.connect():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+
+    try:
+        individual = spawn_commands("MCPBenchIndividual", args.count)
+        start = time.perf_counter()
+        failures = 0
+        for command in individual:
+            response = connection.send_command(command["type"], command["params"])
+            if not response or response.get("status") == "error":
+                failures += 1
+        individual_time = time.perf_counter() - start
+        logger.info(f"individual: {args.count} spawns in {individual_time * 1000:.1f} ms "
+                    f"({failures} failed)")
+        delete_actors(connection, individual)
+
+        batched = spawn_commands("MCPBenchBatch", args.count)
+        start = time.perf_counter()
+        response = connection.send_command("batch", {"commands": batched, "transaction": True})
+        batch_time = time.perf_counter() - start
+        failed = (response or {}).get("result", {}).get("failed", "?")
+        logger.info(f"     batch: {args.count} spawns in {batch_time * 1000:.1f} ms ({failed} failed)")
+        delete_actors(connection, batched)
+
+        logger.info(f"Speedup: {individual_time / max(batch_time, 1e-9):.1f}x")
+    finally:
+        connection.disconnect()
+
+if __name__ == "__main__":
+    main()
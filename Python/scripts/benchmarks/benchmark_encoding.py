@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+"""
+Benchmark JSON versus CBOR response encoding.
+
+Sends the same command repeatedly over a framed connection, once asking for
+JSON responses and once for CBOR, and compares payload size, client-side
+decode time and round-trip time. Use a command with a bulk result, e.g.
+get_actors_in_level in a populated level.
+
+CBOR is decoded with cbor2 when it is installed (uv pip install -e ".[cbor]")
+and with the pure-Python fallback in unreal_protocol.py otherwise.
+
+Usage:
+    python scripts/benchmarks/benchmark_encoding.py --requests 50 --command get_actors_in_level
+"""
+
+import sys
+import os
+import json
+import time
+import logging
+import argparse
+import statistics
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_mcp_server import UnrealConnection
+from unreal_protocol import ENCODING_NAMES, cbor2, decode_payload, encode_frame
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("BenchmarkEncoding")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+def run(encoding: str, command: str, params: dict, requests: int) -> dict:
+    connection = UnrealConnection(encoding=encoding)
+    if not connection.connect():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+
+    request = {"type": command, "params": params, "encoding": encoding}
+    frame = encode_frame(json.dumps(request).encode('utf-8'))
+
+    round_trips, decodes, sizes = [], [], []
+    received_encoding = None
+    try:
+        for _ in range(requests):
+            start = time.perf_counter()
+            connection.socket.sendall(frame)
+            received_encoding, payload = connection.receive_full_response(connection.socket)
+            received = time.perf_counter()
+            response = decode_payload(received_encoding, payload)
+            decoded = time.perf_counter()
+
+            if response.get("status") == "error":
+                logger.warning(f"{encoding}: {command} failed: {response.get('error')}")
+            round_trips.append((decoded - start) * 1000)
+            decodes.append((decoded - received) * 1000)
+            sizes.append(len(payload))
+    finally:
+        connection.disconnect()
+
+    if ENCODING_NAMES[encoding] != received_encoding:
+        logger.warning(f"Asked for {encoding} but the server answered with encoding {received_encoding}")
+
+    return {
+        "bytes": statistics.mean(sizes),
+        "decode_ms": statistics.median(decodes),
+        "round_trip_ms": statistics.median(round_trips),
+    }
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare JSON and CBOR response encoding")
+    parser.add_argument("--requests", type=int, default=50, help="Number of requests per encoding")
+    parser.add_argument("--command", default="get_actors_in_level", help="Command to send")
+    parser.add_argument("--params", default="{}", help="Command parameters as a JSON object")
+    args = parser.parse_args()
+
+    params = json.loads(args.params)
+    logger.info(f"CBOR decoder: {'cbor2' if cbor2 else 'pure Python fallback'}")
+
+    results = {encoding: run(encoding, args.command, params, args.requests) for encoding in ("json", "cbor")}
+    for encoding, result in results.items():
+        logger.info(f"{encoding:>4}: {result['bytes']:.0f} bytes, decode {result['decode_ms']:.3f} ms, "
+                    f"round trip {result['round_trip_ms']:.3f} ms (median of {args.requests})")
+
+    json_result, cbor_result = results["json"], results["cbor"]
+    logger.info(f"CBOR payload is {cbor_result['bytes'] / max(json_result['bytes'], 1):.0%} of JSON, "
+                f"decode speedup {json_result['decode_ms'] / max(cbor_result['decode_ms'], 1e-9):.1f}x")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+"""
+Benchmark the latency cost of payload logging.
+
+Sends the same command repeatedly with payload logging off, on with bodies
+cut to --max-length bytes, and on with whole bodies. The plugin's logging is
+switched with the set_log_options command and this client's with the
+UNREAL_MCP_LOG_* settings of unreal_logging.py, one side at a time, so each
+row shows the cost of one side's logging. The plugin's options are restored
+afterwards.
+
+Use a command with a sizeable result, e.g. get_actors_in_level in a
+populated level; the client side writes to unreal_mcp.log.
+
+Usage:
+    python scripts/benchmarks/benchmark_logging.py --requests 200 --command get_actors_in_level
+"""
+
+import sys
+import os
+import json
+import time
+import logging
+import argparse
+import statistics
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+import unreal_logging
+from unreal_mcp_server import UnrealConnection
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("BenchmarkLogging")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+def set_client_logging(enabled: bool, max_length: int) -> None:
+    unreal_logging.LOG_PAYLOADS = enabled
+    unreal_logging.LOG_PAYLOAD_MAX = max_length
+    unreal_logging.LOG_SAMPLE = 1
+
+def set_plugin_logging(connection: UnrealConnection, options: dict) -> dict:
+    response = connection.send_command("set_log_options", options)
+    if not response or response.get("status") == "error":
+        logger.error(f"set_log_options failed: {response}")
+        sys.exit(1)
+    return response["result"]
+
+def run(connection: UnrealConnection, command: str, params: dict, requests: int) -> float:
+    """Median round trip in milliseconds, after a few warm-up requests."""
+    for _ in range(min(5, requests)):
+        connection.send_command(command, params)
+    timings = []
+    for _ in range(requests):
+        start = time.perf_counter()
+        response = connection.send_command(command, params)
+        timings.append((time.perf_counter() - start) * 1000)
+        if response.get("status") == "error":
+            logger.warning(f"{command} failed: {response.get('error')}")
+    return statistics.median(timings)
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure the latency cost of payload logging")
+    parser.add_argument("--requests", type=int, default=200, help="Number of requests per mode")
+    parser.add_argument("--command", default="get_actors_in_level", help="Command to send")
+    parser.add_argument("--params", default="{}", help="Command parameters as a JSON object")
+    parser.add_argument("--max-length", type=int, default=1024, help="Bytes of each payload logged when truncating")
+    args = parser.parse_args()
+
+    params = json.loads(args.params)
+    connection = UnrealConnection()
+    if not connection.connect():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+
+    modes = [
+        ("off", False, 0),
+        (f"truncated to {args.max_length}", True, args.max_length),
+        ("whole payloads", True, 0),
+    ]
+
+    set_client_logging(False, 0)
+    original = set_plugin_logging(connection, {})
+    results = []
+    try:
+        for name, enabled, max_length in modes:
+            set_plugin_logging(connection, {"log_payloads": enabled, "max_payload_length": max_length, "sample_interval": 1})
+            results.append(("plugin", name, run(connection, args.command, params, args.requests)))
+        set_plugin_logging(connection, {"log_payloads": False})
+
+        for name, enabled, max_length in modes:
+            set_client_logging(enabled, max_length)
+            results.append(("client", name, run(connection, args.command, params, args.requests)))
+        set_client_logging(False, 0)
+    finally:
+        set_plugin_logging(connection, original)
+        connection.disconnect()
+
+    baselines = {side: ms for side, name, ms in results if name == "off"}
+    for side, name, ms in results:
+        logger.info(f"{side:>6} logging {name:<20} {ms:8.3f} ms median round trip "
+                    f"({ms - baselines[side]:+.3f} ms, {args.requests} requests)")
+
+if __name__ == "__main__":
+    main()
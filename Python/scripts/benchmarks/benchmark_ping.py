@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+"""
+Benchmark the round-trip latency of the `ping` command.
+
+Compares the legacy client behaviour (a new TCP connection per command, one
+unterminated JSON object per request) with the keep-alive UnrealConnection,
+which reuses one socket with newline-delimited or length-prefixed messages.
+
+Usage:
+    python scripts/benchmarks/benchmark_ping.py --iterations 500
+"""
+
+import sys
+import os
+import time
+import socket
+import json
+import logging
+import argparse
+import statistics
+from typing import List
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_mcp_server import UnrealConnection, UNREAL_HOST, UNREAL_PORT
+from unreal_protocol import PROTOCOL_FRAMED, PROTOCOL_NEWLINE
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("BenchmarkPing")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+def legacy_ping() -> None:
+    """Send one ping the way the original client did: connect, send, parse until complete, close."""
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    sock.settimeout(5)
+    try:
+        sock.connect((UNREAL_HOST, UNREAL_PORT))
+        sock.sendall(json.dumps({"type": "ping", "params": {}}).encode('utf-8'))
+
+        chunks = []
+        while True:
+            chunk = sock.recv(4096)
+            if not chunk:
+                raise ConnectionError("Connection closed before receiving data")
+            chunks.append(chunk)
+            try:
+                json.loads(b''.join(chunks).decode('utf-8'))
+                return
+            except json.JSONDecodeError:
+                continue
+    finally:
+        sock.close()
+
+def measure(label: str, iterations: int, func) -> List[float]:
+    """Run func repeatedly and return per-call latencies in milliseconds."""
+    # Warm up so connection setup and first-call costs are not measured
+    for _ in range(min(10, iterations)):
+        func()
+
+    latencies = []
+    for _ in range(iterations):
+        start = time.perf_counter()
+        func()
+        latencies.append((time.perf_counter() - start) * 1000.0)
+
+    latencies.sort()
+    p50 = latencies[len(latencies) // 2]
+    p99 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.99))]
+    logger.info(f"{label:>10}: n={iterations} mean={statistics.mean(latencies):.3f} ms "
+                f"p50={p50:.3f} ms p99={p99:.3f} ms max={latencies[-1]:.3f} ms")
+    return latencies
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark ping round-trip latency")
+    parser.add_argument("--iterations", type=int, default=200, help="Number of pings per mode")
+    args = parser.parse_args()
+
+    legacy = measure("legacy", args.iterations, legacy_ping)
+
+    for protocol in (PROTOCOL_NEWLINE, PROTOCOL_FRAMED):
+        connection = UnrealConnection(protocol=protocol)
+        if not connection.connect():
+            logger.error("Failed to connect to Unreal Engine")
+            sys.exit(1)
+
+        def keepalive_ping():
+            response = connection.send_command("ping")
+            if not response or response.get("status") != "success":
+                raise RuntimeError(f"Unexpected ping response: {response}")
+
+        try:
+            keepalive = measure(protocol, args.iterations, keepalive_ping)
+        finally:
+            connection.disconnect()
+
+        speedup = statistics.median(legacy) / max(statistics.median(keepalive), 1e-9)
+        logger.info(f"Median speedup of {protocol} keep-alive over legacy: {speedup:.1f}x")
+
+if __name__ == "__main__":
+    main()
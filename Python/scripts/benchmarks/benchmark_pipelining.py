@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+"""
+Benchmark request pipelining on a single connection.
+
+Sends the same batch of commands twice over one connection: first one at a
+time with the blocking UnrealConnection, then all at once with the
+id-multiplexed AsyncUnrealConnection, and compares the wall-clock time.
+
+Usage:
+    python scripts/benchmarks/benchmark_pipelining.py --requests 200 --command get_actors_in_level
+"""
+
+import sys
+import os
+import time
+import asyncio
+import logging
+import argparse
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_mcp_server import UnrealConnection
+from unreal_async_client import AsyncUnrealConnection
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("BenchmarkPipelining")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+def run_sequential(command: str, requests: int) -> float:
+    connection = UnrealConnection()
+    if not connection.connect():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+    try:
+        start = time.perf_counter()
+        for _ in range(requests):
+            connection.send_command(command)
+        return time.perf_counter() - start
+    finally:
+        connection.disconnect()
+
+async def run_pipelined(command: str, requests: int) -> float:
+    connection = AsyncUnrealConnection()
+    if not await connection.connect():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+    try:
+        start = time.perf_counter()
+        responses = await asyncio.gather(*(connection.send_command(command) for _ in range(requests)))
+        elapsed = time.perf_counter() - start
+        errors = [r for r in responses if r.get("status") == "error"]
+        if errors:
+            logger.warning(f"{len(errors)} pipelined requests failed, first: {errors[0]}")
+        return elapsed
+    finally:
+        await connection.disconnect()
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare sequential and pipelined requests on one connection")
+    parser.add_argument("--requests", type=int, default=200, help="Number of requests per mode")
+    parser.add_argument("--command", default="ping", help="Command to send")
+    args = parser.parse_args()
+
+    sequential = run_sequential(args.command, args.requests)
+    logger.info(f"sequential: {args.requests} requests in {sequential * 1000:.1f} ms "
+                f"({args.requests / sequential:.1f} req/s)")
+
+    pipelined = asyncio.run(run_pipelined(args.command, args.requests))
+    logger.info(f" pipelined: {args.requests} requests in {pipelined * 1000:.1f} ms "
+                f"({args.requests / pipelined:.1f} req/s)")
+    logger.info(f"Speedup: {sequential / max(pipelined, 1e-9):.1f}x")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+"""
+Benchmark streamed responses against responses built as JSON object trees.
+
+Fills the level with a number of point lights, then asks the plugin's
+benchmark_serialization command to build the responses of the streaming
+commands both ways and reports time, heap allocations and size per call.
+The lights are deleted again at the end.
+
+Usage:
+    python scripts/benchmarks/benchmark_serialization.py --actors 1000 --iterations 20 --encoding json
+"""
+
+import sys
+import os
+import logging
+import argparse
+from typing import Any, Dict, List
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_mcp_server import UnrealConnection
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("BenchmarkSerialization")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+ACTOR_PREFIX = "MCPBenchSerialization"
+
+def actor_commands(command: str, count: int) -> List[Dict[str, Any]]:
+    if command == "spawn_actor":
+        return [{
+            "type": "spawn_actor",
+            "params": {
+                "name": f"{ACTOR_PREFIX}_{index}",
+                "type": "PointLight",
+                "location": [float(index % 32) * 100.0, float(index // 32) * 100.0, 200.0]
+            }
+        } for index in range(count)]
+    return [{"type": "delete_actor", "params": {"name": f"{ACTOR_PREFIX}_{index}"}} for index in range(count)]
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare streamed and tree-built responses")
+    parser.add_argument("--actors", type=int, default=1000, help="Number of actors to add to the level first")
+    parser.add_argument("--iterations", type=int, default=20, help="Runs per command and mode")
+    parser.add_argument("--encoding", default="json", choices=["json", "cbor"], help="Response encoding to measure")
+    args = parser.parse_args()
+
+    connection = UnrealConnection()
+    if not connection.connect():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+
+    benchmarks = [
+        ("get_actors_in_level", {}),
+        ("find_actors_by_name", {"pattern": ACTOR_PREFIX}),
+        ("get_actor_properties", {"name": f"{ACTOR_PREFIX}_0"}),
+    ]
+
+    try:
+        if args.actors > 0:
+            connection.send_command("batch", {"commands": actor_commands("spawn_actor", args.actors)})
+
+        for command, params in benchmarks:
+            response = connection.send_command("benchmark_serialization", {
+                "command": command,
+                "params": params,
+                "iterations": args.iterations,
+                "encoding": args.encoding,
+            })
+            if not response or response.get("status") == "error":
+                logger.error(f"{command}: {(response or {}).get('error', 'no response')}")
+                continue
+
+            result = response["result"]
+            tree, streaming = result["tree"], result["streaming"]
+            for mode, stats in (("tree", tree), ("streaming", streaming)):
+                logger.info(f"{command:>20} {mode:>9}: {stats['ms_per_call']:.3f} ms, "
+                            f"{stats['allocations_per_call']:.0f} allocations, {stats['bytes']} bytes per call")
+            logger.info(f"{command:>20}  {tree['allocations_per_call'] / max(streaming['allocations_per_call'], 1):.1f}x fewer "
+                        f"allocations, {tree['ms_per_call'] / max(streaming['ms_per_call'], 1e-9):.1f}x faster")
+    finally:
+        if args.actors > 0:
+            connection.send_command("batch", {"commands": actor_commands("delete_actor", args.actors)})
+        connection.disconnect()
+
+if __name__ == "__main__":
+    main()
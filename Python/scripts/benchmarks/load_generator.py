@@ -0,0 +1,284 @@
+#!/usr/bin/env python
+"""
+Replay a command trace against the editor at a set concurrency and rate.
+
+A trace is a JSON Lines file of {"command": ..., "params": {...}} entries, run
+in order. Each of --concurrency workers replays the trace --iterations times,
+and "{worker}" and "{iteration}" in string parameters are replaced so every
+replay creates its own actors and assets. The traces folder has spawn storms,
+Blueprint build-ups, UMG construction and property sweeps.
+
+Without --rate every worker sends its next command as soon as the previous
+one is answered. With --rate, commands are started on a fixed schedule shared
+by all workers, and latency is measured from the scheduled start, so a slow
+editor shows up as latency instead of silently lowering the request rate.
+
+The results (throughput, latency percentiles overall and per command, and the
+editor's resident memory over the run on Linux) are written as JSON, so runs
+against two plugin versions can be compared with --baseline.
+
+Usage:
+    python scripts/benchmarks/load_generator.py scripts/benchmarks/traces/spawn_storm.jsonl \\
+        --concurrency 8 --iterations 20 --output results.json
+    python scripts/benchmarks/load_generator.py scripts/benchmarks/traces/property_sweep.jsonl \\
+        --rate 100 --baseline old.json --output new.json
+"""
+
+import sys
+import os
+import json
+import time
+import asyncio
+import logging
+import argparse
+import platform
+from datetime import datetime, timezone
+from typing import Any, Dict, List, Optional
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_async_client import UnrealConnectionPool
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("LoadGenerator")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+# Version of the results format
+RESULTS_SCHEMA = 1
+
+PERCENTILES = [50, 95, 99]
+
+def load_trace(path: str) -> List[Dict[str, Any]]:
+    trace = []
+    with open(path, encoding="utf-8") as trace_file:
+        for line_number, line in enumerate(trace_file, 1):
+            if not line.strip():
+                continue
+            entry = json.loads(line)
+            if "command" not in entry:
+                raise ValueError(f"{path}:{line_number}: entry has no 'command'")
+            trace.append({"command": entry["command"], "params": entry.get("params", {})})
+    return trace
+
+def substitute(value: Any, worker: int, iteration: int) -> Any:
+    """Replace the placeholders in every string of a parameter value."""
+    if isinstance(value, str):
+        return value.replace("{worker}", str(worker)).replace("{iteration}", str(iteration))
+    if isinstance(value, list):
+        return [substitute(item, worker, iteration) for item in value]
+    if isinstance(value, dict):
+        return {key: substitute(item, worker, iteration) for key, item in value.items()}
+    return value
+
+def summarize(latencies: List[float]) -> Dict[str, float]:
+    """Mean, nearest-rank percentiles and max of latencies in milliseconds."""
+    if not latencies:
+        return {}
+    ordered = sorted(latencies)
+    summary = {"mean": sum(ordered) / len(ordered)}
+    for percentile in PERCENTILES:
+        rank = max(1, -(-percentile * len(ordered) // 100))
+        summary[f"p{percentile}"] = ordered[rank - 1]
+    summary["max"] = ordered[-1]
+    return {key: round(value, 3) for key, value in summary.items()}
+
+def find_editor_pid() -> Optional[int]:
+    """The pid of a running UnrealEditor process, if /proc lists exactly one."""
+    if not os.path.isdir("/proc"):
+        return None
+    pids = []
+    for entry in os.listdir("/proc"):
+        if not entry.isdigit():
+            continue
+        try:
+            with open(f"/proc/{entry}/comm") as comm:
+                if comm.read().strip().startswith("UnrealEditor"):
+                    pids.append(int(entry))
+        except OSError:
+            continue
+    return pids[0] if len(pids) == 1 else None
+
+def read_rss_mb(pid: int) -> Optional[float]:
+    try:
+        with open(f"/proc/{pid}/status") as status:
+            for line in status:
+                if line.startswith("VmRSS:"):
+                    return int(line.split()[1]) / 1024.0
+    except OSError:
+        pass
+    return None
+
+async def sample_rss(pid: int, interval: float, start: float, samples: List[Dict[str, float]]) -> None:
+    while True:
+        rss = read_rss_mb(pid)
+        if rss is not None:
+            samples.append({"t_s": round(time.perf_counter() - start, 3), "rss_mb": round(rss, 1)})
+        await asyncio.sleep(interval)
+
+class Schedule:
+    """Start times spaced 1/rate apart, handed out to whichever worker asks next."""
+
+    def __init__(self, rate: float, start: float):
+        self.interval = 1.0 / rate
+        self.next_start = start
+
+    async def wait(self) -> float:
+        scheduled = self.next_start
+        self.next_start += self.interval
+        delay = scheduled - time.perf_counter()
+        if delay > 0:
+            await asyncio.sleep(delay)
+        return scheduled
+
+async def run_worker(pool: UnrealConnectionPool, trace: List[Dict[str, Any]], worker: int, iterations: int,
+                     schedule: Optional[Schedule], timeout: float, results: List[tuple]) -> None:
+    for iteration in range(iterations):
+        for entry in trace:
+            params = substitute(entry["params"], worker, iteration)
+            start = await schedule.wait() if schedule else time.perf_counter()
+            try:
+                response = await pool.send_command(entry["command"], params, timeout=timeout)
+                ok = bool(response) and response.get("status") != "error"
+                error = None if ok else (response or {}).get("error", "no response")
+            except Exception as e:
+                ok, error = False, str(e)
+            results.append((entry["command"], (time.perf_counter() - start) * 1000, ok))
+            if not ok:
+                logger.debug(f"worker {worker}: {entry['command']} failed: {error}")
+
+async def run(args, trace: List[Dict[str, Any]]) -> Dict[str, Any]:
+    pool = UnrealConnectionPool(host=args.host, port=args.port, encoding=args.encoding,
+                                size=args.connections or min(args.concurrency, 4), timeout=args.timeout)
+    if not await pool.start():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+
+    pid = args.editor_pid or find_editor_pid()
+    if pid is None:
+        logger.warning("Editor process not found, memory is not sampled; pass --editor-pid")
+
+    results: List[tuple] = []
+    rss_samples: List[Dict[str, float]] = []
+    start = time.perf_counter()
+    sampler = asyncio.create_task(sample_rss(pid, args.rss_interval, start, rss_samples)) if pid else None
+    schedule = Schedule(args.rate, start) if args.rate else None
+    try:
+        await asyncio.gather(*(
+            run_worker(pool, trace, worker, args.iterations, schedule, args.timeout, results)
+            for worker in range(args.concurrency)
+        ))
+        duration = time.perf_counter() - start
+    finally:
+        if sampler:
+            sampler.cancel()
+        await pool.close()
+    if pid and (rss := read_rss_mb(pid)) is not None:
+        rss_samples.append({"t_s": round(time.perf_counter() - start, 3), "rss_mb": round(rss, 1)})
+
+    commands: Dict[str, Dict[str, Any]] = {}
+    for command in sorted({command for command, _, _ in results}):
+        latencies = [ms for name, ms, _ in results if name == command]
+        commands[command] = {
+            "requests": len(latencies),
+            "errors": sum(1 for name, _, ok in results if name == command and not ok),
+            "latency_ms": summarize(latencies),
+        }
+
+    return {
+        "schema": RESULTS_SCHEMA,
+        "label": args.label,
+        "trace": os.path.basename(args.trace),
+        "started_at": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+        "host": platform.node(),
+        "config": {
+            "concurrency": args.concurrency,
+            "iterations": args.iterations,
+            "rate": args.rate,
+            "connections": args.connections or min(args.concurrency, 4),
+            "encoding": args.encoding,
+        },
+        "summary": {
+            "requests": len(results),
+            "errors": sum(1 for _, _, ok in results if not ok),
+            "duration_s": round(duration, 3),
+            "throughput_rps": round(len(results) / duration, 1) if duration > 0 else 0.0,
+            "latency_ms": summarize([ms for _, ms, _ in results]),
+        },
+        "commands": commands,
+        "rss_mb": {
+            "pid": pid,
+            "start": rss_samples[0]["rss_mb"] if rss_samples else None,
+            "peak": max(sample["rss_mb"] for sample in rss_samples) if rss_samples else None,
+            "end": rss_samples[-1]["rss_mb"] if rss_samples else None,
+            "samples": rss_samples,
+        },
+    }
+
+def report(results: Dict[str, Any], baseline: Optional[Dict[str, Any]]) -> None:
+    def delta(current: Optional[float], previous: Optional[float]) -> str:
+        if current is None or previous is None or previous == 0:
+            return ""
+        return f" ({(current - previous) / previous * 100:+.1f}%)"
+
+    summary = results["summary"]
+    base_summary = baseline["summary"] if baseline else {}
+    logger.info(f"{summary['requests']} requests, {summary['errors']} errors in {summary['duration_s']} s: "
+                f"{summary['throughput_rps']} requests/s{delta(summary['throughput_rps'], base_summary.get('throughput_rps'))}")
+
+    rows = [("all", summary["latency_ms"], base_summary.get("latency_ms", {}))]
+    for command, stats in results["commands"].items():
+        base_stats = baseline["commands"].get(command, {}) if baseline else {}
+        rows.append((command, stats["latency_ms"], base_stats.get("latency_ms", {})))
+    for name, latency, base_latency in rows:
+        if latency:
+            columns = "  ".join(f"{key} {latency[key]:8.3f}{delta(latency[key], base_latency.get(key))}"
+                                for key in [f"p{percentile}" for percentile in PERCENTILES])
+            logger.info(f"{name:<30} {columns} ms")
+
+    rss = results["rss_mb"]
+    if rss["samples"]:
+        logger.info(f"Editor RSS: {rss['start']} MB at start, {rss['peak']} MB peak, {rss['end']} MB at end"
+                    f"{delta(rss['peak'], (baseline or {}).get('rss_mb', {}).get('peak'))}")
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay a command trace against the editor and report latency, throughput and memory")
+    parser.add_argument("trace", help="JSON Lines trace of {command, params} entries")
+    parser.add_argument("--concurrency", type=int, default=4, help="Workers replaying the trace at the same time")
+    parser.add_argument("--iterations", type=int, default=10, help="Times each worker replays the trace")
+    parser.add_argument("--rate", type=float, default=0.0, help="Commands started per second across all workers; 0 sends as fast as answers arrive")
+    parser.add_argument("--connections", type=int, default=0, help="Pooled connections; defaults to the concurrency, at most 4")
+    parser.add_argument("--encoding", default="json", choices=["json", "cbor"], help="Response encoding to request")
+    parser.add_argument("--timeout", type=float, default=60.0, help="Seconds to wait for each response")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=55557)
+    parser.add_argument("--editor-pid", type=int, default=0, help="Editor process to sample memory of; found automatically on Linux if only one is running")
+    parser.add_argument("--rss-interval", type=float, default=1.0, help="Seconds between memory samples")
+    parser.add_argument("--label", default="", help="Free-form run label stored in the results, e.g. the plugin version")
+    parser.add_argument("--output", help="Write the results as JSON to this file")
+    parser.add_argument("--baseline", help="Results of an earlier run to compare against")
+    args = parser.parse_args()
+
+    trace = load_trace(args.trace)
+    baseline = None
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as baseline_file:
+            baseline = json.load(baseline_file)
+        if baseline.get("trace") != os.path.basename(args.trace) or baseline.get("config", {}).get("concurrency") != args.concurrency:
+            logger.warning(f"Baseline ran {baseline.get('trace')} with another setup; the comparison may not be meaningful")
+
+    logger.info(f"Replaying {len(trace)} commands x {args.iterations} iterations x {args.concurrency} workers from {args.trace}")
+    results = asyncio.run(run(args, trace))
+    report(results, baseline)
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as output_file:
+            json.dump(results, output_file, indent=2)
+        logger.info(f"Results written to {args.output}")
+
+if __name__ == "__main__":
+    main()
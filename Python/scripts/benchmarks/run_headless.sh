@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+#
+# Launch the editor without rendering, replay a trace against it with
+# load_generator.py, then shut the editor down.
+#
+# The plugin serves commands from the editor's game thread, so it needs a
+# ticking editor: -nullrhi keeps the full editor loop without a GPU or window.
+# Commandlets don't tick the editor loop and can't run commands.
+#
+# Usage:
+#   UE_ROOT=/opt/UnrealEngine scripts/benchmarks/run_headless.sh scripts/benchmarks/traces/spawn_storm.jsonl \
+#       --concurrency 8 --iterations 20 --output results.json
+#
+# Environment:
+#   UE_ROOT          Engine directory (required)
+#   UE_PROJECT       Project to open; defaults to the MCPGameProject of this repository
+#   STARTUP_TIMEOUT  Seconds to wait for the MCP server to accept connections (default 600)
+#   MCP_PORT         Port the plugin listens on (default 55557)
+#
+# Benchmarks create actors and assets; run them on a copy of the project you can throw away.
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PYTHON_DIR="$(cd "$SCRIPT_DIR/../.." && pwd)"
+
+: "${UE_ROOT:?Set UE_ROOT to the engine directory}"
+UE_PROJECT="${UE_PROJECT:-$(cd "$PYTHON_DIR/../MCPGameProject" && pwd)/MCPGameProject.uproject}"
+STARTUP_TIMEOUT="${STARTUP_TIMEOUT:-600}"
+MCP_PORT="${MCP_PORT:-55557}"
+EDITOR="$UE_ROOT/Engine/Binaries/Linux/UnrealEditor"
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <trace.jsonl> [load_generator.py options]" >&2
+    exit 2
+fi
+
+LOG_FILE="$(mktemp -t unrealmcp-editor.XXXXXX.log)"
+echo "Starting $EDITOR with $UE_PROJECT, log in $LOG_FILE"
+"$EDITOR" "$UE_PROJECT" -nullrhi -unattended -nosplash -nosound -nopause -stdout -FullStdOutLogOutput > "$LOG_FILE" 2>&1 &
+EDITOR_PID=$!
+
+stop_editor() {
+    if kill -0 "$EDITOR_PID" 2>/dev/null; then
+        kill "$EDITOR_PID"
+        wait "$EDITOR_PID" 2>/dev/null || true
+    fi
+}
+trap stop_editor EXIT
+
+# The server starts once the editor has loaded the project
+DEADLINE=$((SECONDS + STARTUP_TIMEOUT))
+until python3 -c "import socket, sys; socket.create_connection(('127.0.0.1', $MCP_PORT), 1).close()" 2>/dev/null; do
+    if ! kill -0 "$EDITOR_PID" 2>/dev/null; then
+        echo "Editor exited during startup; see $LOG_FILE" >&2
+        exit 1
+    fi
+    if [ "$SECONDS" -ge "$DEADLINE" ]; then
+        echo "MCP server did not start within $STARTUP_TIMEOUT s; see $LOG_FILE" >&2
+        exit 1
+    fi
+    sleep 2
+done
+
+# No 'exec': the trap has to stop the editor when the run ends
+cd "$PYTHON_DIR"
+python3 scripts/benchmarks/load_generator.py "$@" --port "$MCP_PORT" --editor-pid "$EDITOR_PID"
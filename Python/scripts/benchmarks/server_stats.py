@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+"""
+Report the plugin's per-command latency statistics.
+
+Reads get_server_stats and prints, for every command answered since the last
+reset, the percentiles of each phase a request goes through (receive, parse,
+queue, handler, serialize, send, total). Meant to run after a benchmark or a
+nightly test session: --reset starts the next run from zero, and --max-p99
+fails the run if a command's total p99 exceeds a budget.
+
+Usage:
+    python scripts/benchmarks/server_stats.py
+    python scripts/benchmarks/server_stats.py --reset --max-p99 ping=2 --max-p99 get_actors_in_level=50
+"""
+
+import sys
+import os
+import logging
+import argparse
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_mcp_server import UnrealConnection
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("ServerStats")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+PHASES = ["receive", "parse", "queue", "handler", "serialize", "send", "total"]
+
+def parse_budget(value: str) -> tuple:
+    command, _, ms = value.partition("=")
+    if not command or not ms:
+        raise argparse.ArgumentTypeError(f"expected COMMAND=MS, got '{value}'")
+    return command, float(ms)
+
+def main():
+    parser = argparse.ArgumentParser(description="Print per-command latency statistics from the plugin")
+    parser.add_argument("--command", default="", help="Only report this command")
+    parser.add_argument("--reset", action="store_true", help="Clear the statistics after reading them")
+    parser.add_argument("--max-p99", type=parse_budget, action="append", default=[], metavar="COMMAND=MS",
+                        help="Fail if the command's total p99 exceeds MS milliseconds; may be repeated")
+    args = parser.parse_args()
+
+    connection = UnrealConnection()
+    if not connection.connect():
+        logger.error("Failed to connect to Unreal Engine")
+        sys.exit(1)
+    try:
+        response = connection.send_command("get_server_stats", {"command": args.command, "reset": args.reset})
+    finally:
+        connection.disconnect()
+
+    if not response or response.get("status") == "error":
+        logger.error(f"get_server_stats failed: {response}")
+        sys.exit(1)
+
+    stats = response["result"]
+    commands = stats["commands"]
+    logger.info(f"{len(commands)} commands answered in the last {stats['since_reset_s']:.1f} s")
+    for name, command in commands.items():
+        logger.info(f"{name}: {command['count']} requests, {command['errors']} errors")
+        for phase in PHASES:
+            if phase in command["phases"]:
+                p = command["phases"][phase]
+                logger.info(f"  {phase:<10} mean {p['mean_ms']:8.3f}  p50 {p['p50_ms']:8.3f}  p90 {p['p90_ms']:8.3f}  "
+                            f"p99 {p['p99_ms']:8.3f}  max {p['max_ms']:8.3f} ms")
+
+    failed = False
+    for name, budget in args.max_p99:
+        total = commands.get(name, {}).get("phases", {}).get("total")
+        if total is None:
+            logger.warning(f"{name}: no requests recorded, budget of {budget} ms not checked")
+        elif total["p99_ms"] > budget:
+            logger.error(f"{name}: total p99 {total['p99_ms']:.3f} ms exceeds the budget of {budget} ms")
+            failed = True
+    sys.exit(1 if failed else 0)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,108 @@
+#!/usr/bin/env python
+"""
+Stress the server with several clients issuing commands at the same time.
+
+Each worker thread owns its own UnrealConnection (one server session) and
+sends the same command in a loop. Reports per-call latency percentiles and
+aggregate throughput, which shows whether sessions are served concurrently
+or queue behind each other.
+
+Usage:
+    python scripts/benchmarks/stress_sessions.py --clients 16 --iterations 100
+"""
+
+import sys
+import os
+import time
+import logging
+import argparse
+import threading
+from typing import List
+
+# Add the Python directory to the path so we can import the server module
+sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
+
+from unreal_mcp_server import UnrealConnection
+
+# Set up logging; the server module already routes the root logger to unreal_mcp.log
+logger = logging.getLogger("StressSessions")
+logger.setLevel(logging.INFO)
+logger.propagate = False
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+def worker(command: str, iterations: int, start_barrier: threading.Barrier,
+           latencies: List[float], errors: List[str], lock: threading.Lock) -> None:
+    """Run one client session and record the latency of every call."""
+    connection = UnrealConnection()
+    if not connection.connect():
+        with lock:
+            errors.append("connect failed")
+        start_barrier.abort()
+        return
+
+    local = []
+    try:
+        start_barrier.wait()
+        for _ in range(iterations):
+            start = time.perf_counter()
+            response = connection.send_command(command)
+            local.append((time.perf_counter() - start) * 1000.0)
+            if not response or response.get("status") == "error":
+                with lock:
+                    errors.append(str(response))
+    except threading.BrokenBarrierError:
+        pass
+    finally:
+        connection.disconnect()
+        with lock:
+            latencies.extend(local)
+
+def main():
+    parser = argparse.ArgumentParser(description="Stress the server with concurrent client sessions")
+    parser.add_argument("--clients", type=int, default=16, help="Number of concurrent client sessions")
+    parser.add_argument("--iterations", type=int, default=100, help="Commands sent by each client")
+    parser.add_argument("--command", default="get_actors_in_level", help="Command each client sends")
+    args = parser.parse_args()
+
+    latencies: List[float] = []
+    errors: List[str] = []
+    lock = threading.Lock()
+    # The extra party is the main thread, so timing starts once every client is connected
+    start_barrier = threading.Barrier(args.clients + 1)
+
+    threads = [threading.Thread(target=worker,
+                                args=(args.command, args.iterations, start_barrier, latencies, errors, lock))
+               for _ in range(args.clients)]
+    for thread in threads:
+        thread.start()
+
+    try:
+        start_barrier.wait()
+    except threading.BrokenBarrierError:
+        for thread in threads:
+            thread.join()
+        logger.error(f"Not every client could connect: {errors}")
+        sys.exit(1)
+
+    start = time.perf_counter()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start
+
+    if not latencies:
+        logger.error("No commands completed")
+        sys.exit(1)
+
+    latencies.sort()
+    p50 = latencies[len(latencies) // 2]
+    p99 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.99))]
+    logger.info(f"{args.clients} clients x {args.iterations} '{args.command}': "
+                f"{len(latencies)} calls in {elapsed:.2f} s ({len(latencies) / elapsed:.1f} calls/s)")
+    logger.info(f"p50={p50:.3f} ms p99={p99:.3f} ms max={latencies[-1]:.3f} ms errors={len(errors)}")
+    if errors:
+        logger.warning(f"First error: {errors[0]}")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+"""
+Summarize a request trace recorded by the plugin and convert it for load_generator.py.
+
+The plugin records a binary trace of every request it answers while recording is
+on (start_trace_recording, or Project Settings > Plugins > Unreal MCP >
+Diagnostics > Record Trace). This prints the trace's per-command request count,
+errors and latency, and with --output writes its requests as a JSON Lines trace
+that load_generator.py can replay at any concurrency. To replay it in the editor
+at its recorded pace instead, use the UnrealMCPReplay commandlet.
+
+Usage:
+    python scripts/benchmarks/trace_to_jsonl.py Saved/UnrealMCP/Traces/Trace-2025.01.01-12.00.00.mcptrace
+    python scripts/benchmarks/trace_to_jsonl.py session.mcptrace --output traces/session.jsonl --skip ping
+"""
+
+import sys
+import json
+import struct
+import logging
+import argparse
+from datetime import datetime, timezone
+from typing import Any, Dict, Iterator, Tuple
+
+# Set up logging
+logger = logging.getLogger("TraceToJsonl")
+logger.setLevel(logging.INFO)
+_handler = logging.StreamHandler(sys.stdout)
+_handler.setFormatter(logging.Formatter('%(asctime)s - %(name)s - %(levelname)s - %(message)s'))
+logger.addHandler(_handler)
+
+# Layout of FUnrealMCPTraceRecorder files, little-endian
+TRACE_MAGIC = b"UMCT"
+TRACE_VERSION = 1
+HEADER = struct.Struct("<4sIq")
+RECORD_START = struct.Struct("<Qi")
+RECORD_END = struct.Struct("<IIB")
+STRING_LENGTH = struct.Struct("<I")
+
+def read_trace(path: str) -> Tuple[datetime, Iterator[Dict[str, Any]]]:
+    with open(path, "rb") as trace_file:
+        data = trace_file.read()
+    if len(data) < HEADER.size:
+        raise ValueError(f"{path} is not an MCP trace file")
+    magic, version, start_ms = HEADER.unpack_from(data, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError(f"{path} is not an MCP trace file")
+    if version != TRACE_VERSION:
+        raise ValueError(f"{path} has trace format version {version}; this script reads version {TRACE_VERSION}")
+
+    def records() -> Iterator[Dict[str, Any]]:
+        offset = HEADER.size
+        try:
+            while offset < len(data):
+                timestamp_us, connection = RECORD_START.unpack_from(data, offset)
+                offset += RECORD_START.size
+                strings = []
+                for _ in range(2):
+                    (length,) = STRING_LENGTH.unpack_from(data, offset)
+                    offset += STRING_LENGTH.size
+                    if offset + length > len(data):
+                        raise struct.error("string runs past the end of the file")
+                    strings.append(data[offset:offset + length].decode("utf-8"))
+                    offset += length
+                response_size, latency_us, flags = RECORD_END.unpack_from(data, offset)
+                offset += RECORD_END.size
+                yield {
+                    "timestamp_us": timestamp_us,
+                    "connection": connection,
+                    "command": strings[0],
+                    "params": json.loads(strings[1]) if strings[1] else {},
+                    "response_size": response_size,
+                    "latency_us": latency_us,
+                    "succeeded": bool(flags & 1),
+                }
+        except struct.error:
+            # The editor stopped while writing; the records before are complete
+            logger.warning(f"{path} ends in a truncated record")
+
+    return datetime.fromtimestamp(start_ms / 1000, timezone.utc), records()
+
+def main():
+    parser = argparse.ArgumentParser(description="Summarize a plugin request trace and convert it to a load_generator.py trace")
+    parser.add_argument("trace", help="Binary .mcptrace file recorded by the plugin")
+    parser.add_argument("--output", help="Write the requests as a JSON Lines trace to this file")
+    parser.add_argument("--skip", action="append", default=[], metavar="COMMAND",
+                        help="Leave this command out of the output, e.g. ping or get_server_stats; may be repeated")
+    args = parser.parse_args()
+
+    started, records = read_trace(args.trace)
+    commands: Dict[str, Dict[str, Any]] = {}
+    connections = set()
+    count = 0
+    end_us = 0
+    output = open(args.output, "w", encoding="utf-8") if args.output else None
+    try:
+        # Records are written as responses are sent; write the requests in the order they arrived
+        for record in sorted(records, key=lambda r: r["timestamp_us"]):
+            count += 1
+            connections.add(record["connection"])
+            end_us = max(end_us, record["timestamp_us"] + record["latency_us"])
+            stats = commands.setdefault(record["command"], {"requests": 0, "errors": 0, "latencies_ms": [], "bytes": 0})
+            stats["requests"] += 1
+            stats["errors"] += 0 if record["succeeded"] else 1
+            stats["latencies_ms"].append(record["latency_us"] / 1000)
+            stats["bytes"] += record["response_size"]
+            if output and record["command"] not in args.skip:
+                output.write(json.dumps({"command": record["command"], "params": record["params"]}) + "\n")
+    finally:
+        if output:
+            output.close()
+
+    logger.info(f"{count} requests on {len(connections)} connections over {end_us / 1e6:.3f} s, "
+                f"recorded from {started.isoformat(timespec='seconds')}")
+    for name, stats in sorted(commands.items()):
+        latencies = sorted(stats["latencies_ms"])
+        p99 = latencies[max(0, -(-99 * len(latencies) // 100) - 1)]
+        logger.info(f"{name:<30} {stats['requests']:6} requests  {stats['errors']:4} errors  "
+                    f"mean {sum(latencies) / len(latencies):9.3f}  p99 {p99:9.3f}  max {latencies[-1]:9.3f} ms  "
+                    f"{stats['bytes'] / stats['requests']:9.0f} bytes/response")
+    if args.output:
+        logger.info(f"Requests written to {args.output}")
+
+if __name__ == "__main__":
+    main()
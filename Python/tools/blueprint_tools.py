@@ -7,6 +7,7 @@ This module provides tools for creating and manipulating Blueprint assets in Unr
 import logging
 from typing import Dict, List, Any
 from mcp.server.fastmcp import FastMCP, Context
+from unreal_logging import log_payload
 
 # Get logger
 logger = logging.getLogger("UnrealMCP")
@@ -15,7 +16,7 @@ def register_blueprint_tools(mcp: FastMCP):
     """Register Blueprint tools with the MCP server."""
     
     @mcp.tool()
-    def create_blueprint(
+    async def create_blueprint(
         ctx: Context,
         name: str,
         parent_class: str
@@ -30,7 +31,7 @@ def register_blueprint_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("create_blueprint", {
+            response = await unreal.send_command("create_blueprint", {
                 "name": name,
                 "parent_class": parent_class
             })
@@ -39,7 +40,7 @@ def register_blueprint_tools(mcp: FastMCP):
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Blueprint creation response: {response}")
+            log_payload("Blueprint creation response", response)
             return response or {}
             
         except Exception as e:
@@ -48,7 +49,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_component_to_blueprint(
+    async def add_component_to_blueprint(
         ctx: Context,
         blueprint_name: str,
         component_type: str,
@@ -105,13 +106,13 @@ def register_blueprint_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
             logger.info(f"Adding component to blueprint with params: {params}")
-            response = unreal.send_command("add_component_to_blueprint", params)
+            response = await unreal.send_command("add_component_to_blueprint", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Component addition response: {response}")
+            log_payload("Component addition response", response)
             return response
             
         except Exception as e:
@@ -120,7 +121,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def set_static_mesh_properties(
+    async def set_static_mesh_properties(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -152,13 +153,13 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting static mesh properties with params: {params}")
-            response = unreal.send_command("set_static_mesh_properties", params)
+            response = await unreal.send_command("set_static_mesh_properties", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Set static mesh properties response: {response}")
+            log_payload("Set static mesh properties response", response)
             return response
             
         except Exception as e:
@@ -167,7 +168,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def set_component_property(
+    async def set_component_property(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -191,13 +192,13 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting component property with params: {params}")
-            response = unreal.send_command("set_component_property", params)
+            response = await unreal.send_command("set_component_property", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Set component property response: {response}")
+            log_payload("Set component property response", response)
             return response
             
         except Exception as e:
@@ -206,7 +207,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def set_physics_properties(
+    async def set_physics_properties(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -236,13 +237,13 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting physics properties with params: {params}")
-            response = unreal.send_command("set_physics_properties", params)
+            response = await unreal.send_command("set_physics_properties", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Set physics properties response: {response}")
+            log_payload("Set physics properties response", response)
             return response
             
         except Exception as e:
@@ -251,7 +252,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def compile_blueprint(
+    async def compile_blueprint(
         ctx: Context,
         blueprint_name: str
     ) -> Dict[str, Any]:
@@ -269,13 +270,13 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Compiling blueprint: {blueprint_name}")
-            response = unreal.send_command("compile_blueprint", params)
+            response = await unreal.send_command("compile_blueprint", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Compile blueprint response: {response}")
+            log_payload("Compile blueprint response", response)
             return response
             
         except Exception as e:
@@ -284,7 +285,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def set_blueprint_property(
+    async def set_blueprint_property(
         ctx: Context,
         blueprint_name: str,
         property_name: str,
@@ -316,13 +317,13 @@ def register_blueprint_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting blueprint property with params: {params}")
-            response = unreal.send_command("set_blueprint_property", params)
+            response = await unreal.send_command("set_blueprint_property", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Set blueprint property response: {response}")
+            log_payload("Set blueprint property response", response)
             return response
             
         except Exception as e:
@@ -331,7 +332,7 @@ def register_blueprint_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     # @mcp.tool() commented out, just use set_component_property instead
-    def set_pawn_properties(
+    async def set_pawn_properties(
         ctx: Context,
         blueprint_name: str,
         auto_possess_player: str = "",
@@ -394,7 +395,7 @@ def register_blueprint_tools(mcp: FastMCP):
                 }
                 
                 logger.info(f"Setting pawn property {prop_name} to {prop_value}")
-                response = unreal.send_command("set_blueprint_property", params)
+                response = await unreal.send_command("set_blueprint_property", params)
                 
                 if not response:
                     logger.error(f"No response from Unreal Engine for property {prop_name}")
@@ -7,52 +7,87 @@ This module provides tools for controlling the Unreal Editor viewport and other
 import logging
 from typing import Dict, List, Any, Optional
 from mcp.server.fastmcp import FastMCP, Context
+from unreal_logging import log_payload
 
 # Get logger
 logger = logging.getLogger("UnrealMCP")
 
+# Actors returned per get_actors_in_level call unless the caller asks for another limit
+ACTOR_PAGE_SIZE = 100
+
 def register_editor_tools(mcp: FastMCP):
     """Register editor tools with the MCP server."""
     
     @mcp.tool()
-    def get_actors_in_level(ctx: Context) -> List[Dict[str, Any]]:
-        """Get a list of all actors in the current level."""
+    async def get_actors_in_level(
+        ctx: Context,
+        class_name: str = None,
+        tags: List[str] = None,
+        bounds: Dict[str, List[float]] = None,
+        fields: List[str] = None,
+        cursor: str = None,
+        offset: int = 0,
+        limit: int = ACTOR_PAGE_SIZE
+    ) -> Dict[str, Any]:
+        """Get one page of the actors in the current level, ordered by name.
+        
+        Args:
+            class_name: Only return actors of this class or its subclasses
+            tags: Only return actors that have at least one of these tags
+            bounds: {"min": [x, y, z], "max": [x, y, z]}; only return actors located inside the box
+            fields: Actor fields to return (name, label, class, location, rotation, scale, tags, path);
+                    defaults to name, class, location, rotation and scale
+            cursor: The next_cursor of the previous page; the page starts after that actor
+            offset: Number of matching actors to skip (after the cursor, if any)
+            limit: Maximum number of actors to return
+            
+        Returns:
+            Dict with "actors", "total" (number of matching actors), "start" and, when more
+            actors follow, "next_cursor" to pass as cursor for the next page
+        """
         from unreal_mcp_server import get_unreal_connection
         
         try:
             unreal = get_unreal_connection()
             if not unreal:
                 logger.warning("Failed to connect to Unreal Engine")
-                return []
-                
-            response = unreal.send_command("get_actors_in_level", {})
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
+            # One bounded page per call, so a large level never turns into one huge tool result
+            params = {"limit": max(1, limit)}
+            if class_name:
+                params["class"] = class_name
+            if tags:
+                params["tags"] = tags
+            if bounds:
+                params["bounds"] = bounds
+            if fields:
+                params["fields"] = fields
+            if cursor:
+                params["cursor"] = cursor
+            if offset > 0:
+                params["offset"] = offset
+            
+            response = await unreal.send_command("get_actors_in_level", params)
             if not response:
                 logger.warning("No response from Unreal Engine")
-                return []
-                
-            # Log the complete response for debugging
-            logger.info(f"Complete response from Unreal: {response}")
-            
-            # Check response format
-            if "result" in response and "actors" in response["result"]:
-                actors = response["result"]["actors"]
-                logger.info(f"Found {len(actors)} actors in level")
-                return actors
-            elif "actors" in response:
-                actors = response["actors"]
-                logger.info(f"Found {len(actors)} actors in level")
-                return actors
-                
-            logger.warning(f"Unexpected response format: {response}")
-            return []
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            result = response.get("result", response)
+            if response.get("status") == "error" or "actors" not in result:
+                logger.warning(f"Unexpected response format: {response}")
+                return response
+            
+            logger.info(f"Got {len(result['actors'])} of {result.get('total')} actors in level")
+            return result
             
         except Exception as e:
-            logger.error(f"Error getting actors: {e}")
-            return []
+            error_msg = f"Error getting actors: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def find_actors_by_name(ctx: Context, pattern: str) -> List[str]:
+    async def find_actors_by_name(ctx: Context, pattern: str) -> List[str]:
         """Find actors by name pattern."""
         from unreal_mcp_server import get_unreal_connection
         
@@ -62,7 +97,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.warning("Failed to connect to Unreal Engine")
                 return []
                 
-            response = unreal.send_command("find_actors_by_name", {
+            response = await unreal.send_command("find_actors_by_name", {
                 "pattern": pattern
             })
             
@@ -76,7 +111,7 @@ def register_editor_tools(mcp: FastMCP):
             return []
     
     @mcp.tool()
-    def spawn_actor(
+    async def spawn_actor(
         ctx: Context,
         name: str,
         type: str,
@@ -127,14 +162,14 @@ def register_editor_tools(mcp: FastMCP):
                 params[param_name] = [float(val) for val in param_value]
             
             logger.info(f"Creating actor '{name}' of type '{type}' with params: {params}")
-            response = unreal.send_command("spawn_actor", params)
+            response = await unreal.send_command("spawn_actor", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
             # Log the complete response for debugging
-            logger.info(f"Actor creation response: {response}")
+            log_payload("Actor creation response", response)
             
             # Handle error responses correctly
             if response.get("status") == "error":
@@ -150,7 +185,7 @@ def register_editor_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def delete_actor(ctx: Context, name: str) -> Dict[str, Any]:
+    async def delete_actor(ctx: Context, name: str) -> Dict[str, Any]:
         """Delete an actor by name."""
         from unreal_mcp_server import get_unreal_connection
         
@@ -160,7 +195,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("delete_actor", {
+            response = await unreal.send_command("delete_actor", {
                 "name": name
             })
             return response or {}
@@ -170,7 +205,7 @@ def register_editor_tools(mcp: FastMCP):
             return {}
     
     @mcp.tool()
-    def set_actor_transform(
+    async def set_actor_transform(
         ctx: Context,
         name: str,
         location: List[float]  = None,
@@ -194,7 +229,7 @@ def register_editor_tools(mcp: FastMCP):
             if scale is not None:
                 params["scale"] = scale
                 
-            response = unreal.send_command("set_actor_transform", params)
+            response = await unreal.send_command("set_actor_transform", params)
             return response or {}
             
         except Exception as e:
@@ -202,7 +237,7 @@ def register_editor_tools(mcp: FastMCP):
             return {}
     
     @mcp.tool()
-    def get_actor_properties(ctx: Context, name: str) -> Dict[str, Any]:
+    async def get_actor_properties(ctx: Context, name: str) -> Dict[str, Any]:
         """Get all properties of an actor."""
         from unreal_mcp_server import get_unreal_connection
         
@@ -212,7 +247,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("get_actor_properties", {
+            response = await unreal.send_command("get_actor_properties", {
                 "name": name
             })
             return response or {}
@@ -222,7 +257,7 @@ def register_editor_tools(mcp: FastMCP):
             return {}
 
     @mcp.tool()
-    def set_actor_property(
+    async def set_actor_property(
         ctx: Context,
         name: str,
         property_name: str,
@@ -247,7 +282,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("set_actor_property", {
+            response = await unreal.send_command("set_actor_property", {
                 "name": name,
                 "property_name": property_name,
                 "property_value": property_value
@@ -257,7 +292,7 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Set actor property response: {response}")
+            log_payload("Set actor property response", response)
             return response
             
         except Exception as e:
@@ -266,7 +301,7 @@ def register_editor_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     # @mcp.tool() commented out because it's buggy
-    def focus_viewport(
+    async def focus_viewport(
         ctx: Context,
         target: str = None,
         location: List[float] = None,
@@ -305,7 +340,7 @@ def register_editor_tools(mcp: FastMCP):
             if orientation:
                 params["orientation"] = orientation
                 
-            response = unreal.send_command("focus_viewport", params)
+            response = await unreal.send_command("focus_viewport", params)
             return response or {}
             
         except Exception as e:
@@ -313,7 +348,7 @@ def register_editor_tools(mcp: FastMCP):
             return {"status": "error", "message": str(e)}
 
     @mcp.tool()
-    def spawn_blueprint_actor(
+    async def spawn_blueprint_actor(
         ctx: Context,
         blueprint_name: str,
         actor_name: str,
@@ -358,13 +393,13 @@ def register_editor_tools(mcp: FastMCP):
                 params[param_name] = [float(val) for val in param_value]
             
             logger.info(f"Spawning blueprint actor with params: {params}")
-            response = unreal.send_command("spawn_blueprint_actor", params)
+            response = await unreal.send_command("spawn_blueprint_actor", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Spawn blueprint actor response: {response}")
+            log_payload("Spawn blueprint actor response", response)
             return response
             
         except Exception as e:
@@ -373,7 +408,7 @@ def register_editor_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def set_actor_material(
+    async def set_actor_material(
         ctx: Context,
         name: str,
         color: List[float]
@@ -402,13 +437,13 @@ def register_editor_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting material color for '{name}' to {color}")
-            response = unreal.send_command("set_actor_material", params)
+            response = await unreal.send_command("set_actor_material", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Set material response: {response}")
+            log_payload("Set material response", response)
             return response
             
         except Exception as e:
@@ -416,4 +451,118 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
 
+    @mcp.tool()
+    async def batch_commands(
+        ctx: Context,
+        commands: List[Dict[str, Any]],
+        stop_on_error: bool = False,
+        transaction: bool = True,
+        transaction_name: str = None
+    ) -> Dict[str, Any]:
+        """Run many commands in a single round trip to the editor.
+        
+        Args:
+            ctx: The MCP context
+            commands: List of {"type": command_name, "params": {...}} entries, run in order
+            stop_on_error: Stop at the first entry that fails
+            transaction: Record the whole batch as a single undo step (default True, as on the server)
+            transaction_name: Undo history label used when transaction is true
+            
+        Returns:
+            Dict with one response per executed entry under "results", plus "executed", "failed" and "stopped"
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {
+                "commands": commands,
+                "stop_on_error": stop_on_error,
+                "transaction": transaction
+            }
+            if transaction_name:
+                params["transaction_name"] = transaction_name
+            
+            logger.info(f"Running batch of {len(commands)} commands")
+            response = await unreal.send_command("batch", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error running batch: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    @mcp.tool()
+    async def begin_transaction(ctx: Context, name: str = "MCP Edit") -> Dict[str, Any]:
+        """Open an undo group for the commands that follow, until end_transaction.
+        
+        Args:
+            ctx: The MCP context
+            name: Undo history label of the group's steps
+            
+        Returns:
+            Dict with the group's state and the plugin's undo memory use
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("begin_transaction", {"name": name})
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error beginning transaction: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
+    @mcp.tool()
+    async def end_transaction(ctx: Context, undo: bool = False) -> Dict[str, Any]:
+        """Close the undo group opened by begin_transaction.
+        
+        Args:
+            ctx: The MCP context
+            undo: Revert the group's edits, e.g. to abandon a step
+            
+        Returns:
+            Dict with the number of commands run in the group and whether they were undone
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            response = await unreal.send_command("end_transaction", {"undo": undo})
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error ending transaction: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
     logger.info("Editor tools registered successfully")
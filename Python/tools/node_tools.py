@@ -7,6 +7,7 @@ This module provides tools for manipulating Blueprint graph nodes and connection
 import logging
 from typing import Dict, List, Any, Optional
 from mcp.server.fastmcp import FastMCP, Context
+from unreal_logging import log_payload
 
 # Get logger
 logger = logging.getLogger("UnrealMCP")
@@ -15,7 +16,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
     """Register Blueprint node manipulation tools with the MCP server."""
     
     @mcp.tool()
-    def add_blueprint_event_node(
+    async def add_blueprint_event_node(
         ctx: Context,
         blueprint_name: str,
         event_name: str,
@@ -54,13 +55,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding event node '{event_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_event_node", params)
+            response = await unreal.send_command("add_blueprint_event_node", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Event node creation response: {response}")
+            log_payload("Event node creation response", response)
             return response
             
         except Exception as e:
@@ -69,7 +70,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_input_action_node(
+    async def add_blueprint_input_action_node(
         ctx: Context,
         blueprint_name: str,
         action_name: str,
@@ -105,13 +106,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding input action node for '{action_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_input_action_node", params)
+            response = await unreal.send_command("add_blueprint_input_action_node", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Input action node creation response: {response}")
+            log_payload("Input action node creation response", response)
             return response
             
         except Exception as e:
@@ -120,7 +121,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_function_node(
+    async def add_blueprint_function_node(
         ctx: Context,
         blueprint_name: str,
         target: str,
@@ -164,13 +165,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding function node '{function_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_function_node", command_params)
+            response = await unreal.send_command("add_blueprint_function_node", command_params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Function node creation response: {response}")
+            log_payload("Function node creation response", response)
             return response
             
         except Exception as e:
@@ -179,7 +180,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
             
     @mcp.tool()
-    def connect_blueprint_nodes(
+    async def connect_blueprint_nodes(
         ctx: Context,
         blueprint_name: str,
         source_node_id: str,
@@ -217,13 +218,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Connecting nodes in blueprint '{blueprint_name}'")
-            response = unreal.send_command("connect_blueprint_nodes", params)
+            response = await unreal.send_command("connect_blueprint_nodes", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Node connection response: {response}")
+            log_payload("Node connection response", response)
             return response
             
         except Exception as e:
@@ -232,7 +233,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_variable(
+    async def add_blueprint_variable(
         ctx: Context,
         blueprint_name: str,
         variable_name: str,
@@ -267,13 +268,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding variable '{variable_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_variable", params)
+            response = await unreal.send_command("add_blueprint_variable", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Variable creation response: {response}")
+            log_payload("Variable creation response", response)
             return response
             
         except Exception as e:
@@ -282,7 +283,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_get_self_component_reference(
+    async def add_blueprint_get_self_component_reference(
         ctx: Context,
         blueprint_name: str,
         component_name: str,
@@ -319,13 +320,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding self component reference node for '{component_name}' to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_get_self_component_reference", params)
+            response = await unreal.send_command("add_blueprint_get_self_component_reference", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Self component reference node creation response: {response}")
+            log_payload("Self component reference node creation response", response)
             return response
             
         except Exception as e:
@@ -334,7 +335,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def add_blueprint_self_reference(
+    async def add_blueprint_self_reference(
         ctx: Context,
         blueprint_name: str,
         node_position = None
@@ -366,13 +367,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Adding self reference node to blueprint '{blueprint_name}'")
-            response = unreal.send_command("add_blueprint_self_reference", params)
+            response = await unreal.send_command("add_blueprint_self_reference", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Self reference node creation response: {response}")
+            log_payload("Self reference node creation response", response)
             return response
             
         except Exception as e:
@@ -381,7 +382,7 @@ def register_blueprint_node_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
     
     @mcp.tool()
-    def find_blueprint_nodes(
+    async def find_blueprint_nodes(
         ctx: Context,
         blueprint_name: str,
         node_type = None,
@@ -413,13 +414,13 @@ def register_blueprint_node_tools(mcp: FastMCP):
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
             
             logger.info(f"Finding nodes in blueprint '{blueprint_name}'")
-            response = unreal.send_command("find_blueprint_nodes", params)
+            response = await unreal.send_command("find_blueprint_nodes", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Node find response: {response}")
+            log_payload("Node find response", response)
             return response
             
         except Exception as e:
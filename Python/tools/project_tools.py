@@ -5,17 +5,21 @@ This module provides tools for managing project-wide settings and configuration.
 """
 
 import logging
-from typing import Dict, Any
+from typing import Dict, List, Any
 from mcp.server.fastmcp import FastMCP, Context
+from unreal_logging import log_payload
 
 # Get logger
 logger = logging.getLogger("UnrealMCP")
 
+# Number of assets requested per find_assets / list_blueprints page
+ASSET_PAGE_SIZE = 1000
+
 def register_project_tools(mcp: FastMCP):
     """Register project tools with the MCP server."""
     
     @mcp.tool()
-    def create_input_mapping(
+    async def create_input_mapping(
         ctx: Context,
         action_name: str,
         key: str,
@@ -47,13 +51,13 @@ def register_project_tools(mcp: FastMCP):
             }
             
             logger.info(f"Creating input mapping '{action_name}' with key '{key}'")
-            response = unreal.send_command("create_input_mapping", params)
+            response = await unreal.send_command("create_input_mapping", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Input mapping creation response: {response}")
+            log_payload("Input mapping creation response", response)
             return response
             
         except Exception as e:
@@ -61,4 +65,119 @@ def register_project_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
     
+    async def _query_assets(command: str, params: Dict[str, Any], max_results: int) -> Dict[str, Any]:
+        """Run an asset query page by page until max_results assets (0 = all) are collected."""
+        from unreal_mcp_server import get_unreal_connection
+        
+        unreal = get_unreal_connection()
+        if not unreal:
+            logger.error("Failed to connect to Unreal Engine")
+            return {"success": False, "message": "Failed to connect to Unreal Engine"}
+        
+        assets = []
+        total = 0
+        cursor = None
+        while True:
+            page_size = ASSET_PAGE_SIZE
+            if max_results > 0:
+                page_size = min(page_size, max_results - len(assets))
+            page_params = dict(params, limit=page_size)
+            if cursor:
+                page_params["cursor"] = cursor
+            
+            response = await unreal.send_command(command, page_params)
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            if response.get("status") == "error":
+                return response
+            
+            result = response.get("result", response)
+            assets.extend(result.get("assets", []))
+            total = result.get("total", len(assets))
+            cursor = result.get("next_cursor")
+            if not cursor or (max_results > 0 and len(assets) >= max_results):
+                break
+        
+        logger.info(f"{command} returned {len(assets)} of {total} assets")
+        return {"success": True, "assets": assets, "total": total}
+    
+    @mcp.tool()
+    async def find_assets(
+        ctx: Context,
+        class_name: str = "",
+        path: str = "",
+        name: str = "",
+        tags: Dict[str, str] = None,
+        fields: List[str] = None,
+        max_results: int = 1000
+    ) -> Dict[str, Any]:
+        """
+        Search the project's assets using Asset Registry metadata, without loading them.
+        
+        Args:
+            class_name: Asset class, e.g. "StaticMesh", "Material" or "/Script/Engine.Texture2D"
+            path: Folder to search, including subfolders, e.g. "/Game/Characters"
+            name: Only return assets whose name contains this text
+            tags: Asset Registry tag values to match; "*" only requires the tag to exist
+            fields: Fields to return (name, path, package, package_path, class, parent_class, tags)
+            max_results: Maximum number of assets to return (0 returns all of them)
+            
+        Returns:
+            Dict with the matching "assets" and the "total" number of matches
+        """
+        params = {}
+        if class_name:
+            params["class"] = class_name
+        if path:
+            params["path"] = path
+        if name:
+            params["name"] = name
+        if tags:
+            params["tags"] = tags
+        if fields:
+            params["fields"] = fields
+        
+        try:
+            return await _query_assets("find_assets", params, max_results)
+        except Exception as e:
+            error_msg = f"Error finding assets: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    async def list_blueprints(
+        ctx: Context,
+        path: str = "",
+        parent_class: str = "",
+        name: str = "",
+        max_results: int = 1000
+    ) -> Dict[str, Any]:
+        """
+        List the project's Blueprints with their parent classes, without loading them.
+        
+        Args:
+            path: Folder to search, including subfolders, e.g. "/Game/Blueprints"
+            parent_class: Only return Blueprints directly derived from this class, e.g. "Pawn" or "BP_Enemy"
+            name: Only return Blueprints whose name contains this text
+            max_results: Maximum number of Blueprints to return (0 returns all of them)
+            
+        Returns:
+            Dict with the matching "assets" and the "total" number of matches
+        """
+        params = {}
+        if path:
+            params["path"] = path
+        if parent_class:
+            params["parent_class"] = parent_class
+        if name:
+            params["name"] = name
+        
+        try:
+            return await _query_assets("list_blueprints", params, max_results)
+        except Exception as e:
+            error_msg = f"Error listing blueprints: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
     logger.info("Project tools registered successfully") 
\ No newline at end of file
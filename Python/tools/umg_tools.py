@@ -7,6 +7,7 @@ This module provides tools for creating and manipulating UMG Widget Blueprints i
 import logging
 from typing import Dict, List, Any
 from mcp.server.fastmcp import FastMCP, Context
+from unreal_logging import log_payload
 
 # Get logger
 logger = logging.getLogger("UnrealMCP")
@@ -15,7 +16,7 @@ def register_umg_tools(mcp: FastMCP):
     """Register UMG tools with the MCP server."""
 
     @mcp.tool()
-    def create_umg_widget_blueprint(
+    async def create_umg_widget_blueprint(
         ctx: Context,
         widget_name: str,
         parent_class: str = "UserWidget",
@@ -47,13 +48,13 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Creating UMG Widget Blueprint with params: {params}")
-            response = unreal.send_command("create_umg_widget_blueprint", params)
+            response = await unreal.send_command("create_umg_widget_blueprint", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Create UMG Widget Blueprint response: {response}")
+            log_payload("Create UMG Widget Blueprint response", response)
             return response
             
         except Exception as e:
@@ -62,7 +63,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def add_text_block_to_widget(
+    async def add_text_block_to_widget(
         ctx: Context,
         widget_name: str,
         text_block_name: str,
@@ -106,13 +107,13 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Adding Text Block to widget with params: {params}")
-            response = unreal.send_command("add_text_block_to_widget", params)
+            response = await unreal.send_command("add_text_block_to_widget", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Add Text Block response: {response}")
+            log_payload("Add Text Block response", response)
             return response
             
         except Exception as e:
@@ -121,7 +122,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def add_button_to_widget(
+    async def add_button_to_widget(
         ctx: Context,
         widget_name: str,
         button_name: str,
@@ -168,13 +169,13 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Adding Button to widget with params: {params}")
-            response = unreal.send_command("add_button_to_widget", params)
+            response = await unreal.send_command("add_button_to_widget", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Add Button response: {response}")
+            log_payload("Add Button response", response)
             return response
             
         except Exception as e:
@@ -183,7 +184,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def bind_widget_event(
+    async def bind_widget_event(
         ctx: Context,
         widget_name: str,
         widget_component_name: str,
@@ -222,13 +223,13 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Binding widget event with params: {params}")
-            response = unreal.send_command("bind_widget_event", params)
+            response = await unreal.send_command("bind_widget_event", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Bind widget event response: {response}")
+            log_payload("Bind widget event response", response)
             return response
             
         except Exception as e:
@@ -237,7 +238,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def add_widget_to_viewport(
+    async def add_widget_to_viewport(
         ctx: Context,
         widget_name: str,
         z_order: int = 0
@@ -266,13 +267,13 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Adding widget to viewport with params: {params}")
-            response = unreal.send_command("add_widget_to_viewport", params)
+            response = await unreal.send_command("add_widget_to_viewport", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Add widget to viewport response: {response}")
+            log_payload("Add widget to viewport response", response)
             return response
             
         except Exception as e:
@@ -281,7 +282,7 @@ def register_umg_tools(mcp: FastMCP):
             return {"success": False, "message": error_msg}
 
     @mcp.tool()
-    def set_text_block_binding(
+    async def set_text_block_binding(
         ctx: Context,
         widget_name: str,
         text_block_name: str,
@@ -316,13 +317,13 @@ def register_umg_tools(mcp: FastMCP):
             }
             
             logger.info(f"Setting text block binding with params: {params}")
-            response = unreal.send_command("set_text_block_binding", params)
+            response = await unreal.send_command("set_text_block_binding", params)
             
             if not response:
                 logger.error("No response from Unreal Engine")
                 return {"success": False, "message": "No response from Unreal Engine"}
             
-            logger.info(f"Set text block binding response: {response}")
+            log_payload("Set text block binding response", response)
             return response
             
         except Exception as e:
@@ -0,0 +1,277 @@
+"""
+Pipelining asyncio client for the UnrealMCP editor plugin.
+
+Every request carries an "id" that the plugin echoes on its response, so any
+number of commands can be in flight on one connection. Responses are matched
+to their requests by id, in whatever order they complete.
+
+Usage:
+    connection = AsyncUnrealConnection()
+    await connection.connect()
+    actors, ping = await asyncio.gather(
+        connection.send_command("get_actors_in_level"),
+        connection.send_command("ping"),
+    )
+    await connection.disconnect()
+
+UnrealConnectionPool spreads commands over a few such connections and keeps
+them healthy; the MCP server uses one pool for all of its tools.
+"""
+
+import asyncio
+import itertools
+import json
+import logging
+import random
+from typing import Any, Dict, List, Optional
+
+from unreal_logging import log_payload
+from unreal_protocol import (
+    FRAME_HEADER, check_encoding,
+    decode_frame_header, decode_payload, encode_frame, normalize_response,
+)
+
+logger = logging.getLogger("UnrealMCP")
+
+DEFAULT_HOST = "127.0.0.1"
+DEFAULT_PORT = 55557
+
+# Seconds allowed for opening a connection
+CONNECT_TIMEOUT = 5.0
+
+# Pool defaults: members, per-command timeout, and how often idle members are pinged
+DEFAULT_POOL_SIZE = 2
+DEFAULT_TIMEOUT = 30.0
+HEALTH_CHECK_INTERVAL = 15.0
+HEALTH_CHECK_TIMEOUT = 5.0
+
+# Delay before reconnecting a member after a failed attempt; doubles per failure
+RECONNECT_BACKOFF_MIN = 0.5
+RECONNECT_BACKOFF_MAX = 30.0
+
+class AsyncUnrealConnection:
+    """Framed connection that multiplexes concurrent requests by id.
+
+    With encoding="cbor" responses are requested as CBOR; see unreal_protocol.py.
+    """
+
+    def __init__(self, host: str = DEFAULT_HOST, port: int = DEFAULT_PORT, encoding: str = "json"):
+        self.host = host
+        self.port = port
+        self.encoding = check_encoding(encoding)
+        self._reader: Optional[asyncio.StreamReader] = None
+        self._writer: Optional[asyncio.StreamWriter] = None
+        self._read_task: Optional[asyncio.Task] = None
+        self._pending: Dict[int, asyncio.Future] = {}
+        self._ids = itertools.count(1)
+
+    @property
+    def connected(self) -> bool:
+        return self._writer is not None and not self._writer.is_closing()
+
+    @property
+    def in_flight(self) -> int:
+        """Number of requests waiting for their response."""
+        return len(self._pending)
+
+    async def connect(self) -> bool:
+        """Open the connection and start dispatching responses."""
+        await self.disconnect()
+        try:
+            logger.info(f"Connecting to Unreal at {self.host}:{self.port}...")
+            self._reader, self._writer = await asyncio.wait_for(
+                asyncio.open_connection(self.host, self.port), CONNECT_TIMEOUT)
+        except (OSError, asyncio.TimeoutError) as e:
+            logger.error(f"Failed to connect to Unreal: {e}")
+            return False
+        self._read_task = asyncio.create_task(self._read_responses())
+        logger.info("Connected to Unreal Engine")
+        return True
+
+    async def disconnect(self) -> None:
+        """Close the connection; requests still in flight fail with ConnectionError."""
+        if self._read_task:
+            self._read_task.cancel()
+            try:
+                await self._read_task
+            except (asyncio.CancelledError, Exception):
+                pass
+            self._read_task = None
+        if self._writer:
+            self._writer.close()
+            try:
+                await self._writer.wait_closed()
+            except Exception:
+                pass
+            self._writer = None
+            self._reader = None
+        self._fail_pending(ConnectionError("Connection to Unreal closed"))
+
+    async def send_command(self, command: str, params: Dict[str, Any] = None,
+                           timeout: Optional[float] = None) -> Dict[str, Any]:
+        """Send a command and wait for its response, leaving the connection free for others."""
+        if not self.connected and not await self.connect():
+            return {"status": "error", "error": "Failed to connect to Unreal Engine"}
+
+        request_id = next(self._ids)
+        future = asyncio.get_running_loop().create_future()
+        self._pending[request_id] = future
+
+        request = {"type": command, "params": params or {}, "id": request_id}
+        if self.encoding != "json":
+            request["encoding"] = self.encoding
+        command_json = json.dumps(request)
+        try:
+            log_payload("Sending command", command_json)
+            self._writer.write(encode_frame(command_json.encode('utf-8')))
+            await self._writer.drain()
+            response = await asyncio.wait_for(future, timeout)
+        except asyncio.TimeoutError:
+            return {"status": "error", "error": f"Timed out waiting for '{command}'", "id": request_id}
+        except Exception as e:
+            logger.error(f"Error sending command: {e}")
+            return {"status": "error", "error": str(e), "id": request_id}
+        finally:
+            self._pending.pop(request_id, None)
+
+        return normalize_response(response)
+
+    async def _read_responses(self) -> None:
+        """Resolve pending futures as responses arrive."""
+        try:
+            while True:
+                encoding, length = decode_frame_header(await self._reader.readexactly(FRAME_HEADER.size))
+                payload = await self._reader.readexactly(length)
+
+                response = decode_payload(encoding, payload)
+                future = self._pending.get(response.get("id"))
+                if future is None:
+                    # Errors the server raises before reading the id (e.g. bad framing) carry none
+                    logger.warning(f"Dropping response without a pending request: {response}")
+                    continue
+                if not future.done():
+                    future.set_result(response)
+        except asyncio.CancelledError:
+            raise
+        except (asyncio.IncompleteReadError, ConnectionError) as e:
+            logger.warning(f"Connection to Unreal lost: {e}")
+            self._fail_pending(ConnectionError("Connection to Unreal lost"))
+        except Exception as e:
+            logger.error(f"Error reading responses: {e}")
+            self._fail_pending(e)
+        finally:
+            if self._writer:
+                self._writer.close()
+
+    def _fail_pending(self, error: Exception) -> None:
+        for future in self._pending.values():
+            if not future.done():
+                future.set_exception(error)
+
+
+class _PoolMember:
+    """One connection of a pool and its reconnect backoff state."""
+
+    def __init__(self, connection: AsyncUnrealConnection):
+        self.connection = connection
+        self.failures = 0
+        self.next_attempt = 0.0
+        self._lock = asyncio.Lock()
+
+    async def ensure_connected(self) -> bool:
+        """Connect unless connected already or still backing off from a failed attempt."""
+        async with self._lock:
+            if self.connection.connected:
+                return True
+            loop = asyncio.get_running_loop()
+            if loop.time() < self.next_attempt:
+                return False
+            if await self.connection.connect():
+                self.failures = 0
+                return True
+            # Jittered so members of the pool don't retry in lockstep
+            delay = min(RECONNECT_BACKOFF_MAX, RECONNECT_BACKOFF_MIN * 2 ** self.failures)
+            self.next_attempt = loop.time() + delay * random.uniform(0.5, 1.0)
+            self.failures += 1
+            return False
+
+class UnrealConnectionPool:
+    """A few pipelined connections shared by concurrent callers.
+
+    Each command goes to the connected member with the fewest requests in
+    flight, so concurrent tool calls neither wait for each other's socket nor
+    pile up on one connection. Members that fail to connect are retried with
+    exponential backoff, and idle members are pinged in the background so a
+    dead connection is noticed and replaced before a command needs it.
+    """
+
+    def __init__(self, host: str = DEFAULT_HOST, port: int = DEFAULT_PORT, encoding: str = "json",
+                 size: int = DEFAULT_POOL_SIZE, timeout: float = DEFAULT_TIMEOUT,
+                 health_check_interval: float = HEALTH_CHECK_INTERVAL):
+        self.timeout = timeout
+        self.health_check_interval = health_check_interval
+        self._members: List[_PoolMember] = [
+            _PoolMember(AsyncUnrealConnection(host, port, encoding)) for _ in range(max(1, size))
+        ]
+        self._health_task: Optional[asyncio.Task] = None
+
+    @property
+    def connected(self) -> bool:
+        return any(member.connection.connected for member in self._members)
+
+    async def start(self) -> bool:
+        """Connect every member and start health checks; returns whether any member connected."""
+        results = await asyncio.gather(*(member.ensure_connected() for member in self._members))
+        if self._health_task is None:
+            self._health_task = asyncio.create_task(self._check_health())
+        return any(results)
+
+    async def close(self) -> None:
+        """Stop health checks and close every connection."""
+        if self._health_task:
+            self._health_task.cancel()
+            try:
+                await self._health_task
+            except asyncio.CancelledError:
+                pass
+            self._health_task = None
+        await asyncio.gather(*(member.connection.disconnect() for member in self._members))
+
+    async def send_command(self, command: str, params: Dict[str, Any] = None,
+                           timeout: Optional[float] = None) -> Dict[str, Any]:
+        """Send a command on the least busy connection and wait at most timeout seconds for its response."""
+        member = await self._acquire()
+        if member is None:
+            return {"status": "error", "error": "Failed to connect to Unreal Engine"}
+        return await member.connection.send_command(
+            command, params, self.timeout if timeout is None else timeout)
+
+    async def _acquire(self) -> Optional[_PoolMember]:
+        connected = [member for member in self._members if member.connection.connected]
+        if connected:
+            return min(connected, key=lambda member: member.connection.in_flight)
+        # Nothing is connected: try every member whose backoff has expired
+        for member in self._members:
+            if await member.ensure_connected():
+                return member
+        return None
+
+    async def _check_health(self) -> None:
+        while True:
+            await asyncio.sleep(self.health_check_interval)
+            await asyncio.gather(*(self._check_member(member) for member in self._members))
+
+    async def _check_member(self, member: _PoolMember) -> None:
+        if not member.connection.connected:
+            if await member.ensure_connected():
+                logger.info("Reconnected to Unreal Engine")
+            return
+        if member.connection.in_flight:
+            # Responses are still arriving on busy connections
+            return
+        # ping is answered off the game thread, so a long-running command doesn't make it time out
+        response = await member.connection.send_command("ping", timeout=HEALTH_CHECK_TIMEOUT)
+        if response.get("status") == "error":
+            logger.warning(f"Health check failed ({response.get('error')}), reconnecting")
+            await member.connection.disconnect()
+            await member.ensure_connected()
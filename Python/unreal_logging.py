@@ -0,0 +1,74 @@
+"""
+Logging setup shared by the UnrealMCP server, its tools and clients.
+
+Request and response bodies are the bulk of what gets logged, so they are
+only logged when asked for, and then cut short and sampled. Controlled
+through the environment:
+
+    UNREAL_MCP_LOG_LEVEL        level of unreal_mcp.log (default INFO)
+    UNREAL_MCP_LOG_PAYLOADS     1 to log request and response bodies (default 0)
+    UNREAL_MCP_LOG_PAYLOAD_MAX  characters of each body that are logged, 0 for all (default 1024)
+    UNREAL_MCP_LOG_SAMPLE       log one in this many bodies (default 1)
+
+The plugin has the same controls in its project settings (Plugins > Unreal MCP
+> Logging) and the set_log_options command.
+"""
+
+import collections
+import itertools
+import json
+import logging
+import os
+from typing import Any
+
+logger = logging.getLogger("UnrealMCP")
+
+def _env_int(name: str, default: int) -> int:
+    try:
+        return int(os.environ.get(name, default))
+    except ValueError:
+        return default
+
+LOG_LEVEL = os.environ.get("UNREAL_MCP_LOG_LEVEL", "INFO").upper()
+LOG_PAYLOADS = os.environ.get("UNREAL_MCP_LOG_PAYLOADS", "0").lower() in ("1", "true", "yes", "on")
+LOG_PAYLOAD_MAX = max(0, _env_int("UNREAL_MCP_LOG_PAYLOAD_MAX", 1024))
+LOG_SAMPLE = max(1, _env_int("UNREAL_MCP_LOG_SAMPLE", 1))
+
+# One sampling counter per label, so requests and their responses are sampled alike
+_payload_counters = collections.defaultdict(itertools.count)
+
+def configure_logging(filename: str = "unreal_mcp.log") -> None:
+    """Send the UnrealMCP logs to a file; stdout is reserved for the MCP stdio transport."""
+    logging.basicConfig(
+        level=getattr(logging, LOG_LEVEL, logging.INFO),
+        format='%(asctime)s - %(name)s - %(levelname)s - [%(filename)s:%(lineno)d] - %(message)s',
+        handlers=[logging.FileHandler(filename)]
+    )
+
+def log_payload(label: str, payload: Any) -> None:
+    """Log a request or response body if payload logging is on and this one is sampled.
+
+    payload may be JSON text, raw UTF-8 bytes or a decoded object. Prefer the
+    raw bytes of a large response: only the logged prefix of them is decoded,
+    while an object has to be formatted in full before it can be cut short.
+    """
+    if not LOG_PAYLOADS or not logger.isEnabledFor(logging.INFO):
+        return
+    if LOG_SAMPLE > 1 and next(_payload_counters[label]) % LOG_SAMPLE:
+        return
+    # Truncation is decided on the original length: decoded text can be shorter than its bytes
+    if isinstance(payload, (bytes, bytearray, memoryview)):
+        size = len(payload)
+        truncated = bool(LOG_PAYLOAD_MAX) and size > LOG_PAYLOAD_MAX
+        logged = payload[:LOG_PAYLOAD_MAX] if truncated else payload
+        text = bytes(logged).decode("utf-8", errors="replace")
+    else:
+        text = payload if isinstance(payload, str) else json.dumps(payload, default=str)
+        size = len(text)
+        truncated = bool(LOG_PAYLOAD_MAX) and size > LOG_PAYLOAD_MAX
+        if truncated:
+            text = text[:LOG_PAYLOAD_MAX]
+    if truncated:
+        logger.info(f"{label} ({size} bytes): {text}...")
+    else:
+        logger.info(f"{label}: {text}")
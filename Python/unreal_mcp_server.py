@@ -9,31 +9,43 @@ import socket
 import sys
 import json
 from contextlib import asynccontextmanager
-from typing import AsyncIterator, Dict, Any, Optional
+from typing import AsyncIterator, Dict, Any, Optional, Tuple
 from mcp.server.fastmcp import FastMCP
+from unreal_async_client import UnrealConnectionPool
+from unreal_logging import configure_logging, log_payload
+from unreal_protocol import PROTOCOL_FRAMED, PROTOCOL_NEWLINE, ENCODING_JSON, check_encoding, encode_frame, recv_frame, decode_payload, normalize_response
 
-# Configure logging with more detailed format
-logging.basicConfig(
-    level=logging.DEBUG,  # Change to DEBUG level for more details
-    format='%(asctime)s - %(name)s - %(levelname)s - [%(filename)s:%(lineno)d] - %(message)s',
-    handlers=[
-        logging.FileHandler('unreal_mcp.log'),
-        # logging.StreamHandler(sys.stdout) # Remove this handler to unexpected non-whitespace characters in JSON
-    ]
-)
+# Log to unreal_mcp.log; see unreal_logging.py for the UNREAL_MCP_LOG_* settings
+configure_logging()
 logger = logging.getLogger("UnrealMCP")
 
 # Configuration
 UNREAL_HOST = "127.0.0.1"
 UNREAL_PORT = 55557
+UNREAL_PROTOCOL = PROTOCOL_FRAMED  # or PROTOCOL_NEWLINE for newline-delimited JSON
+UNREAL_ENCODING = "json"  # or "cbor" for compact responses (framed protocol only)
+UNREAL_POOL_SIZE = 2  # connections shared by concurrent tool calls
+UNREAL_TIMEOUT = 30.0  # seconds a tool waits for a command's response
 
 class UnrealConnection:
-    """Connection to an Unreal Engine instance."""
+    """Blocking connection to an Unreal Engine instance, for scripts.
+    
+    The MCP tools share an UnrealConnectionPool instead (see get_unreal_connection).
+    
+    The socket is kept open between commands, so any number of commands can
+    share one connection. Messages are length-prefixed frames by default (see
+    unreal_protocol.py), or newline-delimited JSON. Framed connections can
+    ask for CBOR responses, which are smaller and faster to decode for bulk
+    results; newline-delimited responses are always JSON.
+    """
     
-    def __init__(self):
+    def __init__(self, protocol: str = UNREAL_PROTOCOL, encoding: str = UNREAL_ENCODING):
         """Initialize the connection."""
+        self.protocol = protocol
+        self.encoding = check_encoding(encoding)
         self.socket = None
         self.connected = False
+        self._recv_buffer = bytearray()
     
     def connect(self) -> bool:
         """Connect to the Unreal Engine instance."""
@@ -59,6 +71,7 @@ class UnrealConnection:
             self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 65536)
             
             self.socket.connect((UNREAL_HOST, UNREAL_PORT))
+            self._recv_buffer.clear()
             self.connected = True
             logger.info("Connected to Unreal Engine")
             return True
@@ -77,185 +90,121 @@ class UnrealConnection:
                 pass
         self.socket = None
         self.connected = False
+        self._recv_buffer.clear()
 
-    def receive_full_response(self, sock, buffer_size=4096) -> bytes:
-        """Receive a complete response from Unreal, handling chunked data."""
-        chunks = []
+    def receive_full_response(self, sock, buffer_size=65536) -> Tuple[int, bytes]:
+        """Receive one complete response from Unreal and return (encoding, payload)."""
         sock.settimeout(5)  # 5 second timeout
-        try:
-            while True:
-                chunk = sock.recv(buffer_size)
-                if not chunk:
-                    if not chunks:
-                        raise Exception("Connection closed before receiving data")
-                    break
-                chunks.append(chunk)
-                
-                # Process the data received so far
-                data = b''.join(chunks)
-                decoded_data = data.decode('utf-8')
-                
-                # Try to parse as JSON to check if complete
-                try:
-                    json.loads(decoded_data)
-                    logger.info(f"Received complete response ({len(data)} bytes)")
-                    return data
-                except json.JSONDecodeError:
-                    # Not complete JSON yet, continue reading
-                    logger.debug(f"Received partial response, waiting for more data...")
-                    continue
-                except Exception as e:
-                    logger.warning(f"Error processing response chunk: {str(e)}")
-                    continue
-        except socket.timeout:
-            logger.warning("Socket timeout during receive")
-            if chunks:
-                # If we have some data already, try to use it
-                data = b''.join(chunks)
-                try:
-                    json.loads(data.decode('utf-8'))
-                    logger.info(f"Using partial response after timeout ({len(data)} bytes)")
-                    return data
-                except:
-                    pass
-            raise Exception("Timeout receiving Unreal response")
-        except Exception as e:
-            logger.error(f"Error during receive: {str(e)}")
-            raise
+        
+        if self.protocol == PROTOCOL_FRAMED:
+            encoding, payload = recv_frame(sock)
+            logger.debug(f"Received complete response ({len(payload)} bytes)")
+            return encoding, payload
+        
+        # Newline-delimited: bytes following the terminator are kept for the next
+        # call, and only newly received bytes are scanned for the terminator.
+        scan_from = 0
+        while True:
+            newline = self._recv_buffer.find(b"\n", scan_from)
+            if newline >= 0:
+                line = bytes(self._recv_buffer[:newline])
+                del self._recv_buffer[:newline + 1]
+                logger.debug(f"Received complete response ({len(line)} bytes)")
+                return ENCODING_JSON, line
+            
+            scan_from = len(self._recv_buffer)
+            chunk = sock.recv(buffer_size)
+            if not chunk:
+                raise ConnectionError("Connection closed before receiving a complete response")
+            self._recv_buffer.extend(chunk)
     
     def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
         """Send a command to Unreal Engine and get the response."""
-        # Always reconnect for each command, since Unreal closes the connection after each command
-        # This is different from Unity which keeps connections alive
-        if self.socket:
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
-            self.connected = False
-        
-        if not self.connect():
-            logger.error("Failed to connect to Unreal Engine for command")
-            return None
+        # Match Unity's command format exactly
+        command_obj = {
+            "type": command,  # Use "type" instead of "command"
+            "params": params or {}  # Use Unity's params or {} pattern
+        }
+        if self.protocol == PROTOCOL_FRAMED and self.encoding != "json":
+            command_obj["encoding"] = self.encoding
+        command_json = json.dumps(command_obj)
         
         try:
-            # Match Unity's command format exactly
-            command_obj = {
-                "type": command,  # Use "type" instead of "command"
-                "params": params or {}  # Use Unity's params or {} pattern
-            }
-            
-            # Send without newline, exactly like Unity
-            command_json = json.dumps(command_obj)
-            logger.info(f"Sending command: {command_json}")
-            self.socket.sendall(command_json.encode('utf-8'))
+            # A kept-alive socket may have been closed by Unreal (e.g. editor restart)
+            # while idle, so retry once on a fresh connection if the send fails.
+            # Once the request is written the editor may already have executed it,
+            # and commands such as spawn_actor must not run twice, so a connection
+            # lost while waiting for the response is reported instead of retried.
+            for attempt in range(2):
+                if not self.connected and not self.connect():
+                    logger.error("Failed to connect to Unreal Engine for command")
+                    return None
+                
+                try:
+                    log_payload("Sending command", command_json)
+                    if self.protocol == PROTOCOL_FRAMED:
+                        self.socket.sendall(encode_frame(command_json.encode('utf-8')))
+                    else:
+                        self.socket.sendall((command_json + "\n").encode('utf-8'))
+                    break
+                except (ConnectionError, BrokenPipeError) as e:
+                    self.disconnect()
+                    if attempt == 1:
+                        raise
+                    logger.warning(f"Connection to Unreal lost ({e}), reconnecting...")
             
-            # Read response using improved handler
-            response_data = self.receive_full_response(self.socket)
-            response = json.loads(response_data.decode('utf-8'))
+            encoding, response_data = self.receive_full_response(self.socket)
             
-            # Log complete response for debugging
-            logger.info(f"Complete response from Unreal: {response}")
+            if encoding == ENCODING_JSON:
+                log_payload("Complete response from Unreal", response_data)
+            response = decode_payload(encoding, response_data)
             
             # Check for both error formats: {"status": "error", ...} and {"success": false, ...}
+            response = normalize_response(response)
             if response.get("status") == "error":
-                error_message = response.get("error") or response.get("message", "Unknown Unreal error")
-                logger.error(f"Unreal error (status=error): {error_message}")
-                # We want to preserve the original error structure but ensure error is accessible
-                if "error" not in response:
-                    response["error"] = error_message
-            elif response.get("success") is False:
-                # This format uses {"success": false, "error": "message"} or {"success": false, "message": "message"}
-                error_message = response.get("error") or response.get("message", "Unknown Unreal error")
-                logger.error(f"Unreal error (success=false): {error_message}")
-                # Convert to the standard format expected by higher layers
-                response = {
-                    "status": "error",
-                    "error": error_message
-                }
-            
-            # Always close the connection after command is complete
-            # since Unreal will close it on its side anyway
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
-            self.connected = False
+                logger.error(f"Unreal error: {response['error']}")
             
             return response
             
         except Exception as e:
             logger.error(f"Error sending command: {e}")
-            # Always reset connection state on any error
-            self.connected = False
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
+            # The stream position is unknown after a failure, so start over on the next command
+            self.disconnect()
             return {
                 "status": "error",
                 "error": str(e)
             }
 
-# Global connection state
-_unreal_connection: UnrealConnection = None
+# Connections shared by all tools
+_unreal_pool: Optional[UnrealConnectionPool] = None
 
-def get_unreal_connection() -> Optional[UnrealConnection]:
-    """Get the connection to Unreal Engine."""
-    global _unreal_connection
-    try:
-        if _unreal_connection is None:
-            _unreal_connection = UnrealConnection()
-            if not _unreal_connection.connect():
-                logger.warning("Could not connect to Unreal Engine")
-                _unreal_connection = None
-        else:
-            # Verify connection is still valid with a ping-like test
-            try:
-                # Simple test by sending an empty buffer to check if socket is still connected
-                _unreal_connection.socket.sendall(b'\x00')
-                logger.debug("Connection verified with ping test")
-            except Exception as e:
-                logger.warning(f"Existing connection failed: {e}")
-                _unreal_connection.disconnect()
-                _unreal_connection = None
-                # Try to reconnect
-                _unreal_connection = UnrealConnection()
-                if not _unreal_connection.connect():
-                    logger.warning("Could not reconnect to Unreal Engine")
-                    _unreal_connection = None
-                else:
-                    logger.info("Successfully reconnected to Unreal Engine")
-        
-        return _unreal_connection
-    except Exception as e:
-        logger.error(f"Error getting Unreal connection: {e}")
-        return None
+def get_unreal_connection() -> UnrealConnectionPool:
+    """Get the connection pool to Unreal Engine; its send_command is a coroutine.
+    
+    The pool connects and reconnects on its own, so a returned pool may still
+    answer a command with an error if Unreal is not running.
+    """
+    global _unreal_pool
+    if _unreal_pool is None:
+        _unreal_pool = UnrealConnectionPool(UNREAL_HOST, UNREAL_PORT, UNREAL_ENCODING, UNREAL_POOL_SIZE, UNREAL_TIMEOUT)
+    return _unreal_pool
 
 @asynccontextmanager
 async def server_lifespan(server: FastMCP) -> AsyncIterator[Dict[str, Any]]:
     """Handle server startup and shutdown."""
-    global _unreal_connection
+    global _unreal_pool
     logger.info("UnrealMCP server starting up")
-    try:
-        _unreal_connection = get_unreal_connection()
-        if _unreal_connection:
-            logger.info("Connected to Unreal Engine on startup")
-        else:
-            logger.warning("Could not connect to Unreal Engine on startup")
-    except Exception as e:
-        logger.error(f"Error connecting to Unreal Engine on startup: {e}")
-        _unreal_connection = None
+    pool = get_unreal_connection()
+    if await pool.start():
+        logger.info("Connected to Unreal Engine on startup")
+    else:
+        logger.warning("Could not connect to Unreal Engine on startup; will keep retrying")
     
     try:
         yield {}
     finally:
-        if _unreal_connection:
-            _unreal_connection.disconnect()
-            _unreal_connection = None
+        await pool.close()
+        _unreal_pool = None
         logger.info("Unreal MCP server shut down")
 
 # Initialize server
@@ -305,7 +254,7 @@ def info():
     - `take_screenshot(filename, show_ui, resolution)` - Capture screenshots
 
     ### Actor Management
-    - `get_actors_in_level()` - List all actors in current level
+    - `get_actors_in_level(class_name, tags, bounds, fields, cursor, offset, limit)` - List one page of the actors in the current level; pass `next_cursor` back as `cursor` for the next
     - `find_actors_by_name(pattern)` - Find actors by name pattern
     - `spawn_actor(name, type, location=[0,0,0], rotation=[0,0,0], scale=[1,1,1])` - Create actors
     - `delete_actor(name)` - Remove actors
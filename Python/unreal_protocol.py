@@ -0,0 +1,229 @@
+"""
+Wire protocol helpers for talking to the UnrealMCP editor plugin.
+
+Mirrors MCPProtocol.h in the plugin. A framed message is an 8 byte header
+followed by the payload:
+
+    [0..1] magic b"UM"
+    [2]    protocol version
+    [3]    payload encoding (ENCODING_JSON or ENCODING_CBOR)
+    [4..7] payload length, big-endian uint32
+
+Requests are always JSON. Adding "encoding": "cbor" to a framed request asks
+for a CBOR response; the header byte says what the server actually sent, so
+servers that predate CBOR simply keep answering in JSON.
+"""
+
+import json
+import logging
+import socket
+import struct
+from typing import Any, Dict, Tuple
+
+try:
+    import cbor2
+except ImportError:  # Optional: install with `uv pip install -e ".[cbor]"`
+    cbor2 = None
+
+logger = logging.getLogger("UnrealMCP")
+
+FRAME_MAGIC = b"UM"
+FRAME_VERSION = 1
+FRAME_HEADER = struct.Struct(">2sBBI")
+MAX_PAYLOAD_SIZE = 64 * 1024 * 1024
+
+ENCODING_JSON = 0
+ENCODING_CBOR = 1
+
+# Values of the request's "encoding" field
+ENCODING_NAMES = {"json": ENCODING_JSON, "cbor": ENCODING_CBOR}
+
+# Framing modes understood by the server
+PROTOCOL_FRAMED = "framed"
+PROTOCOL_NEWLINE = "newline"
+
+class ProtocolError(Exception):
+    """Raised when the peer sends data that does not follow the protocol."""
+
+def encode_frame(payload: bytes, encoding: int = ENCODING_JSON) -> bytes:
+    """Prefix a payload with a frame header."""
+    if len(payload) > MAX_PAYLOAD_SIZE:
+        raise ProtocolError(f"Payload of {len(payload)} bytes exceeds the {MAX_PAYLOAD_SIZE} byte limit")
+    return FRAME_HEADER.pack(FRAME_MAGIC, FRAME_VERSION, encoding, len(payload)) + payload
+
+def decode_frame_header(header: bytes) -> Tuple[int, int]:
+    """Validate a frame header and return (encoding, payload length)."""
+    magic, version, encoding, length = FRAME_HEADER.unpack(header)
+    if magic != FRAME_MAGIC:
+        raise ProtocolError(f"Invalid frame magic {magic!r}")
+    if version != FRAME_VERSION:
+        raise ProtocolError(f"Unsupported protocol version {version}")
+    if length > MAX_PAYLOAD_SIZE:
+        raise ProtocolError(f"Frame of {length} bytes exceeds the {MAX_PAYLOAD_SIZE} byte limit")
+    return encoding, length
+
+def recv_exactly(sock: socket.socket, size: int) -> bytearray:
+    """Read exactly size bytes into a single preallocated buffer."""
+    buffer = bytearray(size)
+    view = memoryview(buffer)
+    received = 0
+    while received < size:
+        count = sock.recv_into(view[received:], size - received)
+        if count == 0:
+            raise ConnectionError("Connection closed before receiving a complete response")
+        received += count
+    return buffer
+
+def recv_frame(sock: socket.socket) -> Tuple[int, bytearray]:
+    """Read one frame and return (encoding, payload)."""
+    encoding, length = decode_frame_header(recv_exactly(sock, FRAME_HEADER.size))
+    return encoding, recv_exactly(sock, length)
+
+def check_encoding(encoding: str) -> str:
+    """Validate a response encoding name for a client connection and return it."""
+    if encoding not in ENCODING_NAMES:
+        raise ValueError(f"Unknown response encoding '{encoding}', expected one of {sorted(ENCODING_NAMES)}")
+    if encoding == "cbor" and cbor2 is None:
+        logger.warning("cbor2 is not installed; CBOR responses will be decoded in pure Python, "
+                       "which is slower than JSON")
+    return encoding
+
+def decode_payload(encoding: int, payload: bytes) -> Any:
+    """Decode a response payload according to the encoding byte of its frame header."""
+    if encoding == ENCODING_JSON:
+        return json.loads(payload)
+    if encoding == ENCODING_CBOR:
+        return cbor2.loads(payload) if cbor2 else _CborDecoder(payload).decode()
+    raise ProtocolError(f"Unexpected payload encoding {encoding}")
+
+_UINT16 = struct.Struct(">H")
+_UINT32 = struct.Struct(">I")
+_UINT64 = struct.Struct(">Q")
+_FLOAT16 = struct.Struct(">e")
+_FLOAT32 = struct.Struct(">f")
+_FLOAT64 = struct.Struct(">d")
+_SIMPLE_VALUES = {20: False, 21: True, 22: None, 23: None}
+
+class _CborDecoder:
+    """Minimal CBOR (RFC 8949) decoder used when cbor2 is not installed.
+
+    Covers what the plugin writes: integers, floats, strings, booleans, null,
+    arrays and maps. Tags are decoded as their untagged value. Being pure
+    Python it decodes slower than the json module; install cbor2 for speed.
+    """
+
+    def __init__(self, data: bytes):
+        self.data = bytes(data)
+        self.offset = 0
+
+    def decode(self) -> Any:
+        try:
+            value = self._read_item()
+        except (IndexError, struct.error, UnicodeDecodeError) as e:
+            raise ProtocolError(f"Malformed CBOR payload: {e}") from e
+        if self.offset != len(self.data):
+            raise ProtocolError("Trailing bytes after CBOR payload")
+        return value
+
+    def _read_argument(self, info: int) -> int:
+        data, offset = self.data, self.offset
+        if info < 24:
+            return info
+        if info == 24:
+            self.offset = offset + 1
+            return data[offset]
+        if info == 25:
+            self.offset = offset + 2
+            return _UINT16.unpack_from(data, offset)[0]
+        if info == 26:
+            self.offset = offset + 4
+            return _UINT32.unpack_from(data, offset)[0]
+        if info == 27:
+            self.offset = offset + 8
+            return _UINT64.unpack_from(data, offset)[0]
+        raise ProtocolError(f"Invalid CBOR length encoding {info}")
+
+    def _read_string(self, length: int) -> bytes:
+        start = self.offset
+        end = start + length
+        if end > len(self.data):
+            raise ProtocolError("Truncated CBOR payload")
+        self.offset = end
+        return self.data[start:end]
+
+    def _read_item(self) -> Any:
+        initial = self.data[self.offset]
+        self.offset += 1
+        major, info = initial >> 5, initial & 0x1F
+
+        if major == 7:
+            if info in _SIMPLE_VALUES:
+                return _SIMPLE_VALUES[info]
+            offset = self.offset
+            if info == 27:
+                self.offset = offset + 8
+                return _FLOAT64.unpack_from(self.data, offset)[0]
+            if info == 26:
+                self.offset = offset + 4
+                return _FLOAT32.unpack_from(self.data, offset)[0]
+            if info == 25:
+                self.offset = offset + 2
+                return _FLOAT16.unpack_from(self.data, offset)[0]
+            raise ProtocolError(f"Unsupported CBOR simple value {info}")
+
+        if info == 31:
+            return self._read_indefinite(major)
+
+        argument = info if info < 24 else self._read_argument(info)
+        if major == 3:
+            return self._read_string(argument).decode("utf-8")
+        if major == 5:
+            read_item = self._read_item
+            result = {}
+            for _ in range(argument):
+                key = read_item()
+                result[key] = read_item()
+            return result
+        if major == 0:
+            return argument
+        if major == 4:
+            read_item = self._read_item
+            return [read_item() for _ in range(argument)]
+        if major == 1:
+            return -1 - argument
+        if major == 2:
+            return self._read_string(argument)
+        # major == 6: tag, followed by the tagged item
+        return self._read_item()
+
+    def _read_indefinite(self, major: int) -> Any:
+        items = []
+        while self.data[self.offset] != 0xFF:
+            items.append(self._read_item())
+        self.offset += 1
+
+        if major == 2:
+            return b"".join(items)
+        if major == 3:
+            return "".join(items)
+        if major == 4:
+            return items
+        if major == 5:
+            return dict(zip(items[0::2], items[1::2]))
+        raise ProtocolError(f"Invalid indefinite-length CBOR item (major type {major})")
+
+def normalize_response(response: Dict[str, Any]) -> Dict[str, Any]:
+    """Bring both error formats, {"status": "error", ...} and {"success": false, ...}, to the first one."""
+    if response.get("status") == "error":
+        # Preserve the original error structure but ensure error is accessible
+        if "error" not in response:
+            response["error"] = response.get("message", "Unknown Unreal error")
+    elif response.get("success") is False:
+        error = {
+            "status": "error",
+            "error": response.get("error") or response.get("message", "Unknown Unreal error")
+        }
+        if "id" in response:
+            error["id"] = response["id"]
+        response = error
+    return response